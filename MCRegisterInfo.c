@@ -14,6 +14,8 @@
 /* Capstone Disassembly Engine */
 /* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
 
+#include <stddef.h>
+
 #include "MCRegisterInfo.h"
 
 /// DiffListIterator - Base iterator class that can traverse the
@@ -48,6 +50,16 @@ void MCRegisterInfo_InitMCRegisterInfo(MCRegisterInfo *RI,
 	RI->SubRegIndices = SubIndices;
 	RI->NumSubRegIndices = NumIndices;
 	RI->RegEncodingTable = RET;
+	RI->SubRegTable = NULL;
+	RI->SuperRegTable = NULL;
+}
+
+void MCRegisterInfo_setSubRegTables(MCRegisterInfo *RI,
+		const MCPhysReg *const *SubRegTable,
+		const MCPhysReg *const *SuperRegTable)
+{
+	RI->SubRegTable = SubRegTable;
+	RI->SuperRegTable = SuperRegTable;
 }
 
 static void DiffListIterator_init(DiffListIterator *d, MCPhysReg InitVal, const MCPhysReg *DiffList)
@@ -91,6 +103,14 @@ unsigned MCRegisterInfo_getMatchingSuperReg(const MCRegisterInfo *RI, unsigned R
 		return 0;
 	}
 
+	if (RI->SuperRegTable && SubIdx < RI->NumSubRegIndices && RI->SuperRegTable[SubIdx]) {
+		// the first super-register of this index, in any class.
+		// if that is not in @RC, look for one that is below
+		unsigned val = RI->SuperRegTable[SubIdx][Reg];
+		if (val == 0 || MCRegisterClass_contains(RC, val))
+			return val;
+	}
+
 	DiffListIterator_init(&iter, (MCPhysReg)Reg, RI->DiffLists + RI->Desc[Reg].SuperRegs);
 	DiffListIterator_next(&iter);
 
@@ -108,7 +128,12 @@ unsigned MCRegisterInfo_getMatchingSuperReg(const MCRegisterInfo *RI, unsigned R
 unsigned MCRegisterInfo_getSubReg(const MCRegisterInfo *RI, unsigned Reg, unsigned Idx)
 {
 	DiffListIterator iter;
-	const uint16_t *SRI = RI->SubRegIndices + RI->Desc[Reg].SubRegIndices;
+	const uint16_t *SRI;
+
+	if (RI->SubRegTable && Idx < RI->NumSubRegIndices && RI->SubRegTable[Idx])
+		return Reg < RI->NumRegs ? RI->SubRegTable[Idx][Reg] : 0;
+
+	SRI = RI->SubRegIndices + RI->Desc[Reg].SubRegIndices;
 
 	DiffListIterator_init(&iter, (MCPhysReg)Reg, RI->DiffLists + RI->Desc[Reg].SubRegs);
 	DiffListIterator_next(&iter);
@@ -122,22 +147,3 @@ unsigned MCRegisterInfo_getSubReg(const MCRegisterInfo *RI, unsigned Reg, unsign
 
 	return 0;
 }
-
-const MCRegisterClass* MCRegisterInfo_getRegClass(const MCRegisterInfo *RI, unsigned i)
-{
-	//assert(i < getNumRegClasses() && "Register Class ID out of range");
-	if (i >= RI->NumClasses)
-		return 0;
-	return &(RI->Classes[i]);
-}
-
-bool MCRegisterClass_contains(const MCRegisterClass *c, unsigned Reg)
-{
-	unsigned InByte = Reg % 8;
-	unsigned Byte = Reg / 8;
-
-	if (Byte >= c->RegSetSize)
-		return false;
-
-	return (c->RegSet[Byte] & (1 << InByte)) != 0;
-}
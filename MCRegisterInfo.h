@@ -21,6 +21,12 @@
 
 #include "capstone/platform.h"
 
+#ifndef __cplusplus
+#if defined (WIN32) || defined (WIN64) || defined (_WIN32) || defined (_WIN64)
+#define inline /* inline */
+#endif
+#endif
+
 /// An unsigned integer type large enough to represent all physical registers,
 /// but not necessarily virtual registers.
 typedef uint16_t MCPhysReg;
@@ -91,6 +97,10 @@ typedef struct MCRegisterInfo {
 	unsigned NumSubRegIndices;                  // Number of subreg indices.
 	const uint16_t *RegEncodingTable;           // Pointer to array of register
 	// encodings.
+	const MCPhysReg *const *SubRegTable;        // Sub-register of each register,
+	// by sub-register index. NULL, or NULL for an index, if not precomputed.
+	const MCPhysReg *const *SuperRegTable;      // First super-register having
+	// each register as sub-register, by sub-register index. Same as above.
 } MCRegisterInfo;
 
 void MCRegisterInfo_InitMCRegisterInfo(MCRegisterInfo *RI,
@@ -105,12 +115,37 @@ void MCRegisterInfo_InitMCRegisterInfo(MCRegisterInfo *RI,
 		unsigned NumIndices,
 		const uint16_t *RET);
 
+// set tables precomputed at generation time, which make lookups of
+// sub-registers & super-registers of their indices a single load.
+// these are static data, shared by all handles.
+void MCRegisterInfo_setSubRegTables(MCRegisterInfo *RI,
+		const MCPhysReg *const *SubRegTable,
+		const MCPhysReg *const *SuperRegTable);
+
 unsigned MCRegisterInfo_getMatchingSuperReg(const MCRegisterInfo *RI, unsigned Reg, unsigned SubIdx, const MCRegisterClass *RC);
 
 unsigned MCRegisterInfo_getSubReg(const MCRegisterInfo *RI, unsigned Reg, unsigned Idx);
 
-const MCRegisterClass* MCRegisterInfo_getRegClass(const MCRegisterInfo *RI, unsigned i);
+// these are in the header, as alias matchers check register classes of
+// nearly every instruction they print
+
+static inline const MCRegisterClass* MCRegisterInfo_getRegClass(const MCRegisterInfo *RI, unsigned i)
+{
+	//assert(i < getNumRegClasses() && "Register Class ID out of range");
+	if (i >= RI->NumClasses)
+		return 0;
+	return &(RI->Classes[i]);
+}
+
+static inline bool MCRegisterClass_contains(const MCRegisterClass *c, unsigned Reg)
+{
+	unsigned InByte = Reg % 8;
+	unsigned Byte = Reg / 8;
+
+	if (Byte >= c->RegSetSize)
+		return false;
 
-bool MCRegisterClass_contains(const MCRegisterClass *c, unsigned Reg);
+	return (c->RegSet[Byte] & (1 << InByte)) != 0;
+}
 
 #endif
@@ -26,15 +26,21 @@ void SStream_Init(SStream *ss)
 {
 	ss->index = 0;
 	ss->buffer[0] = '\0';
+	ss->quiet = false;
 }
 
 void SStream_concat0(SStream *ss, const char *s)
 {
 #ifndef CAPSTONE_DIET
-	unsigned int len = (unsigned int) strlen(s);
+	SStream_concatLen(ss, s, strlen(s));
+#endif
+}
 
+void SStream_concatLen(SStream *ss, const char *s, size_t len)
+{
+#ifndef CAPSTONE_DIET
 	memcpy(ss->buffer + ss->index, s, len);
-	ss->index += len;
+	ss->index += (int)len;
 	ss->buffer[ss->index] = '\0';
 #endif
 }
@@ -54,6 +60,11 @@ void SStream_concat(SStream *ss, const char *fmt, ...)
 	va_list ap;
 	int ret;
 
+	// formatting is the expensive part of printing, so skip it
+	// if nobody is going to read the text
+	if (ss->quiet)
+		return;
+
 	va_start(ap, fmt);
 	ret = cs_vsnprintf(ss->buffer + ss->index, sizeof(ss->buffer) - (ss->index + 1), fmt, ap);
 	va_end(ap);
@@ -61,121 +72,114 @@ void SStream_concat(SStream *ss, const char *fmt, ...)
 #endif
 }
 
+void SStream_concatDec(SStream *ss, const char *prefix, uint64_t val)
+{
+#ifndef CAPSTONE_DIET
+	char digits[20];
+	int i = sizeof(digits);
+
+	if (ss->quiet)
+		return;
+
+	do {
+		digits[--i] = '0' + (char)(val % 10);
+		val /= 10;
+	} while (val);
+
+	SStream_concat0(ss, prefix);
+	SStream_concatLen(ss, digits + i, sizeof(digits) - i);
+#endif
+}
+
+void SStream_concatHex(SStream *ss, const char *prefix, uint64_t val)
+{
+	SStream_concatHexWidth(ss, prefix, val, 1);
+}
+
+void SStream_concatHexWidth(SStream *ss, const char *prefix, uint64_t val, unsigned int width)
+{
+#ifndef CAPSTONE_DIET
+	static const char hex[] = "0123456789abcdef";
+	char digits[16];
+	int i = sizeof(digits);
+
+	if (ss->quiet)
+		return;
+
+	do {
+		digits[--i] = hex[val & 0xf];
+		val >>= 4;
+	} while (val || sizeof(digits) - i < width);
+
+	SStream_concat0(ss, prefix);
+	SStream_concatLen(ss, digits + i, sizeof(digits) - i);
+#endif
+}
+
+// print magnitude @val of a number, with optional prefix # & minus sign.
+// the number is in hex if it is above HEX_THRESHOLD, or in decimal otherwise.
+static void printNumber(SStream *O, bool bang, bool negative, uint64_t val)
+{
+	static const char *const prefixes[2][2][2] = {
+		{ { "", "0x" }, { "-", "-0x" } },
+		{ { "#", "#0x" }, { "#-", "#-0x" } },
+	};
+	const char *prefix = prefixes[bang][negative][val > HEX_THRESHOLD];
+
+	if (val > HEX_THRESHOLD)
+		SStream_concatHex(O, prefix, val);
+	else
+		SStream_concatDec(O, prefix, val);
+}
+
+// magnitude of a signed number, also correct for the minimum value
+#define ABS64(val) ((val) < 0 ? 0 - (uint64_t)(val) : (uint64_t)(val))
+#define ABS32(val) ((val) < 0 ? 0 - (uint32_t)(val) : (uint32_t)(val))
+
 // print number with prefix #
 void printInt64Bang(SStream *O, int64_t val)
 {
-	if (val >= 0) {
-		if (val > HEX_THRESHOLD)
-			SStream_concat(O, "#0x%"PRIx64, val);
-		else
-			SStream_concat(O, "#%"PRIu64, val);
-	} else {
-		if (val <- HEX_THRESHOLD) {
-			if (val == LONG_MIN)
-				SStream_concat(O, "#-0x%"PRIx64, (uint64_t)val);
-			else
-				SStream_concat(O, "#-0x%"PRIx64, (uint64_t)-val);
-		} else
-			SStream_concat(O, "#-%"PRIu64, -val);
-	}
+	printNumber(O, true, val < 0, ABS64(val));
 }
 
 void printUInt64Bang(SStream *O, uint64_t val)
 {
-	if (val > HEX_THRESHOLD)
-		SStream_concat(O, "#0x%"PRIx64, val);
-	else
-		SStream_concat(O, "#%"PRIu64, val);
+	printNumber(O, true, false, val);
 }
 
 // print number
 void printInt64(SStream *O, int64_t val)
 {
-	if (val >= 0) {
-		if (val > HEX_THRESHOLD)
-			SStream_concat(O, "0x%"PRIx64, val);
-		else
-			SStream_concat(O, "%"PRIu64, val);
-	} else {
-		if (val <- HEX_THRESHOLD) {
-			if (val == LONG_MIN)
-				SStream_concat(O, "-0x%"PRIx64, (uint64_t)val);
-			else
-				SStream_concat(O, "-0x%"PRIx64, (uint64_t)-val);
-		} else
-			SStream_concat(O, "-%"PRIu64, -val);
-	}
+	printNumber(O, false, val < 0, ABS64(val));
 }
 
 void printUInt64(SStream *O, uint64_t val)
 {
-	if (val > HEX_THRESHOLD)
-		SStream_concat(O, "0x%"PRIx64, val);
-	else
-		SStream_concat(O, "%"PRIu64, val);
+	printNumber(O, false, false, val);
 }
 
 // print number in decimal mode
 void printInt32BangDec(SStream *O, int32_t val)
 {
-	if (val >= 0)
-		SStream_concat(O, "#%u", val);
-	else {
-		if (val == INT_MIN)
-			SStream_concat(O, "#-%u", val);
-		else
-			SStream_concat(O, "#-%u", (uint32_t)-val);
-	}
+	SStream_concatDec(O, val < 0 ? "#-" : "#", ABS32(val));
 }
 
 void printInt32Bang(SStream *O, int32_t val)
 {
-	if (val >= 0) {
-		if (val > HEX_THRESHOLD)
-			SStream_concat(O, "#0x%x", val);
-		else
-			SStream_concat(O, "#%u", val);
-	} else {
-		if (val <- HEX_THRESHOLD) {
-			if (val == INT_MIN)
-				SStream_concat(O, "#-0x%x", (uint32_t)val);
-			else
-				SStream_concat(O, "#-0x%x", (uint32_t)-val);
-		} else
-			SStream_concat(O, "#-%u", -val);
-	}
+	printNumber(O, true, val < 0, ABS32(val));
 }
 
 void printInt32(SStream *O, int32_t val)
 {
-	if (val >= 0) {
-		if (val > HEX_THRESHOLD)
-			SStream_concat(O, "0x%x", val);
-		else
-			SStream_concat(O, "%u", val);
-	} else {
-		if (val <- HEX_THRESHOLD) {
-			if (val == INT_MIN)
-				SStream_concat(O, "-0x%x", (uint32_t)val);
-			else
-				SStream_concat(O, "-0x%x", (uint32_t)-val);
-		} else
-			SStream_concat(O, "-%u", -val);
-	}
+	printNumber(O, false, val < 0, ABS32(val));
 }
 
 void printUInt32Bang(SStream *O, uint32_t val)
 {
-	if (val > HEX_THRESHOLD)
-		SStream_concat(O, "#0x%x", val);
-	else
-		SStream_concat(O, "#%u", val);
+	printNumber(O, true, false, val);
 }
 
 void printUInt32(SStream *O, uint32_t val)
 {
-	if (val > HEX_THRESHOLD)
-		SStream_concat(O, "0x%x", val);
-	else
-		SStream_concat(O, "%u", val);
+	printNumber(O, false, false, val);
 }
@@ -9,6 +9,7 @@
 typedef struct SStream {
 	char buffer[512];
 	int index;
+	bool quiet;	// drop formatted output of SStream_concat(), for CS_OPT_NO_TEXT
 } SStream;
 
 void SStream_Init(SStream *ss);
@@ -19,6 +20,19 @@ void SStream_concat0(SStream *ss, const char *s);
 
 void SStream_concat1(SStream *ss, const char c);
 
+// append @len bytes of @s, when its length is already known
+void SStream_concatLen(SStream *ss, const char *s, size_t len);
+
+// append @prefix, then @val in decimal, without going through cs_vsnprintf().
+// like SStream_concat(), this does nothing if @ss is quiet.
+void SStream_concatDec(SStream *ss, const char *prefix, uint64_t val);
+
+// append @prefix, then @val in lowercase hex
+void SStream_concatHex(SStream *ss, const char *prefix, uint64_t val);
+
+// same, with @val padded with zeros to at least @width digits, like "%0*x"
+void SStream_concatHexWidth(SStream *ss, const char *prefix, uint64_t val, unsigned int width);
+
 void printInt64Bang(SStream *O, int64_t val);
 
 void printUInt64Bang(SStream *O, uint64_t val);
@@ -1968,6 +1968,8 @@ static DecodeStatus DecodeSVEIncDecImm(MCInst *Inst, unsigned Imm,
 	return Success;
 }
 
+#include "AArch64GenSubRegTable.inc"
+
 void AArch64_init(MCRegisterInfo *MRI)
 {
 	/*
@@ -1987,6 +1989,8 @@ void AArch64_init(MCRegisterInfo *MRI)
 			0,
 			AArch64SubRegIdxLists, 100,
 			0);
+
+	MCRegisterInfo_setSubRegTables(MRI, AArch64SubRegTable, AArch64SuperRegTable);
 }
 
 #endif
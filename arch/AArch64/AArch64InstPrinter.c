@@ -44,7 +44,7 @@
 static const char *getRegisterName(unsigned RegNo, unsigned AltIdx);
 static void printOperand(MCInst *MI, unsigned OpNum, SStream *O);
 static bool printSysAlias(MCInst *MI, SStream *O);
-static char *printAliasInstr(MCInst *MI, SStream *OS, MCRegisterInfo *MRI);
+static const char *printAliasInstr(MCInst *MI, SStream *OS, MCRegisterInfo *MRI);
 static void printInstruction(MCInst *MI, SStream *O);
 static void printShifter(MCInst *MI, unsigned OpNum, SStream *O);
 static void printCustomAliasOperand(MCInst *MI, unsigned OpIdx,
@@ -103,7 +103,7 @@ void AArch64_printInst(MCInst *MI, SStream *O, void *Info)
 	// Check for special encodings and print the canonical alias instead.
 	unsigned Opcode = MCInst_getOpcode(MI);
 	int LSB, Width;
-	char *mnem;
+	const char *mnem;
 
 	// printf(">>> opcode = %u\n", MCInst_getOpcode(MI));
 
@@ -123,29 +123,38 @@ void AArch64_printInst(MCInst *MI, SStream *O, void *Info)
 
 		if (MCOperand_isImm(Op2) && MCOperand_getImm(Op2) == 0 && MCOperand_isImm(Op3)) {
 			const char *AsmMnemonic = NULL;
+			arm64_insn AsmId = ARM64_INS_INVALID;
 
 			switch (MCOperand_getImm(Op3)) {
 				default:
 					break;
 
 				case 7:
-					if (IsSigned)
+					if (IsSigned) {
 						AsmMnemonic = "sxtb";
-					else if (!Is64Bit)
+						AsmId = ARM64_INS_SXTB;
+					} else if (!Is64Bit) {
 						AsmMnemonic = "uxtb";
+						AsmId = ARM64_INS_UXTB;
+					}
 					break;
 
 				case 15:
-					if (IsSigned)
+					if (IsSigned) {
 						AsmMnemonic = "sxth";
-					else if (!Is64Bit)
+						AsmId = ARM64_INS_SXTH;
+					} else if (!Is64Bit) {
 						AsmMnemonic = "uxth";
+						AsmId = ARM64_INS_UXTH;
+					}
 					break;
 
 				case 31:
 					// *xtw is only valid for signed 64-bit operations.
-					if (Is64Bit && IsSigned)
+					if (Is64Bit && IsSigned) {
 						AsmMnemonic = "sxtw";
+						AsmId = ARM64_INS_SXTW;
+					}
 					break;
 			}
 
@@ -174,7 +183,7 @@ void AArch64_printInst(MCInst *MI, SStream *O, void *Info)
 					MI->flat_insn->detail->arm64.op_count++;
 				}
 
-				MCInst_setOpcodePub(MI, AArch64_map_insn(AsmMnemonic));
+				MCInst_setOpcodePub(MI, AsmId);
 
 				return;
 			}
@@ -185,28 +194,35 @@ void AArch64_printInst(MCInst *MI, SStream *O, void *Info)
 		// the range 0 to (reg.size -1).
 		if (MCOperand_isImm(Op2) && MCOperand_isImm(Op3)) {
 			const char *AsmMnemonic = NULL;
+			arm64_insn AsmId = ARM64_INS_INVALID;
 			int shift = 0;
 			int immr = (int)MCOperand_getImm(Op2);
 			int imms = (int)MCOperand_getImm(Op3);
 
 			if (Opcode == AArch64_UBFMWri && imms != 0x1F && ((imms + 1) == immr)) {
 				AsmMnemonic = "lsl";
+				AsmId = ARM64_INS_LSL;
 				shift = 31 - imms;
 			} else if (Opcode == AArch64_UBFMXri && imms != 0x3f &&
 					((imms + 1 == immr))) {
 				AsmMnemonic = "lsl";
+				AsmId = ARM64_INS_LSL;
 				shift = 63 - imms;
 			} else if (Opcode == AArch64_UBFMWri && imms == 0x1f) {
 				AsmMnemonic = "lsr";
+				AsmId = ARM64_INS_LSR;
 				shift = immr;
 			} else if (Opcode == AArch64_UBFMXri && imms == 0x3f) {
 				AsmMnemonic = "lsr";
+				AsmId = ARM64_INS_LSR;
 				shift = immr;
 			} else if (Opcode == AArch64_SBFMWri && imms == 0x1f) {
 				AsmMnemonic = "asr";
+				AsmId = ARM64_INS_ASR;
 				shift = immr;
 			} else if (Opcode == AArch64_SBFMXri && imms == 0x3f) {
 				AsmMnemonic = "asr";
+				AsmId = ARM64_INS_ASR;
 				shift = immr;
 			}
 
@@ -217,7 +233,7 @@ void AArch64_printInst(MCInst *MI, SStream *O, void *Info)
 
 				printInt32Bang(O, shift);
 
-				MCInst_setOpcodePub(MI, AArch64_map_insn(AsmMnemonic));
+				MCInst_setOpcodePub(MI, AsmId);
 
 				if (MI->csh->detail) {
 #ifndef CAPSTONE_DIET
@@ -263,7 +279,7 @@ void AArch64_printInst(MCInst *MI, SStream *O, void *Info)
 
 			printInt32Bang(O, (int)MCOperand_getImm(Op3) + 1);
 
-			MCInst_setOpcodePub(MI, AArch64_map_insn(IsSigned ? "sbfiz" : "ubfiz"));
+			MCInst_setOpcodePub(MI, IsSigned ? ARM64_INS_SBFIZ : ARM64_INS_UBFIZ);
 
 			if (MI->csh->detail) {
 #ifndef CAPSTONE_DIET
@@ -313,7 +329,7 @@ void AArch64_printInst(MCInst *MI, SStream *O, void *Info)
 		SStream_concat0(O, ", ");
 		printInt32Bang(O, (int)MCOperand_getImm(Op3) - (int)MCOperand_getImm(Op2) + 1);
 
-		MCInst_setOpcodePub(MI, AArch64_map_insn(IsSigned ? "sbfx" : "ubfx"));
+		MCInst_setOpcodePub(MI, IsSigned ? ARM64_INS_SBFX : ARM64_INS_UBFX);
 
 		if (MI->csh->detail) {
 #ifndef CAPSTONE_DIET
@@ -373,7 +389,7 @@ void AArch64_printInst(MCInst *MI, SStream *O, void *Info)
 			printInt32Bang(O, LSB);
 			SStream_concat0(O, ", ");
 			printInt32Bang(O, Width);
-			MCInst_setOpcodePub(MI, AArch64_map_insn("bfc"));
+			// bfc has no public ID of its own, so keep the one of BFM
 
 			if (MI->csh->detail) {
 #ifndef CAPSTONE_DIET
@@ -419,7 +435,7 @@ void AArch64_printInst(MCInst *MI, SStream *O, void *Info)
 			SStream_concat0(O, ", ");
 			printInt32Bang(O, Width);
 
-			MCInst_setOpcodePub(MI, AArch64_map_insn("bfi"));
+			MCInst_setOpcodePub(MI, ARM64_INS_BFI);
 
 			if (MI->csh->detail) {
 #ifndef CAPSTONE_DIET
@@ -471,7 +487,7 @@ void AArch64_printInst(MCInst *MI, SStream *O, void *Info)
 		SStream_concat0(O, ", ");
 		printInt32Bang(O, Width);
 
-		MCInst_setOpcodePub(MI, AArch64_map_insn("bfxil"));
+		MCInst_setOpcodePub(MI, ARM64_INS_BFXIL);
 
 		if (MI->csh->detail) {
 #ifndef CAPSTONE_DIET
@@ -545,7 +561,7 @@ void AArch64_printInst(MCInst *MI, SStream *O, void *Info)
 				MI->flat_insn->detail->arm64.op_count++;
 			}
 
-			MCInst_setOpcodePub(MI, AArch64_map_insn("mov"));
+			MCInst_setOpcodePub(MI, ARM64_INS_MOV);
 
 			return;
 		}
@@ -581,7 +597,7 @@ void AArch64_printInst(MCInst *MI, SStream *O, void *Info)
 				MI->flat_insn->detail->arm64.op_count++;
 			}
 
-			MCInst_setOpcodePub(MI, AArch64_map_insn("mov"));
+			MCInst_setOpcodePub(MI, ARM64_INS_MOV);
 
 			return;
 		}
@@ -615,7 +631,7 @@ void AArch64_printInst(MCInst *MI, SStream *O, void *Info)
 				MI->flat_insn->detail->arm64.op_count++;
 			}
 
-			MCInst_setOpcodePub(MI, AArch64_map_insn("mov"));
+			MCInst_setOpcodePub(MI, ARM64_INS_MOV);
 
 			return;
 		}
@@ -625,17 +641,15 @@ void AArch64_printInst(MCInst *MI, SStream *O, void *Info)
 	// not encoded, so for printing it is treated as a special case here:
 	if (Opcode == AArch64_TSB) {
 		SStream_concat0(O, "tsb\tcsync");
-		MCInst_setOpcodePub(MI, AArch64_map_insn("tsb"));
+		MCInst_setOpcodePub(MI, ARM64_INS_TSB);
 		return;
 	}
 
 	MI->MRI = Info;
 
+	// this also sets the instruction ID of the alias
 	mnem = printAliasInstr(MI, O, (MCRegisterInfo *)Info);
 	if (mnem) {
-		MCInst_setOpcodePub(MI, AArch64_map_insn(mnem));
-		cs_mem_free(mnem);
-
 		switch(MCInst_getOpcode(MI)) {
 			default: break;
 			case AArch64_LD1i8_POST:
@@ -880,6 +894,7 @@ static bool printSysAlias(MCInst *MI, SStream *O)
 	//assert(Opcode == AArch64_SYSxt && "Invalid opcode for SYS alias!");
 
 	const char *Ins;
+	arm64_insn InsId;
 	uint16_t Encoding;
 	bool NeedsReg;
 	char Name[64];
@@ -912,6 +927,7 @@ static bool printSysAlias(MCInst *MI, SStream *O)
 
 				NeedsReg = IC->NeedsReg;
 				Ins = "ic";
+				InsId = ARM64_INS_IC;
 				strncpy(Name, IC->Name, sizeof(Name) - 1);
 			}
 			break;
@@ -925,6 +941,7 @@ static bool printSysAlias(MCInst *MI, SStream *O)
 
 				NeedsReg = true;
 				Ins = "dc";
+				InsId = ARM64_INS_DC;
 				strncpy(Name, DC->Name, sizeof(Name) - 1);
 			}
 			break;
@@ -938,6 +955,7 @@ static bool printSysAlias(MCInst *MI, SStream *O)
 
 				NeedsReg = true;
 				Ins = "at";
+				InsId = ARM64_INS_AT;
 				strncpy(Name, AT->Name, sizeof(Name) - 1);
 			}
 			break;
@@ -951,6 +969,7 @@ static bool printSysAlias(MCInst *MI, SStream *O)
 
 		NeedsReg = TLBI->NeedsReg;
 		Ins = "tlbi";
+		InsId = ARM64_INS_TLBI;
 		strncpy(Name, TLBI->Name, sizeof(Name) - 1);
 	} else
 		return false;
@@ -961,7 +980,7 @@ static bool printSysAlias(MCInst *MI, SStream *O)
 		SStream_concat(O, ", %s", getRegisterName(MCOperand_getReg(MCInst_getOperand(MI, 4)), AArch64_NoRegAltName));
 	}
 
-	MCInst_setOpcodePub(MI, AArch64_map_insn(Ins));
+	MCInst_setOpcodePub(MI, InsId);
 
 	if (MI->csh->detail) {
 #if 0
@@ -1154,7 +1173,7 @@ static void printSysCROperand(MCInst *MI, unsigned OpNum, SStream *O)
 {
 	MCOperand *Op = MCInst_getOperand(MI, OpNum);
 	//assert(Op.isImm() && "System instruction C[nm] operands must be immediates!");
-	SStream_concat(O, "c%u", MCOperand_getImm(Op));
+	SStream_concatDec(O, "c", (uint32_t)MCOperand_getImm(Op));
 
 	if (MI->csh->detail) {
 #ifndef CAPSTONE_DIET
@@ -1235,9 +1254,9 @@ static void printLogicalImm64(MCInst *MI, unsigned OpNum, SStream *O)
 		case ARM64_INS_TST:
 			// do not print number in negative form
 			if (Val >= 0 && Val <= HEX_THRESHOLD)
-				SStream_concat(O, "#%u", (int)Val);
+				SStream_concatDec(O, "#", (uint32_t)Val);
 			else
-				SStream_concat(O, "#0x%"PRIx64, Val);
+				SStream_concatHex(O, "#0x", Val);
 			break;
 	}
 
@@ -1472,7 +1491,7 @@ static void printMemExtendImpl(MCInst *MI, bool SignExtend, bool DoShift, unsign
 	}
 
 	if (DoShift || IsLSL) {
-		SStream_concat(O, " #%u", Log2_32(Width / 8));
+		SStream_concatDec(O, " #", (uint32_t)Log2_32(Width / 8));
 
 		if (MI->csh->detail) {
 			MI->flat_insn->detail->arm64.operands[MI->flat_insn->detail->arm64.op_count].shift.type = ARM64_SFT_LSL;
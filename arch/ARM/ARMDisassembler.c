@@ -445,6 +445,8 @@ static DecodeStatus DecodePredicateOperand(MCInst *Inst, unsigned Val,
 
 #define GET_REGINFO_MC_DESC
 #include "ARMGenRegisterInfo.inc"
+#include "ARMGenSubRegTable.inc"
+
 void ARM_init(MCRegisterInfo *MRI)
 {
 	/* 
@@ -462,6 +464,8 @@ void ARM_init(MCRegisterInfo *MRI)
 			0, 0, ARMRegDiffLists, 0, 
 			ARMSubRegIdxLists, 57,
 			0);
+
+	MCRegisterInfo_setSubRegTables(MRI, ARMSubRegTable, ARMSuperRegTable);
 }
 
 // Post-decoding checks
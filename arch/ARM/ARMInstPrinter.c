@@ -168,6 +168,16 @@ static void set_mem_access(MCInst *MI, bool status)
 	}
 }
 
+// print an immediate offset @val as "#val", or "#-val" if @minus is set,
+// in hex if it is above HEX_THRESHOLD
+static void printSignedImm(SStream *O, bool minus, unsigned val)
+{
+	if (val > HEX_THRESHOLD)
+		SStream_concatHex(O, minus ? "#-0x" : "#0x", val);
+	else
+		SStream_concatDec(O, minus ? "#-" : "#", val);
+}
+
 static void op_addImm(MCInst *MI, int v)
 {
 	if (MI->csh->detail) {
@@ -231,7 +241,7 @@ static void printRegImmShift(MCInst *MI, SStream *O, ARM_AM_ShiftOpc ShOpc, unsi
 
 	if (ShOpc != ARM_AM_rrx) {
 		SStream_concat0(O, " ");
-		SStream_concat(O, "#%u", translateShiftImm(ShImm));
+		SStream_concatDec(O, "#", (uint32_t)translateShiftImm(ShImm));
 		if (MI->csh->detail) {
 			if (MI->csh->doing_mem)
 				MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count].shift.value = translateShiftImm(ShImm);
@@ -920,7 +930,7 @@ static void printThumbLdrLabelOperand(MCInst *MI, unsigned OpNum, SStream *O)
 		OffImm = 0;
 
 	if (isSub) {
-		SStream_concat(O, "#-0x%x", -OffImm);
+		SStream_concatHex(O, "#-0x", (uint32_t)-OffImm);
 	} else {
 		printUInt32Bang(O, OffImm);
 	}
@@ -1021,10 +1031,7 @@ static void printAM2PreOrOffsetIndexOp(MCInst *MI, unsigned Op, SStream *O)
 			subtracted = getAM2Op(imm3);
 
 			SStream_concat0(O, ", ");
-			if (tmp > HEX_THRESHOLD)
-				SStream_concat(O, "#%s0x%x", ARM_AM_getAddrOpcStr(subtracted), tmp);
-			else
-				SStream_concat(O, "#%s%u", ARM_AM_getAddrOpcStr(subtracted), tmp);
+			printSignedImm(O, subtracted == ARM_AM_sub, tmp);
 			if (MI->csh->detail) {
 				MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count].shift.type = (arm_shifter)getAM2Op(imm3);
 				MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count].shift.value = tmp;
@@ -1130,12 +1137,7 @@ static void printAddrMode2OffsetOperand(MCInst *MI, unsigned OpNum, SStream *O)
 
 	if (!MCOperand_getReg(MO1)) {
 		unsigned ImmOffs = getAM2Offset((unsigned int)MCOperand_getImm(MO2));
-		if (ImmOffs > HEX_THRESHOLD)
-			SStream_concat(O, "#%s0x%x",
-					ARM_AM_getAddrOpcStr(subtracted), ImmOffs);
-		else
-			SStream_concat(O, "#%s%u",
-					ARM_AM_getAddrOpcStr(subtracted), ImmOffs);
+		printSignedImm(O, subtracted == ARM_AM_sub, ImmOffs);
 
 		if (MI->csh->detail) {
 			MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count].type = ARM_OP_IMM;
@@ -1206,10 +1208,8 @@ static void printAM3PreOrOffsetIndexOp(MCInst *MI, unsigned Op, SStream *O,
 	ImmOffs = getAM3Offset((unsigned int)MCOperand_getImm(MO3));
 
 	if (AlwaysPrintImm0 || ImmOffs || (sign == ARM_AM_sub)) {
-		if (ImmOffs > HEX_THRESHOLD)
-			SStream_concat(O, ", #%s0x%x", ARM_AM_getAddrOpcStr(sign), ImmOffs);
-		else
-			SStream_concat(O, ", #%s%u", ARM_AM_getAddrOpcStr(sign), ImmOffs);
+		SStream_concat0(O, ", ");
+		printSignedImm(O, sign == ARM_AM_sub, ImmOffs);
 	}
 
 	if (MI->csh->detail) {
@@ -1260,10 +1260,7 @@ static void printAddrMode3OffsetOperand(MCInst *MI, unsigned OpNum, SStream *O)
 	}
 
 	ImmOffs = getAM3Offset((unsigned int)MCOperand_getImm(MO2));
-	if (ImmOffs > HEX_THRESHOLD)
-		SStream_concat(O, "#%s0x%x", ARM_AM_getAddrOpcStr(subtracted), ImmOffs);
-	else
-		SStream_concat(O, "#%s%u", ARM_AM_getAddrOpcStr(subtracted), ImmOffs);
+	printSignedImm(O, subtracted == ARM_AM_sub, ImmOffs);
 
 	if (MI->csh->detail) {
 		MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count].type = ARM_OP_IMM;
@@ -1278,10 +1275,7 @@ static void printPostIdxImm8Operand(MCInst *MI, unsigned OpNum, SStream *O)
 	MCOperand *MO = MCInst_getOperand(MI, OpNum);
 	unsigned Imm = (unsigned int)MCOperand_getImm(MO);
 
-	if ((Imm & 0xff) > HEX_THRESHOLD)
-		SStream_concat(O, "#%s0x%x", ((Imm & 256) ? "" : "-"), (Imm & 0xff));
-	else
-		SStream_concat(O, "#%s%u", ((Imm & 256) ? "" : "-"), (Imm & 0xff));
+	printSignedImm(O, !(Imm & 256), Imm & 0xff);
 
 	if (MI->csh->detail) {
 		MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count].type = ARM_OP_IMM;
@@ -1311,11 +1305,7 @@ static void printPostIdxImm8s4Operand(MCInst *MI, unsigned OpNum, SStream *O)
 	MCOperand *MO = MCInst_getOperand(MI, OpNum);
 	int Imm = (int)MCOperand_getImm(MO);
 
-	if (((Imm & 0xff) << 2) > HEX_THRESHOLD) {
-		SStream_concat(O, "#%s0x%x", ((Imm & 256) ? "" : "-"), ((Imm & 0xff) << 2));
-	} else {
-		SStream_concat(O, "#%s%u", ((Imm & 256) ? "" : "-"), ((Imm & 0xff) << 2));
-	}
+	printSignedImm(O, !(Imm & 256), (Imm & 0xff) << 2);
 
 	if (MI->csh->detail) {
 		int v = (Imm & 256) ? ((Imm & 0xff) << 2) : -((Imm & 0xff) << 2);
@@ -1352,14 +1342,8 @@ static void printAddrMode5Operand(MCInst *MI, unsigned OpNum, SStream *O,
 
 	ImmOffs = ARM_AM_getAM5Offset((unsigned int)MCOperand_getImm(MO2));
 	if (AlwaysPrintImm0 || ImmOffs || Op == ARM_AM_sub) {
-		if (ImmOffs * 4 > HEX_THRESHOLD)
-			SStream_concat(O, ", #%s0x%x",
-					ARM_AM_getAddrOpcStr(Op),
-					ImmOffs * 4);
-		else
-			SStream_concat(O, ", #%s%u",
-					ARM_AM_getAddrOpcStr(Op),
-					ImmOffs * 4);
+		SStream_concat0(O, ", ");
+		printSignedImm(O, Op == ARM_AM_sub, ImmOffs * 4);
 
 		if (MI->csh->detail) {
 			if (Op)
@@ -1402,10 +1386,8 @@ static void printAddrMode5FP16Operand(MCInst *MI, unsigned OpNum, SStream *O,
   }
 
   if (AlwaysPrintImm0 || ImmOffs || Op == ARM_AM_sub) {
-	if (ImmOffs * 2 > HEX_THRESHOLD)
-		SStream_concat(O, ", #%s0x%x", ARM_AM_getAddrOpcStr(Op), ImmOffs * 2);
-	else
-		SStream_concat(O, ", #%s%u", ARM_AM_getAddrOpcStr(Op), ImmOffs * 2);
+	SStream_concat0(O, ", ");
+	printSignedImm(O, Op == ARM_AM_sub, ImmOffs * 2);
 
 	if (MI->csh->detail) {
 		if (Op)
@@ -1439,9 +1421,9 @@ static void printAddrMode6Operand(MCInst *MI, unsigned OpNum, SStream *O)
 	tmp = (unsigned int)MCOperand_getImm(MO2);
 	if (tmp) {
 		if (tmp << 3 > HEX_THRESHOLD)
-			SStream_concat(O, ":0x%x", (tmp << 3));
+			SStream_concatHex(O, ":0x", (uint32_t)(tmp << 3));
 		else
-			SStream_concat(O, ":%u", (tmp << 3));
+			SStream_concatDec(O, ":", (uint32_t)(tmp << 3));
 
 		if (MI->csh->detail)
 			MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count].mem.disp = tmp << 3;
@@ -1498,9 +1480,9 @@ static void printBitfieldInvMaskImmOperand(MCInst *MI, unsigned OpNum, SStream *
 	printUInt32Bang(O, lsb);
 
 	if (width > HEX_THRESHOLD)
-		SStream_concat(O, ", #0x%x", width);
+		SStream_concatHex(O, ", #0x", (uint32_t)width);
 	else
-		SStream_concat(O, ", #%u", width);
+		SStream_concatDec(O, ", #", (uint32_t)width);
 
 	if (MI->csh->detail) {
 		MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count].type = ARM_OP_IMM;
@@ -1545,9 +1527,9 @@ static void printShiftImmOperand(MCInst *MI, unsigned OpNum, SStream *O)
 	if (isASR) {
 		unsigned tmp = Amt == 0 ? 32 : Amt;
 		if (tmp > HEX_THRESHOLD)
-			SStream_concat(O, ", asr #0x%x", tmp);
+			SStream_concatHex(O, ", asr #0x", (uint32_t)tmp);
 		else
-			SStream_concat(O, ", asr #%u", tmp);
+			SStream_concatDec(O, ", asr #", (uint32_t)tmp);
 
 		if (MI->csh->detail) {
 			MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count - 1].shift.type = ARM_SFT_ASR;
@@ -1555,9 +1537,9 @@ static void printShiftImmOperand(MCInst *MI, unsigned OpNum, SStream *O)
 		}
 	} else if (Amt) {
 		if (Amt > HEX_THRESHOLD)
-			SStream_concat(O, ", lsl #0x%x", Amt);
+			SStream_concatHex(O, ", lsl #0x", (uint32_t)Amt);
 		else
-			SStream_concat(O, ", lsl #%u", Amt);
+			SStream_concatDec(O, ", lsl #", (uint32_t)Amt);
 
 		if (MI->csh->detail) {
 			MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count - 1].shift.type = ARM_SFT_LSL;
@@ -1575,9 +1557,9 @@ static void printPKHLSLShiftImm(MCInst *MI, unsigned OpNum, SStream *O)
 
 	//assert(Imm > 0 && Imm < 32 && "Invalid PKH shift immediate value!");
 	if (Imm > HEX_THRESHOLD)
-		SStream_concat(O, ", lsl #0x%x", Imm);
+		SStream_concatHex(O, ", lsl #0x", (uint32_t)Imm);
 	else
-		SStream_concat(O, ", lsl #%u", Imm);
+		SStream_concatDec(O, ", lsl #", (uint32_t)Imm);
 
 	if (MI->csh->detail) {
 		MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count - 1].shift.type = ARM_SFT_LSL;
@@ -1595,9 +1577,9 @@ static void printPKHASRShiftImm(MCInst *MI, unsigned OpNum, SStream *O)
 
 	//assert(Imm > 0 && Imm <= 32 && "Invalid PKH shift immediate value!");
 	if (Imm > HEX_THRESHOLD)
-		SStream_concat(O, ", asr #0x%x", Imm);
+		SStream_concatHex(O, ", asr #0x", (uint32_t)Imm);
 	else
-		SStream_concat(O, ", asr #%u", Imm);
+		SStream_concatDec(O, ", asr #", (uint32_t)Imm);
 
 	if (MI->csh->detail) {
 		MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count - 1].shift.type = ARM_SFT_ASR;
@@ -1768,9 +1750,9 @@ static void printMSRMaskOperand(MCInst *MI, unsigned OpNum, SStream *O)
 		}
 
 		if (SYSm > HEX_THRESHOLD)
-			SStream_concat(O, "%x", SYSm);
+			SStream_concatHex(O, "", (uint32_t)SYSm);
 		else
-			SStream_concat(O, "%u", SYSm);
+			SStream_concatDec(O, "", (uint32_t)SYSm);
 
 		if (MI->csh->detail)
 			MCOperand_CreateImm0(MI, SYSm);
@@ -1896,7 +1878,7 @@ static void printPImmediate(MCInst *MI, unsigned OpNum, SStream *O)
 {
 	unsigned imm = (unsigned int)MCOperand_getImm(MCInst_getOperand(MI, OpNum));
 
-	SStream_concat(O, "p%u", imm);
+	SStream_concatDec(O, "p", (uint32_t)imm);
 
 	if (MI->csh->detail) {
 		MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count].type = ARM_OP_PIMM;
@@ -1909,7 +1891,7 @@ static void printCImmediate(MCInst *MI, unsigned OpNum, SStream *O)
 {
 	unsigned imm = (unsigned int)MCOperand_getImm(MCInst_getOperand(MI, OpNum));
 
-	SStream_concat(O, "c%u", imm);
+	SStream_concatDec(O, "c", (uint32_t)imm);
 
 	if (MI->csh->detail) {
 		MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count].type = ARM_OP_CIMM;
@@ -1922,9 +1904,10 @@ static void printCoprocOptionImm(MCInst *MI, unsigned OpNum, SStream *O)
 {
 	unsigned tmp = (unsigned int)MCOperand_getImm(MCInst_getOperand(MI, OpNum));
 	if (tmp > HEX_THRESHOLD)
-		SStream_concat(O, "{0x%x}", tmp);
+		SStream_concatHex(O, "{0x", tmp);
 	else
-		SStream_concat(O, "{%u}", tmp);
+		SStream_concatDec(O, "{", tmp);
+	SStream_concat0(O, "}");
 
 	if (MI->csh->detail) {
 		MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count].type = ARM_OP_IMM;
@@ -1949,12 +1932,12 @@ static void printAdrLabelOperand(MCInst *MI, unsigned OpNum, SStream *O, unsigne
 		}
 	} else {
 		if (OffImm < 0)
-			SStream_concat(O, "#-0x%x", -OffImm);
+			SStream_concatHex(O, "#-0x", (uint32_t)-OffImm);
 		else {
 			if (OffImm > HEX_THRESHOLD)
-				SStream_concat(O, "#0x%x", OffImm);
+				SStream_concatHex(O, "#0x", (uint32_t)OffImm);
 			else
-				SStream_concat(O, "#%u", OffImm);
+				SStream_concatDec(O, "#", (uint32_t)OffImm);
 		}
 
 		if (MI->csh->detail) {
@@ -2153,20 +2136,20 @@ static void printAddrModeImm12Operand(MCInst *MI, unsigned OpNum,
 
 	if (isSub) {
 		if (OffImm < -HEX_THRESHOLD)
-			SStream_concat(O, ", #-0x%x", -OffImm);
+			SStream_concatHex(O, ", #-0x", (uint32_t)-OffImm);
 		else
-			SStream_concat(O, ", #-%u", -OffImm);
+			SStream_concatDec(O, ", #-", (uint32_t)-OffImm);
 	} else if (AlwaysPrintImm0 || OffImm > 0) {
 		if (OffImm >= 0) {
 			if (OffImm > HEX_THRESHOLD)
-				SStream_concat(O, ", #0x%x", OffImm);
+				SStream_concatHex(O, ", #0x", (uint32_t)OffImm);
 			else
-				SStream_concat(O, ", #%u", OffImm);
+				SStream_concatDec(O, ", #", (uint32_t)OffImm);
 		} else {
 			if (OffImm < -HEX_THRESHOLD)
-				SStream_concat(O, ", #-0x%x", -OffImm);
+				SStream_concatHex(O, ", #-0x", (uint32_t)-OffImm);
 			else
-				SStream_concat(O, ", #-%u", -OffImm);
+				SStream_concatDec(O, ", #-", (uint32_t)-OffImm);
 		}
 	}
 
@@ -2201,12 +2184,12 @@ static void printT2AddrModeImm8Operand(MCInst *MI, unsigned OpNum, SStream *O,
 		OffImm = 0;
 
 	if (isSub)
-		SStream_concat(O, ", #-0x%x", -OffImm);
+		SStream_concatHex(O, ", #-0x", (uint32_t)-OffImm);
 	else if (AlwaysPrintImm0 || OffImm > 0) {
 		if (OffImm > HEX_THRESHOLD)
-			SStream_concat(O, ", #0x%x", OffImm);
+			SStream_concatHex(O, ", #0x", (uint32_t)OffImm);
 		else
-			SStream_concat(O, ", #%u", OffImm);
+			SStream_concatDec(O, ", #", (uint32_t)OffImm);
 	}
 
 	if (MI->csh->detail)
@@ -2247,12 +2230,12 @@ static void printT2AddrModeImm8s4Operand(MCInst *MI,
 		OffImm = 0;
 
 	if (isSub) {
-		SStream_concat(O, ", #-0x%x", -OffImm);
+		SStream_concatHex(O, ", #-0x", (uint32_t)-OffImm);
 	} else if (AlwaysPrintImm0 || OffImm > 0) {
 		if (OffImm > HEX_THRESHOLD)
-			SStream_concat(O, ", #0x%x", OffImm);
+			SStream_concatHex(O, ", #0x", (uint32_t)OffImm);
 		else
-			SStream_concat(O, ", #%u", OffImm);
+			SStream_concatDec(O, ", #", (uint32_t)OffImm);
 	}
 
 	if (MI->csh->detail)
@@ -2371,7 +2354,7 @@ static void printT2AddrModeSoRegOperand(MCInst *MI,
 	if (ShAmt) {
 		//assert(ShAmt <= 3 && "Not a valid Thumb2 addressing mode!");
 		SStream_concat0(O, ", lsl ");
-		SStream_concat(O, "#%u", ShAmt);
+		SStream_concatDec(O, "#", (uint32_t)ShAmt);
 
 		if (MI->csh->detail) {
 			MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count].shift.type = ARM_SFT_LSL;
@@ -2408,9 +2391,9 @@ static void printNEONModImmOperand(MCInst *MI, unsigned OpNum, SStream *O)
 	uint64_t Val = ARM_AM_decodeNEONModImm(EncodedImm, &EltBits);
 
 	if (Val > HEX_THRESHOLD)
-		SStream_concat(O, "#0x%"PRIx64, Val);
+		SStream_concatHex(O, "#0x", Val);
 	else
-		SStream_concat(O, "#%"PRIu64, Val);
+		SStream_concatDec(O, "#", Val);
 
 	if (MI->csh->detail) {
 		MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count].type = ARM_OP_IMM;
@@ -2478,16 +2461,16 @@ static void printModImmOperand(MCInst *MI, unsigned OpNum, SStream *O)
 		// #rot has the least possible value
 		if (PrintUnsigned) {
 			if (Rotated > HEX_THRESHOLD || Rotated < -HEX_THRESHOLD)
-				SStream_concat(O, "#0x%x", Rotated);
+				SStream_concatHex(O, "#0x", (uint32_t)Rotated);
 			else
-				SStream_concat(O, "#%u", Rotated);
+				SStream_concatDec(O, "#", (uint32_t)Rotated);
 		} else if (Rotated >= 0) {
 			if (Rotated > HEX_THRESHOLD)
-				SStream_concat(O, "#0x%x", Rotated);
+				SStream_concatHex(O, "#0x", (uint32_t)Rotated);
 			else
-				SStream_concat(O, "#%u", Rotated);
+				SStream_concatDec(O, "#", (uint32_t)Rotated);
 		} else {
-			SStream_concat(O, "#0x%x", Rotated);
+			SStream_concatHex(O, "#0x", (uint32_t)Rotated);
 		}
 
 		if (MI->csh->detail) {
@@ -2500,7 +2483,8 @@ static void printModImmOperand(MCInst *MI, unsigned OpNum, SStream *O)
 	}
 
 	// Explicit #bits, #rot implied
-	SStream_concat(O, "#%u, #%u", Bits, Rot);
+	SStream_concatDec(O, "#", Bits);
+	SStream_concatDec(O, ", #", Rot);
 
 	if (MI->csh->detail) {
 		MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count].type = ARM_OP_IMM;
@@ -2547,9 +2531,10 @@ static void printVectorIndex(MCInst *MI, unsigned OpNum, SStream *O)
 	unsigned tmp = (unsigned int)MCOperand_getImm(MCInst_getOperand(MI, OpNum));
 
 	if (tmp > HEX_THRESHOLD)
-		SStream_concat(O, "[0x%x]", tmp);
+		SStream_concatHex(O, "[0x", tmp);
 	else
-		SStream_concat(O, "[%u]", tmp);
+		SStream_concatDec(O, "[", tmp);
+	SStream_concat0(O, "]");
 
 	if (MI->csh->detail) {
 		MI->flat_insn->detail->arm.operands[MI->flat_insn->detail->arm.op_count - 1].vector_index = tmp;
@@ -324,13 +324,13 @@ void ARM_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
 			handle.detail = h->detail;
 
 			memcpy(insn->detail->regs_read, insns[i].regs_use, sizeof(insns[i].regs_use));
-			insn->detail->regs_read_count = (uint8_t)count_positive(insns[i].regs_use);
+			insn->detail->regs_read_count = insns[i].regs_use_count;
 
 			memcpy(insn->detail->regs_write, insns[i].regs_mod, sizeof(insns[i].regs_mod));
-			insn->detail->regs_write_count = (uint8_t)count_positive(insns[i].regs_mod);
+			insn->detail->regs_write_count = insns[i].regs_mod_count;
 
 			memcpy(insn->detail->groups, insns[i].groups, sizeof(insns[i].groups));
-			insn->detail->groups_count = (uint8_t)count_positive8(insns[i].groups);
+			insn->detail->groups_count = insns[i].groups_count;
 
 			insn->detail->arm.update_flags = cs_reg_write((csh)&handle, insn, ARM_REG_CPSR);
 
@@ -487,7 +487,7 @@ static const insn_op insn_ops[] = {
 // given internal insn id, return operand access info
 const uint8_t *ARM_get_op_access(cs_struct *h, unsigned int id)
 {
-	int i = insn_find(insns, ARR_SIZE(insns), id, &h->insn_cache);
+	int i = insn_find(insns, ARR_SIZE(insns), id);
 	if (i != 0) {
 		return insn_ops[i].access;
 	}
@@ -501,6 +501,7 @@ void ARM_reg_access(const cs_insn *insn,
 {
 	uint8_t i;
 	uint8_t read_count, write_count;
+	cs_regs_bitset read_bits, write_bits;
 	cs_arm *arm = &(insn->detail->arm);
 
 	read_count = insn->detail->regs_read_count;
@@ -509,32 +510,34 @@ void ARM_reg_access(const cs_insn *insn,
 	// implicit registers
 	memcpy(regs_read, insn->detail->regs_read, read_count * sizeof(insn->detail->regs_read[0]));
 	memcpy(regs_write, insn->detail->regs_write, write_count * sizeof(insn->detail->regs_write[0]));
+	regs_bitset_fill(read_bits, regs_read, read_count);
+	regs_bitset_fill(write_bits, regs_write, write_count);
 
 	// explicit registers
 	for (i = 0; i < arm->op_count; i++) {
 		cs_arm_op *op = &(arm->operands[i]);
 		switch((int)op->type) {
 			case ARM_OP_REG:
-				if ((op->access & CS_AC_READ) && !arr_exist(regs_read, read_count, op->reg)) {
+				if ((op->access & CS_AC_READ) && regs_bitset_add(read_bits, op->reg)) {
 					regs_read[read_count] = (uint16_t)op->reg;
 					read_count++;
 				}
-				if ((op->access & CS_AC_WRITE) && !arr_exist(regs_write, write_count, op->reg)) {
+				if ((op->access & CS_AC_WRITE) && regs_bitset_add(write_bits, op->reg)) {
 					regs_write[write_count] = (uint16_t)op->reg;
 					write_count++;
 				}
 				break;
 			case ARM_OP_MEM:
 				// registers appeared in memory references always being read
-				if ((op->mem.base != ARM_REG_INVALID) && !arr_exist(regs_read, read_count, op->mem.base)) {
+				if ((op->mem.base != ARM_REG_INVALID) && regs_bitset_add(read_bits, op->mem.base)) {
 					regs_read[read_count] = (uint16_t)op->mem.base;
 					read_count++;
 				}
-				if ((op->mem.index != ARM_REG_INVALID) && !arr_exist(regs_read, read_count, op->mem.index)) {
+				if ((op->mem.index != ARM_REG_INVALID) && regs_bitset_add(read_bits, op->mem.index)) {
 					regs_read[read_count] = (uint16_t)op->mem.index;
 					read_count++;
 				}
-				if ((arm->writeback) && (op->mem.base != ARM_REG_INVALID) && !arr_exist(regs_write, write_count, op->mem.base)) {
+				if ((arm->writeback) && (op->mem.base != ARM_REG_INVALID) && regs_bitset_add(write_bits, op->mem.base)) {
 					regs_write[write_count] = (uint16_t)op->mem.base;
 					write_count++;
 				}
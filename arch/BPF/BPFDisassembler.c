@@ -27,47 +27,27 @@ static uint32_t read_u32(cs_struct *ud, const uint8_t *code)
 		return ((uint32_t)read_u16(ud, code + 2) << 16) | read_u16(ud, code);
 }
 
-///< Malloc bpf_internal, also checks if code_len is large enough.
-static bpf_internal *alloc_bpf_internal(size_t code_len)
-{
-	bpf_internal *bpf;
-
-	if (code_len < 8)
-		return NULL;
-	bpf = cs_mem_malloc(sizeof(bpf_internal));
-	if (bpf == NULL)
-		return NULL;
-	/* default value */
-	bpf->insn_size = 8;
-	return bpf;
-}
-
 ///< Fetch a cBPF structure from code
-static bpf_internal* fetch_cbpf(cs_struct *ud, const uint8_t *code,
-		size_t code_len)
+static bool fetch_cbpf(cs_struct *ud, const uint8_t *code,
+		size_t code_len, bpf_internal *bpf)
 {
-	bpf_internal *bpf;
-
-	bpf = alloc_bpf_internal(code_len);
-	if (bpf == NULL)
-		return NULL;
+	if (code_len < 8)
+		return false;
 
 	bpf->op = read_u16(ud, code);
 	bpf->jt = code[2];
 	bpf->jf = code[3];
 	bpf->k = read_u32(ud, code + 4);
-	return bpf;
+	bpf->insn_size = 8;
+	return true;
 }
 
 ///< Fetch an eBPF structure from code
-static bpf_internal* fetch_ebpf(cs_struct *ud, const uint8_t *code,
-		size_t code_len)
+static bool fetch_ebpf(cs_struct *ud, const uint8_t *code,
+		size_t code_len, bpf_internal *bpf)
 {
-	bpf_internal *bpf;
-
-	bpf = alloc_bpf_internal(code_len);
-	if (bpf == NULL)
-		return NULL;
+	if (code_len < 8)
+		return false;
 
 	bpf->op = (uint16_t)code[0];
 	bpf->dst = code[1] & 0xf;
@@ -76,18 +56,17 @@ static bpf_internal* fetch_ebpf(cs_struct *ud, const uint8_t *code,
 	// eBPF has one 16-byte instruction: BPF_LD | BPF_DW | BPF_IMM,
 	// in this case imm is combined with the next block's imm.
 	if (bpf->op == (BPF_CLASS_LD | BPF_SIZE_DW | BPF_MODE_IMM)) {
-		if (code_len < 16) {
-			cs_mem_free(bpf);
-			return NULL;
-		}
+		if (code_len < 16)
+			return false;
 		bpf->k = read_u32(ud, code + 4) | (((uint64_t)read_u32(ud, code + 12)) << 32);
 		bpf->insn_size = 16;
 	}
 	else {
 		bpf->offset = read_u16(ud, code + 2);
 		bpf->k = read_u32(ud, code + 4);
+		bpf->insn_size = 8;
 	}
-	return bpf;
+	return true;
 }
 
 #define CHECK_READABLE_REG(ud, reg) do { \
@@ -441,22 +420,24 @@ bool BPF_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 		MCInst *instr, uint16_t *size, uint64_t address, void *info)
 {
 	cs_struct *cs;
-	bpf_internal *bpf;
+	bpf_internal bpf;
+	bool fetched;
+
+	// bpf_internal is only needed while decoding, so keep it on the stack
+	// rather than allocating it for each instruction
+	memset(&bpf, 0, sizeof(bpf));
 
 	cs = (cs_struct*)ud;
 	if (EBPF_MODE(cs))
-		bpf = fetch_ebpf(cs, code, code_len);
+		fetched = fetch_ebpf(cs, code, code_len, &bpf);
 	else
-		bpf = fetch_cbpf(cs, code, code_len);
-	if (bpf == NULL)
+		fetched = fetch_cbpf(cs, code, code_len, &bpf);
+	if (!fetched)
 		return false;
-	if (!getInstruction(cs, instr, bpf)) {
-		cs_mem_free(bpf);
+	if (!getInstruction(cs, instr, &bpf))
 		return false;
-	}
 
-	*size = bpf->insn_size;
-	cs_mem_free(bpf);
+	*size = bpf.insn_size;
 
 	return true;
 }
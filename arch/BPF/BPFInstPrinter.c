@@ -220,7 +220,7 @@ static void print_operand(MCInst *MI, struct SStream *O, const cs_bpf_op *op)
 		SStream_concat(O, "0x%" PRIx64, op->imm);
 		break;
 	case BPF_OP_OFF:
-		SStream_concat(O, "+0x%x", op->off);
+		SStream_concatHex(O, "+0x", (uint32_t)op->off);
 		break;
 	case BPF_OP_MEM:
 		SStream_concat(O, "[");
@@ -229,7 +229,7 @@ static void print_operand(MCInst *MI, struct SStream *O, const cs_bpf_op *op)
 		if (op->mem.disp != 0) {
 			if (op->mem.base != BPF_REG_INVALID)
 				SStream_concat(O, "+");
-			SStream_concat(O, "0x%x", op->mem.disp);
+			SStream_concatHex(O, "0x", (uint32_t)op->mem.disp);
 		}
 		if (op->mem.base == BPF_REG_INVALID && op->mem.disp == 0) // special case
 			SStream_concat(O, "0x0");
@@ -6,6 +6,7 @@
                     // alternatively #include "../../utils.h" like everyone else
 
 #include "EVMDisassembler.h"
+#include "EVMInstPrinter.h"
 #include "EVMMapping.h"
 
 static const short opcodes[256] = {
@@ -267,113 +268,156 @@ static const short opcodes[256] = {
 	EVM_INS_SUICIDE,
 };
 
-bool EVM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
-	MCInst *MI, uint16_t *size, uint64_t address, void *inst_info)
+// fill the detail of @insn, whose opcode is @opcode
+static void fill_detail(cs_struct *ud, cs_insn *insn, unsigned char opcode)
+{
+	memset(insn->detail, 0, offsetof(cs_detail, evm)+sizeof(cs_evm));
+	EVM_get_insn_id(ud, insn, opcode);
+
+	if (insn->detail->evm.pop) {
+		insn->detail->groups[insn->detail->groups_count] = EVM_GRP_STACK_READ;
+		insn->detail->groups_count++;
+	}
+
+	if (insn->detail->evm.push) {
+		insn->detail->groups[insn->detail->groups_count] = EVM_GRP_STACK_WRITE;
+		insn->detail->groups_count++;
+	}
+
+	// setup groups
+	switch(opcode) {
+		default:
+			break;
+		case EVM_INS_ADD:
+		case EVM_INS_MUL:
+		case EVM_INS_SUB:
+		case EVM_INS_DIV:
+		case EVM_INS_SDIV:
+		case EVM_INS_MOD:
+		case EVM_INS_SMOD:
+		case EVM_INS_ADDMOD:
+		case EVM_INS_MULMOD:
+		case EVM_INS_EXP:
+		case EVM_INS_SIGNEXTEND:
+			insn->detail->groups[insn->detail->groups_count] = EVM_GRP_MATH;
+			insn->detail->groups_count++;
+			break;
+
+		case EVM_INS_MSTORE:
+		case EVM_INS_MSTORE8:
+		case EVM_INS_CALLDATACOPY:
+		case EVM_INS_CODECOPY:
+		case EVM_INS_EXTCODECOPY:
+			insn->detail->groups[insn->detail->groups_count] = EVM_GRP_MEM_WRITE;
+			insn->detail->groups_count++;
+			break;
+
+		case EVM_INS_MLOAD:
+		case EVM_INS_CREATE:
+		case EVM_INS_CALL:
+		case EVM_INS_CALLCODE:
+		case EVM_INS_RETURN:
+		case EVM_INS_DELEGATECALL:
+		case EVM_INS_REVERT:
+			insn->detail->groups[insn->detail->groups_count] = EVM_GRP_MEM_READ;
+			insn->detail->groups_count++;
+			break;
+
+		case EVM_INS_SSTORE:
+			insn->detail->groups[insn->detail->groups_count] = EVM_GRP_STORE_WRITE;
+			insn->detail->groups_count++;
+			break;
+
+		case EVM_INS_SLOAD:
+			insn->detail->groups[insn->detail->groups_count] = EVM_GRP_STORE_READ;
+			insn->detail->groups_count++;
+			break;
+
+		case EVM_INS_JUMP:
+		case EVM_INS_JUMPI:
+			insn->detail->groups[insn->detail->groups_count] = EVM_GRP_JUMP;
+			insn->detail->groups_count++;
+			break;
+
+		case EVM_INS_STOP:
+		case EVM_INS_SUICIDE:
+			insn->detail->groups[insn->detail->groups_count] = EVM_GRP_HALT;
+			insn->detail->groups_count++;
+			break;
+
+	}
+}
+
+// return the length of the instruction at @code, or 0 if it is invalid
+static uint16_t insn_length(const uint8_t *code, size_t code_len)
 {
 	unsigned char opcode;
+	size_t size = 1;
 
 	if (code_len == 0)
-		return false;
+		return 0;
 
 	opcode = code[0];
 	if (opcodes[opcode] == -1) {
 		// invalid opcode
-		return false;
+		return 0;
+	}
+
+	// PUSHn is followed by n bytes of data
+	if (opcode >= EVM_INS_PUSH1 && opcode <= EVM_INS_PUSH32)
+		size += opcode - EVM_INS_PUSH1 + 1;
+
+	if (code_len < size) {
+		// not enough data
+		return 0;
 	}
 
+	return (uint16_t)size;
+}
+
+bool EVM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
+	MCInst *MI, uint16_t *size, uint64_t address, void *inst_info)
+{
+	unsigned char opcode;
+
+	*size = insn_length(code, code_len);
+	if (*size == 0)
+		return false;
+
 	// valid opcode
+	opcode = code[0];
 	MI->address = address;
 	MI->OpcodePub = MI->Opcode = opcode;
 
-	if (opcode >= EVM_INS_PUSH1 && opcode <= EVM_INS_PUSH32) {
-		unsigned char len = (opcode - EVM_INS_PUSH1 + 1);
-		if (code_len < 1 + len) {
-			// not enough data
-			return false;
-		}
-
-		*size = 1 + len;
-		memcpy(MI->evm_data, code + 1, len);
-	} else
-		*size = 1;
-
-	if (MI->flat_insn->detail) {
-		memset(MI->flat_insn->detail, 0, offsetof(cs_detail, evm)+sizeof(cs_evm));
-		EVM_get_insn_id((cs_struct *)ud, MI->flat_insn, opcode);
-
-		if (MI->flat_insn->detail->evm.pop) {
-			MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = EVM_GRP_STACK_READ;
-			MI->flat_insn->detail->groups_count++;
-		}
-
-		if (MI->flat_insn->detail->evm.push) {
-			MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = EVM_GRP_STACK_WRITE;
-			MI->flat_insn->detail->groups_count++;
-		}
-
-		// setup groups
-		switch(opcode) {
-			default:
-				break;
-			case EVM_INS_ADD:
-			case EVM_INS_MUL:
-			case EVM_INS_SUB:
-			case EVM_INS_DIV:
-			case EVM_INS_SDIV:
-			case EVM_INS_MOD:
-			case EVM_INS_SMOD:
-			case EVM_INS_ADDMOD:
-			case EVM_INS_MULMOD:
-			case EVM_INS_EXP:
-			case EVM_INS_SIGNEXTEND:
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = EVM_GRP_MATH;
-				MI->flat_insn->detail->groups_count++;
-				break;
-
-			case EVM_INS_MSTORE:
-			case EVM_INS_MSTORE8:
-			case EVM_INS_CALLDATACOPY:
-			case EVM_INS_CODECOPY:
-			case EVM_INS_EXTCODECOPY:
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = EVM_GRP_MEM_WRITE;
-				MI->flat_insn->detail->groups_count++;
-				break;
-
-			case EVM_INS_MLOAD:
-			case EVM_INS_CREATE:
-			case EVM_INS_CALL:
-			case EVM_INS_CALLCODE:
-			case EVM_INS_RETURN:
-			case EVM_INS_DELEGATECALL:
-			case EVM_INS_REVERT:
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = EVM_GRP_MEM_READ;
-				MI->flat_insn->detail->groups_count++;
-				break;
-
-			case EVM_INS_SSTORE:
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = EVM_GRP_STORE_WRITE;
-				MI->flat_insn->detail->groups_count++;
-				break;
-
-			case EVM_INS_SLOAD:
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = EVM_GRP_STORE_READ;
-				MI->flat_insn->detail->groups_count++;
-				break;
-
-			case EVM_INS_JUMP:
-			case EVM_INS_JUMPI:
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = EVM_GRP_JUMP;
-				MI->flat_insn->detail->groups_count++;
-				break;
-
-			case EVM_INS_STOP:
-			case EVM_INS_SUICIDE:
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = EVM_GRP_HALT;
-				MI->flat_insn->detail->groups_count++;
-				break;
-
-		}
-	}
+	if (*size > 1)
+		memcpy(MI->evm_data, code + 1, *size - 1);
+
+	if (MI->flat_insn->detail)
+		fill_detail((cs_struct *)ud, MI->flat_insn, opcode);
 
 	return true;
 }
+
+bool EVM_disasmInsn(cs_struct *ud, const uint8_t *code, size_t code_len,
+		cs_insn *insn, uint16_t *size)
+{
+	*size = insn_length(code, code_len);
+	if (*size == 0)
+		return false;
+
+	insn->id = code[0];
+
+	if (insn->detail)
+		fill_detail(ud, insn, code[0]);
+
+	if (!ud->no_text)
+		EVM_printInsn(insn, code + 1);
+
+	return true;
+}
+
+uint16_t EVM_getInsnLength(csh ud, const uint8_t *code, size_t code_len,
+		uint64_t address)
+{
+	return insn_length(code, code_len);
+}
@@ -5,8 +5,15 @@
 #define CS_EVMDISASSEMBLER_H
 
 #include "../../MCInst.h"
+#include "../../cs_priv.h"
 
 bool EVM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 		MCInst *instr, uint16_t *size, uint64_t address, void *info);
 
+uint16_t EVM_getInsnLength(csh ud, const uint8_t *code, size_t code_len,
+		uint64_t address);
+
+bool EVM_disasmInsn(cs_struct *ud, const uint8_t *code, size_t code_len,
+		cs_insn *insn, uint16_t *size);
+
 #endif
@@ -1,6 +1,8 @@
 /* Capstone Disassembly Engine */
 /* By Nguyen Anh Quynh, 2018 */
 
+#include <string.h>
+
 #include "EVMInstPrinter.h"
 #include "EVMMapping.h"
 
@@ -18,3 +20,24 @@ void EVM_printInst(MCInst *MI, struct SStream *O, void *PrinterInfo)
 		}
 	}
 }
+
+// render the text of @insn, whose PUSH data is @data, straight into its
+// mnemonic & op_str, like EVM_printInst() then fill_insn() would do
+void EVM_printInsn(cs_insn *insn, const unsigned char *data)
+{
+#ifndef CAPSTONE_DIET
+	static const char hex[] = "0123456789abcdef";
+	const char *name = EVM_insn_name(0, insn->id);
+	unsigned int i;
+
+	strcpy(insn->mnemonic, name);
+
+	if (insn->id >= EVM_INS_PUSH1 && insn->id <= EVM_INS_PUSH32) {
+		for (i = 0; i < insn->id - EVM_INS_PUSH1 + 1; i++) {
+			insn->op_str[2 * i] = hex[data[i] >> 4];
+			insn->op_str[2 * i + 1] = hex[data[i] & 0xf];
+		}
+		insn->op_str[2 * i] = '\0';
+	}
+#endif
+}
@@ -14,4 +14,6 @@ struct SStream;
 
 void EVM_printInst(MCInst *MI, struct SStream *O, void *Info);
 
+void EVM_printInsn(cs_insn *insn, const unsigned char *data);
+
 #endif
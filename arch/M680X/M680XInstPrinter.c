@@ -129,6 +129,15 @@ static uint32_t get_unsigned(int32_t value, int byte_size)
 	}
 }
 
+// print signed @value in decimal
+static void printSigned(SStream *O, int32_t value)
+{
+	if (value < 0)
+		SStream_concatDec(O, "-", 0 - (uint32_t)value);
+	else
+		SStream_concatDec(O, "", (uint32_t)value);
+}
+
 static void printIncDec(bool isPost, SStream *O, m680x_info *info,
 	cs_m680x_op *op)
 {
@@ -160,15 +169,15 @@ static void printOperand(MCInst *MI, SStream *O, m680x_info *info,
 		break;
 
 	case M680X_OP_CONSTANT:
-		SStream_concat(O, "%u", op->const_val);
+		SStream_concatDec(O, "", (uint32_t)op->const_val);
 		break;
 
 	case M680X_OP_IMMEDIATE:
 		if (MI->csh->imm_unsigned)
-			SStream_concat(O, "#%u",
+			SStream_concatDec(O, "#",
 				get_unsigned(op->imm, op->size));
 		else
-			SStream_concat(O, "#%d", op->imm);
+			printInt32BangDec(O, op->imm);
 
 		break;
 
@@ -180,16 +189,16 @@ static void printOperand(MCInst *MI, SStream *O, m680x_info *info,
 			printRegName(MI->csh, O, op->idx.offset_reg);
 		else if (op->idx.offset_bits > 0) {
 			if (op->idx.base_reg == M680X_REG_PC)
-				SStream_concat(O, "$%04x", op->idx.offset_addr);
+				SStream_concatHexWidth(O, "$", op->idx.offset_addr, 4);
 			else
-				SStream_concat(O, "%d", op->idx.offset);
+				printSigned(O, op->idx.offset);
 		}
 		else if (op->idx.inc_dec != 0 &&
 			info->cpu_type == M680X_CPU_TYPE_CPU12)
-			SStream_concat(O, "%d", abs(op->idx.inc_dec));
+			SStream_concatDec(O, "", abs(op->idx.inc_dec));
 
 		if (!(op->idx.flags & M680X_IDX_NO_COMMA))
-			SStream_concat(O, ", ");
+			SStream_concat0(O, ", ");
 
 		printIncDec(false, O, info, op);
 
@@ -197,32 +206,34 @@ static void printOperand(MCInst *MI, SStream *O, m680x_info *info,
 
 		if (op->idx.base_reg == M680X_REG_PC &&
 			(op->idx.offset_bits > 0))
-			SStream_concat(O, "r");
+			SStream_concat0(O, "r");
 
 		printIncDec(true, O, info, op);
 
 		if (op->idx.flags & M680X_IDX_INDIRECT)
-			SStream_concat(O, "]");
+			SStream_concat0(O, "]");
 
 		break;
 
 	case M680X_OP_RELATIVE:
-		SStream_concat(O, "$%04x", op->rel.address);
+		SStream_concatHexWidth(O, "$", op->rel.address, 4);
 		break;
 
 	case M680X_OP_DIRECT:
-		SStream_concat(O, "$%02x", op->direct_addr);
+		SStream_concatHexWidth(O, "$", op->direct_addr, 2);
 		break;
 
 	case M680X_OP_EXTENDED:
-		if (op->ext.indirect)
-			SStream_concat(O, "[$%04x]", op->ext.address);
+		if (op->ext.indirect) {
+			SStream_concatHexWidth(O, "[$", op->ext.address, 4);
+			SStream_concat0(O, "]");
+		}
 		else {
 			if (op->ext.address < 256) {
-				SStream_concat(O, ">$%04x", op->ext.address);
+				SStream_concatHexWidth(O, ">$", op->ext.address, 4);
 			}
 			else {
-				SStream_concat(O, "$%04x", op->ext.address);
+				SStream_concatHexWidth(O, "$", op->ext.address, 4);
 			}
 		}
 
@@ -270,7 +281,7 @@ void M680X_printInst(MCInst *MI, SStream *O, void *PrinterInfo)
 
 	if (info->insn == M680X_INS_INVLD || info->insn == M680X_INS_ILLGL) {
 		if (m680x->op_count)
-			SStream_concat(O, "fcb $%02x", m680x->operands[0].imm);
+			SStream_concatHexWidth(O, "fcb $", (uint32_t)m680x->operands[0].imm, 2);
 		else
 			SStream_concat0(O, "fcb $<unknown>");
 
@@ -147,15 +147,19 @@ static void printAddressingMode(SStream* O, unsigned int pc, const cs_m68k* inst
 			}
 			break;
 
-		case M68K_AM_REG_DIRECT_DATA: SStream_concat(O, "d%d", (op->reg - M68K_REG_D0)); break;
-		case M68K_AM_REG_DIRECT_ADDR: SStream_concat(O, "a%d", (op->reg - M68K_REG_A0)); break;
-		case M68K_AM_REGI_ADDR: SStream_concat(O, "(a%d)", (op->reg - M68K_REG_A0)); break;
-		case M68K_AM_REGI_ADDR_POST_INC: SStream_concat(O, "(a%d)+", (op->reg - M68K_REG_A0)); break;
-		case M68K_AM_REGI_ADDR_PRE_DEC: SStream_concat(O, "-(a%d)", (op->reg - M68K_REG_A0)); break;
-		case M68K_AM_REGI_ADDR_DISP: SStream_concat(O, "%s$%x(a%d)", op->mem.disp < 0 ? "-" : "", abs(op->mem.disp), (op->mem.base_reg - M68K_REG_A0)); break;
-		case M68K_AM_PCI_DISP: SStream_concat(O, "$%x(pc)", pc + 2 + op->mem.disp); break;
-		case M68K_AM_ABSOLUTE_DATA_SHORT: SStream_concat(O, "$%x.w", op->imm); break;
-		case M68K_AM_ABSOLUTE_DATA_LONG: SStream_concat(O, "$%x.l", op->imm); break;
+		case M68K_AM_REG_DIRECT_DATA: SStream_concatDec(O, "d", op->reg - M68K_REG_D0); break;
+		case M68K_AM_REG_DIRECT_ADDR: SStream_concatDec(O, "a", op->reg - M68K_REG_A0); break;
+		case M68K_AM_REGI_ADDR: SStream_concatDec(O, "(a", op->reg - M68K_REG_A0); SStream_concat0(O, ")"); break;
+		case M68K_AM_REGI_ADDR_POST_INC: SStream_concatDec(O, "(a", op->reg - M68K_REG_A0); SStream_concat0(O, ")+"); break;
+		case M68K_AM_REGI_ADDR_PRE_DEC: SStream_concatDec(O, "-(a", op->reg - M68K_REG_A0); SStream_concat0(O, ")"); break;
+		case M68K_AM_REGI_ADDR_DISP:
+			SStream_concatHex(O, op->mem.disp < 0 ? "-$" : "$", abs(op->mem.disp));
+			SStream_concatDec(O, "(a", op->mem.base_reg - M68K_REG_A0);
+			SStream_concat0(O, ")");
+			break;
+		case M68K_AM_PCI_DISP: SStream_concatHex(O, "$", (uint32_t)(pc + 2 + op->mem.disp)); SStream_concat0(O, "(pc)"); break;
+		case M68K_AM_ABSOLUTE_DATA_SHORT: SStream_concatHex(O, "$", (uint32_t)op->imm); SStream_concat0(O, ".w"); break;
+		case M68K_AM_ABSOLUTE_DATA_LONG: SStream_concatHex(O, "$", (uint32_t)op->imm); SStream_concat0(O, ".l"); break;
 		case M68K_AM_IMMEDIATE:
 			 if (inst->op_size.type == M68K_SIZE_TYPE_FPU) {
 #if defined(_KERNEL_MODE)
@@ -172,22 +176,24 @@ static void printAddressingMode(SStream* O, unsigned int pc, const cs_m68k* inst
 				 break;
 #endif
 			 }
-			 SStream_concat(O, "#$%x", op->imm);
+			 SStream_concatHex(O, "#$", (uint32_t)op->imm);
 			 break;
 		case M68K_AM_PCI_INDEX_8_BIT_DISP:
-			SStream_concat(O, "$%x(pc,%s%s.%c)", pc + 2 + op->mem.disp, s_spacing, getRegName(op->mem.index_reg), op->mem.index_size ? 'l' : 'w');
+			SStream_concatHex(O, "$", (uint32_t)(pc + 2 + op->mem.disp));
+			SStream_concat(O, "(pc,%s%s.%c)", s_spacing, getRegName(op->mem.index_reg), op->mem.index_size ? 'l' : 'w');
 			break;
 		case M68K_AM_AREGI_INDEX_8_BIT_DISP:
-			SStream_concat(O, "%s$%x(%s,%s%s.%c)", op->mem.disp < 0 ? "-" : "", abs(op->mem.disp), getRegName(op->mem.base_reg), s_spacing, getRegName(op->mem.index_reg), op->mem.index_size ? 'l' : 'w');
+			SStream_concatHex(O, op->mem.disp < 0 ? "-$" : "$", abs(op->mem.disp));
+			SStream_concat(O, "(%s,%s%s.%c)", getRegName(op->mem.base_reg), s_spacing, getRegName(op->mem.index_reg), op->mem.index_size ? 'l' : 'w');
 			break;
 		case M68K_AM_PCI_INDEX_BASE_DISP:
 		case M68K_AM_AREGI_INDEX_BASE_DISP:
 
 			if (op->address_mode == M68K_AM_PCI_INDEX_BASE_DISP) {
-				SStream_concat(O, "$%x", pc + 2 + op->mem.in_disp);
+				SStream_concatHex(O, "$", (uint32_t)(pc + 2 + op->mem.in_disp));
 			} else {
 				if (op->mem.in_disp > 0)
-					SStream_concat(O, "$%x", op->mem.in_disp);
+					SStream_concatHex(O, "$", op->mem.in_disp);
 			}
 
 			SStream_concat0(O, "(");
@@ -195,15 +201,18 @@ static void printAddressingMode(SStream* O, unsigned int pc, const cs_m68k* inst
 			if (op->address_mode == M68K_AM_PCI_INDEX_BASE_DISP) {
 			    SStream_concat(O, "pc,%s.%c", getRegName(op->mem.index_reg), op->mem.index_size ? 'l' : 'w');
 			} else {
-				if (op->mem.base_reg != M68K_REG_INVALID)
-					SStream_concat(O, "a%d,%s", op->mem.base_reg - M68K_REG_A0, s_spacing);
+				if (op->mem.base_reg != M68K_REG_INVALID) {
+					SStream_concatDec(O, "a", op->mem.base_reg - M68K_REG_A0);
+					SStream_concat(O, ",%s", s_spacing);
+				}
 				SStream_concat(O, "%s.%c", getRegName(op->mem.index_reg), op->mem.index_size ? 'l' : 'w');
 			}
 
-			if (op->mem.scale > 0)
-			    SStream_concat(O, "%s*%s%d)", s_spacing, s_spacing, op->mem.scale);
-			else
-			    SStream_concat0(O, ")");
+			if (op->mem.scale > 0) {
+			    SStream_concat(O, "%s*%s", s_spacing, s_spacing);
+			    SStream_concatDec(O, "", op->mem.scale);
+			}
+			SStream_concat0(O, ")");
 			break;
 			// It's ok to just use PCMI here as is as we set base_reg to PC in the disassembler. While this is not strictly correct it makes the code
 			// easier and that is what actually happens when the code is executed anyway.
@@ -215,10 +224,10 @@ static void printAddressingMode(SStream* O, unsigned int pc, const cs_m68k* inst
 			SStream_concat0(O, "([");
 
 			if (op->address_mode == M68K_AM_PC_MEMI_POST_INDEX || op->address_mode == M68K_AM_PC_MEMI_PRE_INDEX) {
-				SStream_concat(O, "$%x", pc + 2 + op->mem.in_disp);
+				SStream_concatHex(O, "$", (uint32_t)(pc + 2 + op->mem.in_disp));
 			} else {
 				if (op->mem.in_disp > 0)
-					SStream_concat(O, "$%x", op->mem.in_disp);
+					SStream_concatHex(O, "$", op->mem.in_disp);
 			}
 
 			if (op->mem.base_reg != M68K_REG_INVALID) {
@@ -234,25 +243,32 @@ static void printAddressingMode(SStream* O, unsigned int pc, const cs_m68k* inst
 			if (op->mem.index_reg != M68K_REG_INVALID)
 			    SStream_concat(O, ",%s%s.%c", s_spacing, getRegName(op->mem.index_reg), op->mem.index_size ? 'l' : 'w');
 
-			if (op->mem.scale > 0)
-			    SStream_concat(O, "%s*%s%d", s_spacing, s_spacing, op->mem.scale);
+			if (op->mem.scale > 0) {
+			    SStream_concat(O, "%s*%s", s_spacing, s_spacing);
+			    SStream_concatDec(O, "", op->mem.scale);
+			}
 
 			if (op->address_mode == M68K_AM_MEMI_PRE_INDEX || op->address_mode == M68K_AM_PC_MEMI_PRE_INDEX)
 			    SStream_concat0(O, "]");
 
-			if (op->mem.out_disp > 0)
-			    SStream_concat(O, ",%s$%x", s_spacing, op->mem.out_disp);
+			if (op->mem.out_disp > 0) {
+			    SStream_concat(O, ",%s", s_spacing);
+			    SStream_concatHex(O, "$", op->mem.out_disp);
+			}
 
 			SStream_concat0(O, ")");
 			break;
 		case M68K_AM_BRANCH_DISPLACEMENT:
-			SStream_concat(O, "$%x", pc + 2 + op->br_disp.disp);
+			SStream_concatHex(O, "$", (uint32_t)(pc + 2 + op->br_disp.disp));
 		default:
 			break;
 	}
 
-	if (op->mem.bitfield)
-		SStream_concat(O, "{%d:%d}", op->mem.offset, op->mem.width);
+	if (op->mem.bitfield) {
+		SStream_concatDec(O, "{", op->mem.offset);
+		SStream_concatDec(O, ":", op->mem.width);
+		SStream_concat0(O, "}");
+	}
 }
 #endif
 
@@ -287,7 +303,7 @@ void M68K_printInst(MCInst* MI, SStream* O, void* PrinterInfo)
 
 	if (MI->Opcode == M68K_INS_INVALID) {
 		if (ext->op_count)
-			SStream_concat(O, "dc.w $%x", ext->operands[0].imm);
+			SStream_concatHex(O, "dc.w $", (uint32_t)ext->operands[0].imm);
 		else
 			SStream_concat(O, "dc.w $<unknown>");
 		return;
@@ -362,6 +378,9 @@ const char* M68K_insn_name(csh handle, unsigned int id)
 #ifdef CAPSTONE_DIET
 	return NULL;
 #else
+	if (id >= ARR_SIZE(s_instruction_names))
+		return NULL;
+
 	return s_instruction_names[id];
 #endif
 }
@@ -272,6 +272,18 @@ static void fillDetails(MCInst *MI, struct OpInfo opinfo, int cpu_type)
 }
 #endif
 
+#ifndef CAPSTONE_DIET
+// print @before, then @value in hex with @prefix & at least @width digits,
+// then @after
+static void printHex(SStream *O, const char *before, const char *prefix,
+		uint64_t value, unsigned int width, const char *after)
+{
+	SStream_concat0(O, before);
+	SStream_concatHexWidth(O, prefix, value, width);
+	SStream_concat0(O, after);
+}
+#endif
+
 void MOS65XX_printInst(MCInst *MI, struct SStream *O, void *PrinterInfo)
 {
 #ifndef CAPSTONE_DIET
@@ -296,7 +308,7 @@ void MOS65XX_printInst(MCInst *MI, struct SStream *O, void *PrinterInfo)
 		case MOS65XX_INS_BBS:
 		case MOS65XX_INS_RMB:
 		case MOS65XX_INS_SMB:
-			SStream_concat(O, "%d", (opcode >> 4) & 0x07);
+			SStream_concatDec(O, "", (opcode >> 4) & 0x07);
 			break;
 		default:
 			break;
@@ -318,13 +330,13 @@ void MOS65XX_printInst(MCInst *MI, struct SStream *O, void *PrinterInfo)
 
 		case MOS65XX_AM_IMM:
 			if (MI->imm_size == 1)
-				SStream_concat(O, " #%s%02x", prefix, value);
+				printHex(O, " #", prefix, value, 2, "");
 			else
-				SStream_concat(O, " #%s%04x", prefix, value);
+				printHex(O, " #", prefix, value, 4, "");
 			break;
 
 		case MOS65XX_AM_ZP:
-			SStream_concat(O, " %s%02x", prefix, value);
+			printHex(O, " ", prefix, value, 2, "");
 			break;
 
 		case MOS65XX_AM_ABS:
@@ -371,35 +383,35 @@ void MOS65XX_printInst(MCInst *MI, struct SStream *O, void *PrinterInfo)
 		case MOS65XX_AM_INDY:
 			SStream_concat(O, " ($0x%02x), y", value);
 =======
-			SStream_concat(O, " %s%04x", prefix, value);
+			printHex(O, " ", prefix, value, 4, "");
 			break;
 
 		case MOS65XX_AM_ABS_LONG_X:
-			SStream_concat(O, " %s%06x, x", prefix, value);
+			printHex(O, " ", prefix, value, 6, ", x");
 			break;
 
 		case MOS65XX_AM_INT:
-			SStream_concat(O, " %s%02x", prefix, value);
+			printHex(O, " ", prefix, value, 2, "");
 			break;
 
 		case MOS65XX_AM_ABS_X:
-			SStream_concat(O, " %s%04x, x", prefix, value);
+			printHex(O, " ", prefix, value, 4, ", x");
 			break;
 
 		case MOS65XX_AM_ABS_Y:
-			SStream_concat(O, " %s%04x, y", prefix, value);
+			printHex(O, " ", prefix, value, 4, ", y");
 			break;
 
 		case MOS65XX_AM_ABS_LONG:
-			SStream_concat(O, " %s%06x", prefix, value);
+			printHex(O, " ", prefix, value, 6, "");
 			break;
 
 		case MOS65XX_AM_ZP_X:
-			SStream_concat(O, " %s%02x, x", prefix, value);
+			printHex(O, " ", prefix, value, 2, ", x");
 			break;
 
 		case MOS65XX_AM_ZP_Y:
-			SStream_concat(O, " %s%02x, y", prefix, value);
+			printHex(O, " ", prefix, value, 2, ", y");
 			break;
 
 		case MOS65XX_AM_REL:
@@ -408,63 +420,60 @@ void MOS65XX_printInst(MCInst *MI, struct SStream *O, void *PrinterInfo)
 			else
 				value = 3 + (signed short)value;
 
-			SStream_concat(O, " %s%04x", prefix, 
-				(MI->address + value) & 0xffff);
+			printHex(O, " ", prefix, (MI->address + value) & 0xffff, 4, "");
 			break;
 
 		case MOS65XX_AM_ABS_IND:
-			SStream_concat(O, " (%s%04x)", prefix, value);
+			printHex(O, " (", prefix, value, 4, ")");
 			break;
 
 		case MOS65XX_AM_ABS_X_IND:
-			SStream_concat(O, " (%s%04x, x)", prefix, value);
+			printHex(O, " (", prefix, value, 4, ", x)");
 			break;
 
 		case MOS65XX_AM_ABS_IND_LONG:
-			SStream_concat(O, " [%s%04x]", prefix, value);
+			printHex(O, " [", prefix, value, 4, "]");
 			break;
 
 		case MOS65XX_AM_ZP_IND:
-			SStream_concat(O, " (%s%02x)", prefix, value);
+			printHex(O, " (", prefix, value, 2, ")");
 			break;
 
 		case MOS65XX_AM_ZP_X_IND:
-			SStream_concat(O, " (%s%02x, x)", prefix, value);
+			printHex(O, " (", prefix, value, 2, ", x)");
 			break;
 
 		case MOS65XX_AM_ZP_IND_Y:
-			SStream_concat(O, " (%s%02x), y", prefix, value);
+			printHex(O, " (", prefix, value, 2, "), y");
 			break;
 
 		case MOS65XX_AM_ZP_IND_LONG:
-			SStream_concat(O, " [%s%02x]", prefix, value);
+			printHex(O, " [", prefix, value, 2, "]");
 			break;
 
 		case MOS65XX_AM_ZP_IND_LONG_Y:
-			SStream_concat(O, " [%s%02x], y", prefix, value);
+			printHex(O, " [", prefix, value, 2, "], y");
 			break;
 
 		case MOS65XX_AM_SR:
-			SStream_concat(O, " %s%02x, s", prefix, value);
+			printHex(O, " ", prefix, value, 2, ", s");
 >>>>>>> 00f5057fad5fbb623c9d7aa4e3e00e499954556e
 			break;
 
 		case MOS65XX_AM_SR_IND_Y:
-			SStream_concat(O, " (%s%02x, s), y", prefix, value);
+			printHex(O, " (", prefix, value, 2, ", s), y");
 			break;
 
 		case MOS65XX_AM_BLOCK:
-			SStream_concat(O, " %s%02x, %s%02x",
-				prefix, MI->Operands[0].ImmVal,
-				prefix, MI->Operands[1].ImmVal);
+			printHex(O, " ", prefix, (uint32_t)MI->Operands[0].ImmVal, 2, ", ");
+			printHex(O, "", prefix, (uint32_t)MI->Operands[1].ImmVal, 2, "");
 			break;
 
 		case MOS65XX_AM_ZP_REL:
 			value =	3 + (signed char)MI->Operands[1].ImmVal;
 			/* BBR0, zp, rel  and BBS0, zp, rel */
-			SStream_concat(O, " %s%02x, %s%04x",
-				prefix, MI->Operands[0].ImmVal,
-				prefix, (MI->address + value) & 0xffff);
+			printHex(O, " ", prefix, (uint32_t)MI->Operands[0].ImmVal, 2, ", ");
+			printHex(O, "", prefix, (MI->address + value) & 0xffff, 4, "");
 			break;
 
 	}
@@ -31,8 +31,8 @@
 #include "MipsInstPrinter.h"
 
 static void printUnsignedImm(MCInst *MI, int opNum, SStream *O);
-static char *printAliasInstr(MCInst *MI, SStream *O, void *info);
-static char *printAlias(MCInst *MI, SStream *OS);
+static const char *printAliasInstr(MCInst *MI, SStream *O, void *info);
+static const char *printAlias(MCInst *MI, SStream *OS);
 
 // These enumeration declarations were originally in MipsInstrInfo.h but
 // had to be moved here to avoid circular dependencies between
@@ -154,7 +154,7 @@ static void printRegName(SStream *OS, unsigned RegNo)
 
 void Mips_printInst(MCInst *MI, SStream *O, void *info)
 {
-	char *mnem;
+	const char *mnem;
 
 	switch (MCInst_getOpcode(MI)) {
 		default: break;
@@ -166,19 +166,17 @@ void Mips_printInst(MCInst *MI, SStream *O, void *info)
 	}
 
 	// Try to print any aliases first.
+	// printAliasInstr() also sets the instruction ID of the alias
 	mnem = printAliasInstr(MI, O, info);
 	if (!mnem) {
 		mnem = printAlias(MI, O);
-		if (!mnem) {
+		if (mnem) {
+			// fixup instruction id due to the change in alias instruction
+			MCInst_setOpcodePub(MI, Mips_map_insn(mnem));
+		} else {
 			printInstruction(MI, O, NULL);
 		}
 	}
-
-	if (mnem) {
-		// fixup instruction id due to the change in alias instruction
-		MCInst_setOpcodePub(MI, Mips_map_insn(mnem));
-		cs_mem_free(mnem);
-	}
 }
 
 static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
@@ -244,9 +242,9 @@ static void printUnsignedImm8(MCInst *MI, int opNum, SStream *O)
 	if (MCOperand_isImm(MO)) {
 		uint8_t imm = (uint8_t)MCOperand_getImm(MO);
 		if (imm > HEX_THRESHOLD)
-			SStream_concat(O, "0x%x", imm);
+			SStream_concatHex(O, "0x", (uint32_t)imm);
 		else
-			SStream_concat(O, "%u", imm);
+			SStream_concatDec(O, "", (uint32_t)imm);
 		if (MI->csh->detail) {
 			MI->flat_insn->detail->mips.operands[MI->flat_insn->detail->mips.op_count].type = MIPS_OP_IMM;
 			MI->flat_insn->detail->mips.operands[MI->flat_insn->detail->mips.op_count].imm = imm;
@@ -305,29 +303,27 @@ static void printRegisterPair(MCInst *MI, int opNum, SStream *O)
 	printRegName(O, MCOperand_getReg(MCInst_getOperand(MI, opNum)));
 }
 
-static char *printAlias1(const char *Str, MCInst *MI, unsigned OpNo, SStream *OS)
+static const char *printAlias1(const char *Str, MCInst *MI, unsigned OpNo, SStream *OS)
 {
 	SStream_concat(OS, "%s\t", Str);
 	printOperand(MI, OpNo, OS);
-	return cs_strdup(Str);
+	return Str;
 }
 
-static char *printAlias2(const char *Str, MCInst *MI,
+static const char *printAlias2(const char *Str, MCInst *MI,
 		unsigned OpNo0, unsigned OpNo1, SStream *OS)
 {
-	char *tmp;
-
-	tmp = printAlias1(Str, MI, OpNo0, OS);
+	printAlias1(Str, MI, OpNo0, OS);
 	SStream_concat0(OS, ", ");
 	printOperand(MI, OpNo1, OS);
 
-	return tmp;
+	return Str;
 }
 
 #define GET_REGINFO_ENUM
 #include "MipsGenRegisterInfo.inc"
 
-static char *printAlias(MCInst *MI, SStream *OS)
+static const char *printAlias(MCInst *MI, SStream *OS)
 {
 	switch (MCInst_getOpcode(MI)) {
 		case Mips_BEQ:
@@ -227,20 +227,20 @@ void Mips_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
 {
 	unsigned int i;
 
-	i = insn_find(insns, ARR_SIZE(insns), id, &h->insn_cache);
+	i = insn_find(insns, ARR_SIZE(insns), id);
 	if (i != 0) {
 		insn->id = insns[i].mapid;
 
 		if (h->detail) {
 #ifndef CAPSTONE_DIET
 			memcpy(insn->detail->regs_read, insns[i].regs_use, sizeof(insns[i].regs_use));
-			insn->detail->regs_read_count = (uint8_t)count_positive(insns[i].regs_use);
+			insn->detail->regs_read_count = insns[i].regs_use_count;
 
 			memcpy(insn->detail->regs_write, insns[i].regs_mod, sizeof(insns[i].regs_mod));
-			insn->detail->regs_write_count = (uint8_t)count_positive(insns[i].regs_mod);
+			insn->detail->regs_write_count = insns[i].regs_mod_count;
 
 			memcpy(insn->detail->groups, insns[i].groups, sizeof(insns[i].groups));
-			insn->detail->groups_count = (uint8_t)count_positive8(insns[i].groups);
+			insn->detail->groups_count = insns[i].groups_count;
 
 			if (insns[i].branch || insns[i].indirect_branch) {
 				// this insn also belongs to JUMP group. add JUMP group
@@ -963,11 +963,12 @@ const char *Mips_group_name(csh handle, unsigned int id)
 // map instruction name to public instruction ID
 mips_reg Mips_map_insn(const char *name)
 {
-	// handle special alias first
-	unsigned int i;
+	static const name_map insn_name_index[] = {
+#include "MipsMappingInsnNameIndex.inc"
+	};
+	int i;
 
-	// NOTE: skip first NULL name in insn_name_maps
-	i = name2id(&insn_name_maps[1], ARR_SIZE(insn_name_maps) - 1, name);
+	i = name2id_sorted(insn_name_index, ARR_SIZE(insn_name_index), name);
 
 	return (i != -1)? i : MIPS_REG_INVALID;
 }
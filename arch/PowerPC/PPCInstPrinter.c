@@ -36,8 +36,8 @@ static const char *getRegisterName(unsigned RegNo);
 static void printOperand(MCInst *MI, unsigned OpNo, SStream *O);
 static void printInstruction(MCInst *MI, SStream *O);
 static void printAbsBranchOperand(MCInst *MI, unsigned OpNo, SStream *O);
-static char *printAliasInstr(MCInst *MI, SStream *OS, MCRegisterInfo *MRI);
-static char *printAliasBcc(MCInst *MI, SStream *OS, void *info);
+static const char *printAliasInstr(MCInst *MI, SStream *OS, MCRegisterInfo *MRI);
+static const char *printAliasBcc(MCInst *MI, SStream *OS, void *info, SStream *ss);
 static void printCustomAliasOperand(MCInst *MI, unsigned OpIdx,
 		unsigned PrintMethodIdx, SStream *OS);
 
@@ -76,17 +76,28 @@ static void set_mem_access(MCInst *MI, bool status)
 
 void PPC_post_printer(csh ud, cs_insn *insn, char *insn_asm, MCInst *mci)
 {
+	char mnem[CS_MNEMONIC_SIZE];
+	size_t len;
+
 	if (((cs_struct *)ud)->detail != CS_OPT_ON)
 		return;
 
+	// @insn->mnemonic is not filled yet (nor at all with CS_OPT_NO_TEXT),
+	// so extract the mnemonic from the printed assembly
+	len = strcspn(insn_asm, " \t");
+	if (len > sizeof(mnem) - 1)
+		len = sizeof(mnem) - 1;
+	memcpy(mnem, insn_asm, len);
+	mnem[len] = '\0';
+
 	// check if this insn has branch hint
-	if (strrchr(insn->mnemonic, '+') != NULL && !strstr(insn_asm, ".+")) {
+	if (strrchr(mnem, '+') != NULL && !strstr(insn_asm, ".+")) {
 		insn->detail->ppc.bh = PPC_BH_PLUS;
-	} else if (strrchr(insn->mnemonic, '-') != NULL) {
+	} else if (strrchr(mnem, '-') != NULL) {
 		insn->detail->ppc.bh = PPC_BH_MINUS;
 	}
 
-	if (strrchr(insn->mnemonic, '.') != NULL) {
+	if (strrchr(mnem, '.') != NULL) {
 		insn->detail->ppc.update_cr0 = true;
 	}
 }
@@ -137,17 +148,18 @@ static void add_CRxx(MCInst *MI, ppc_reg reg)
 	}
 }
 
-static char *printAliasBcc(MCInst *MI, SStream *OS, void *info)
+// print the alias of a conditional branch, building its template in @ss.
+// return the template, whose mnemonic is up to the first space, or NULL
+static const char *printAliasBcc(MCInst *MI, SStream *OS, void *info, SStream *ss)
 {
 #define GETREGCLASS_CONTAIN(_class, _reg) MCRegisterClass_contains(MCRegisterInfo_getRegClass(MRI, _class), MCOperand_getReg(MCInst_getOperand(MI, _reg)))
-	SStream ss;
 	const char *opCode;
-	char *tmp, *AsmMnem, *AsmOps, *c;
+	const char *AsmOps, *c;
 	int OpIdx, PrintMethodIdx;
 	int decCtr = false, needComma = false;
 	MCRegisterInfo *MRI = (MCRegisterInfo *)info;
 
-	SStream_Init(&ss);
+	SStream_Init(ss);
 
 	switch (MCInst_getOpcode(MI)) {
 		default: return NULL;
@@ -181,7 +193,7 @@ static char *printAliasBcc(MCInst *MI, SStream *OS, void *info)
 			MCOperand_isImm(MCInst_getOperand(MI, 0)) &&
 			(MCOperand_getImm(MCInst_getOperand(MI, 0)) >= 0) &&
 			(MCOperand_getImm(MCInst_getOperand(MI, 0)) <= 1)) {
-		SStream_concat(&ss, opCode, "dnzf");
+		SStream_concat(ss, opCode, "dnzf");
 		decCtr = true;
 	}
 
@@ -189,7 +201,7 @@ static char *printAliasBcc(MCInst *MI, SStream *OS, void *info)
 			MCOperand_isImm(MCInst_getOperand(MI, 0)) &&
 			(MCOperand_getImm(MCInst_getOperand(MI, 0)) >= 2) &&
 			(MCOperand_getImm(MCInst_getOperand(MI, 0)) <= 3)) {
-		SStream_concat(&ss, opCode, "dzf");
+		SStream_concat(ss, opCode, "dzf");
 		decCtr = true;
 	}
 
@@ -203,24 +215,24 @@ static char *printAliasBcc(MCInst *MI, SStream *OS, void *info)
 
 		switch(cr) {
 			case CREQ:
-				SStream_concat(&ss, opCode, "ne");
+				SStream_concat(ss, opCode, "ne");
 				break;
 			case CRGT:
-				SStream_concat(&ss, opCode, "le");
+				SStream_concat(ss, opCode, "le");
 				break;
 			case CRLT:
-				SStream_concat(&ss, opCode, "ge");
+				SStream_concat(ss, opCode, "ge");
 				break;
 			case CRUN:
-				SStream_concat(&ss, opCode, "ns");
+				SStream_concat(ss, opCode, "ns");
 				break;
 		}
 
 		if (MCOperand_getImm(MCInst_getOperand(MI, 0)) == 6)
-			SStream_concat0(&ss, "-");
+			SStream_concat0(ss, "-");
 
 		if (MCOperand_getImm(MCInst_getOperand(MI, 0)) == 7)
-			SStream_concat0(&ss, "+");
+			SStream_concat0(ss, "+");
 
 		decCtr = false;
 	}
@@ -229,7 +241,7 @@ static char *printAliasBcc(MCInst *MI, SStream *OS, void *info)
 			MCOperand_isImm(MCInst_getOperand(MI, 0)) &&
 			(MCOperand_getImm(MCInst_getOperand(MI, 0)) >= 8) &&
 			(MCOperand_getImm(MCInst_getOperand(MI, 0)) <= 9)) {
-		SStream_concat(&ss, opCode, "dnzt");
+		SStream_concat(ss, opCode, "dnzt");
 		decCtr = true;
 	}
 
@@ -237,7 +249,7 @@ static char *printAliasBcc(MCInst *MI, SStream *OS, void *info)
 			MCOperand_isImm(MCInst_getOperand(MI, 0)) &&
 			(MCOperand_getImm(MCInst_getOperand(MI, 0)) >= 10) &&
 			(MCOperand_getImm(MCInst_getOperand(MI, 0)) <= 11)) {
-		SStream_concat(&ss, opCode, "dzt");
+		SStream_concat(ss, opCode, "dzt");
 		decCtr = true;
 	}
 
@@ -251,24 +263,24 @@ static char *printAliasBcc(MCInst *MI, SStream *OS, void *info)
 
 		switch(cr) {
 			case CREQ:
-				SStream_concat(&ss, opCode, "eq");
+				SStream_concat(ss, opCode, "eq");
 				break;
 			case CRGT:
-				SStream_concat(&ss, opCode, "gt");
+				SStream_concat(ss, opCode, "gt");
 				break;
 			case CRLT:
-				SStream_concat(&ss, opCode, "lt");
+				SStream_concat(ss, opCode, "lt");
 				break;
 			case CRUN:
-				SStream_concat(&ss, opCode, "so");
+				SStream_concat(ss, opCode, "so");
 				break;
 		}
 
 		if (MCOperand_getImm(MCInst_getOperand(MI, 0)) == 14)
-			SStream_concat0(&ss, "-");
+			SStream_concat0(ss, "-");
 
 		if (MCOperand_getImm(MCInst_getOperand(MI, 0)) == 15)
-			SStream_concat0(&ss, "+");
+			SStream_concat0(ss, "+");
 
 		decCtr = false;
 	}
@@ -276,13 +288,13 @@ static char *printAliasBcc(MCInst *MI, SStream *OS, void *info)
 	if (MCInst_getNumOperands(MI) == 3 &&
 			MCOperand_isImm(MCInst_getOperand(MI, 0)) &&
 			((MCOperand_getImm(MCInst_getOperand(MI, 0)) & 0x12)== 16)) {
-		SStream_concat(&ss, opCode, "dnz");
+		SStream_concat(ss, opCode, "dnz");
 
 		if (MCOperand_getImm(MCInst_getOperand(MI, 0)) == 24)
-			SStream_concat0(&ss, "-");
+			SStream_concat0(ss, "-");
 
 		if (MCOperand_getImm(MCInst_getOperand(MI, 0)) == 25)
-			SStream_concat0(&ss, "+");
+			SStream_concat0(ss, "+");
 
 		needComma = false;
 	}
@@ -290,13 +302,13 @@ static char *printAliasBcc(MCInst *MI, SStream *OS, void *info)
 	if (MCInst_getNumOperands(MI) == 3 &&
 			MCOperand_isImm(MCInst_getOperand(MI, 0)) &&
 			((MCOperand_getImm(MCInst_getOperand(MI, 0)) & 0x12)== 18)) {
-		SStream_concat(&ss, opCode, "dz");
+		SStream_concat(ss, opCode, "dz");
 
 		if (MCOperand_getImm(MCInst_getOperand(MI, 0)) == 26)
-			SStream_concat0(&ss, "-");
+			SStream_concat0(ss, "-");
 
 		if (MCOperand_getImm(MCInst_getOperand(MI, 0)) == 27)
-			SStream_concat0(&ss, "+");
+			SStream_concat0(ss, "+");
 
 		needComma = false;
 	}
@@ -310,34 +322,34 @@ static char *printAliasBcc(MCInst *MI, SStream *OS, void *info)
 		if (decCtr) {
 			int cd;
 			needComma = true;
-			SStream_concat0(&ss, " ");
+			SStream_concat0(ss, " ");
 
 			if (cr > PPC_CR0) {
-				SStream_concat(&ss, "4*cr%d+", cr - PPC_CR0);
+				SStream_concat(ss, "4*cr%d+", cr - PPC_CR0);
 			}
 
 			cd = getBICRCond(MCOperand_getReg(MCInst_getOperand(MI, 1)));
 			switch(cd) {
 				case CREQ:
-					SStream_concat0(&ss, "eq");
+					SStream_concat0(ss, "eq");
 					if (cr <= PPC_CR0)
 						add_CRxx(MI, PPC_REG_CR0EQ);
 					op_addBC(MI, PPC_BC_EQ);
 					break;
 				case CRGT:
-					SStream_concat0(&ss, "gt");
+					SStream_concat0(ss, "gt");
 					if (cr <= PPC_CR0)
 						add_CRxx(MI, PPC_REG_CR0GT);
 					op_addBC(MI, PPC_BC_GT);
 					break;
 				case CRLT:
-					SStream_concat0(&ss, "lt");
+					SStream_concat0(ss, "lt");
 					if (cr <= PPC_CR0)
 						add_CRxx(MI, PPC_REG_CR0LT);
 					op_addBC(MI, PPC_BC_LT);
 					break;
 				case CRUN:
-					SStream_concat0(&ss, "so");
+					SStream_concat0(ss, "so");
 					if (cr <= PPC_CR0)
 						add_CRxx(MI, PPC_REG_CR0UN);
 					op_addBC(MI, PPC_BC_SO);
@@ -354,7 +366,7 @@ static char *printAliasBcc(MCInst *MI, SStream *OS, void *info)
 		} else {
 			if (cr > PPC_CR0) {
 				needComma = true;
-				SStream_concat(&ss, " cr%d", cr - PPC_CR0);
+				SStream_concat(ss, " cr%d", cr - PPC_CR0);
 				op_addReg(MI, PPC_REG_CR0 + cr - PPC_CR0);
 			}
 		}
@@ -363,22 +375,19 @@ static char *printAliasBcc(MCInst *MI, SStream *OS, void *info)
 	if (MCOperand_isImm(MCInst_getOperand(MI, 2)) &&
 			MCOperand_getImm(MCInst_getOperand(MI, 2)) != 0) {
 		if (needComma)
-			SStream_concat0(&ss, ",");
+			SStream_concat0(ss, ",");
 
-		SStream_concat0(&ss, " $\xFF\x03\x01");
+		SStream_concat0(ss, " $\xFF\x03\x01");
 	}
 
-	tmp = cs_strdup(ss.buffer);
-	AsmMnem = tmp;
-	for(AsmOps = tmp; *AsmOps; AsmOps++) {
-		if (*AsmOps == ' ' || *AsmOps == '\t') {
-			*AsmOps = '\0';
-			AsmOps++;
+	for(AsmOps = ss->buffer; *AsmOps; AsmOps++) {
+		if (*AsmOps == ' ' || *AsmOps == '\t')
 			break;
-		}
 	}
 
-	SStream_concat0(OS, AsmMnem);
+	SStream_concatLen(OS, ss->buffer, AsmOps - ss->buffer);
+	if (*AsmOps)
+		AsmOps++;
 	if (*AsmOps) {
 		SStream_concat0(OS, "\t");
 		for (c = AsmOps; *c; c++) {
@@ -398,7 +407,7 @@ static char *printAliasBcc(MCInst *MI, SStream *OS, void *info)
 		}
 	}
 
-	return tmp;
+	return ss->buffer;
 }
 
 static bool isBOCTRBranch(unsigned int op)
@@ -408,7 +417,11 @@ static bool isBOCTRBranch(unsigned int op)
 
 void PPC_printInst(MCInst *MI, SStream *O, void *Info)
 {
-	char *mnem;
+	const char *alias;
+	char mnem[CS_MNEMONIC_SIZE];
+	size_t len;
+	SStream ss;	// template of printAliasBcc()
+	bool alias_bcc = false;
 	unsigned int opcode = MCInst_getOpcode(MI);
 
 	// printf("opcode = %u\n", opcode);
@@ -439,9 +452,9 @@ void PPC_printInst(MCInst *MI, SStream *O, void *Info)
 			printOperand(MI, 1, O);
 
 			if (SH > HEX_THRESHOLD)
-				SStream_concat(O, ", 0x%x", (unsigned int)SH);
+				SStream_concatHex(O, ", 0x", (unsigned int)SH);
 			else
-				SStream_concat(O, ", %u", (unsigned int)SH);
+				SStream_concatDec(O, ", ", (unsigned int)SH);
 
 			if (MI->csh->detail) {
 				cs_ppc *ppc = &MI->flat_insn->detail->ppc;
@@ -482,9 +495,9 @@ void PPC_printInst(MCInst *MI, SStream *O, void *Info)
 			printOperand(MI, 1, O);
 
 			if (SH > HEX_THRESHOLD)
-				SStream_concat(O, ", 0x%x", (unsigned int)SH);
+				SStream_concatHex(O, ", 0x", (unsigned int)SH);
 			else
-				SStream_concat(O, ", %u", (unsigned int)SH);
+				SStream_concatDec(O, ", ", (unsigned int)SH);
 
 			if (MI->csh->detail) {
 				cs_ppc *ppc = &MI->flat_insn->detail->ppc;
@@ -546,9 +559,9 @@ void PPC_printInst(MCInst *MI, SStream *O, void *Info)
 
 		if (!(MI->csh->mode & CS_MODE_BOOKE) && TH != 0 && TH != 16) {
 			if (TH > HEX_THRESHOLD)
-				SStream_concat(O, ", 0x%x", (unsigned int)TH);
+				SStream_concatHex(O, ", 0x", (unsigned int)TH);
 			else
-				SStream_concat(O, ", %u", (unsigned int)TH);
+				SStream_concatDec(O, ", ", (unsigned int)TH);
 
 			if (MI->csh->detail) {
 				cs_ppc *ppc = &MI->flat_insn->detail->ppc;
@@ -611,17 +624,28 @@ void PPC_printInst(MCInst *MI, SStream *O, void *Info)
 		}
 	}
 
-	mnem = printAliasBcc(MI, O, Info);
-	if (!mnem)
-		mnem = printAliasInstr(MI, O, Info);
-
-	if (mnem != NULL) {
-		if (strlen(mnem) > 0) {
+	alias = printAliasBcc(MI, O, Info, &ss);
+	if (alias)
+		alias_bcc = true;
+	else
+		// this also sets the instruction ID of the alias
+		alias = printAliasInstr(MI, O, Info);
+
+	if (alias != NULL) {
+		// the mnemonic is the start of the alias template
+		len = strcspn(alias, alias_bcc ? " \t" : " \t$");
+		if (len > sizeof(mnem) - 1)
+			len = sizeof(mnem) - 1;
+		memcpy(mnem, alias, len);
+		mnem[len] = '\0';
+
+		if (len > 0) {
 			// check to remove the last letter of ('.', '-', '+')
-			if (mnem[strlen(mnem) - 1] == '-' || mnem[strlen(mnem) - 1] == '+' || mnem[strlen(mnem) - 1] == '.')
-				mnem[strlen(mnem) - 1] = '\0';
+			if (mnem[len - 1] == '-' || mnem[len - 1] == '+' || mnem[len - 1] == '.')
+				mnem[len - 1] = '\0';
 
-            MCInst_setOpcodePub(MI, PPC_map_insn(mnem));
+			if (alias_bcc)
+				MCInst_setOpcodePub(MI, PPC_map_insn(mnem));
 
             if (MI->csh->detail) {
 				struct ppc_alias alias;
@@ -631,8 +655,6 @@ void PPC_printInst(MCInst *MI, SStream *O, void *Info)
 				}
             }
 		}
-
-		cs_mem_free(mnem);
 	} else
 		printInstruction(MI, O);
 }
@@ -1131,32 +1153,32 @@ static void printTLSCall(MCInst *MI, unsigned OpNo, SStream *O)
 	set_mem_access(MI, false);
 }
 
-/// stripRegisterPrefix - This method strips the character prefix from a
-/// register name so that only the number is left.  Used by for linux asm.
-static char *stripRegisterPrefix(const char *RegName)
+/// printStrippedRegName - This method prints a register name stripped of its
+/// character prefix, so that only the number is left.  Used by for linux asm.
+static void printStrippedRegName(SStream *O, const char *RegName)
 {
+	size_t len;
+
 	switch (RegName[0]) {
 		case 'r':
 		case 'f':
 		case 'q': // for QPX
 		case 'v':
 			if (RegName[1] == 's')
-				return cs_strdup(RegName + 2);
-
-			return cs_strdup(RegName + 1);
+				SStream_concat0(O, RegName + 2);
+			else
+				SStream_concat0(O, RegName + 1);
+			return;
 		case 'c':
 			if (RegName[1] == 'r') {
-				// skip the first 2 letters "cr"
-				char *name = cs_strdup(RegName + 2);
-
-				// also strip the last 2 letters
-				name[strlen(name) - 2] = '\0';
-
-				return name;
+				// skip the first 2 letters "cr", and also strip the last 2 letters
+				len = strlen(RegName + 2);
+				SStream_concatLen(O, RegName + 2, len >= 2 ? len - 2 : len);
+				return;
 			}
 	}
 
-	return cs_strdup(RegName);
+	SStream_concat0(O, RegName);
 }
 
 static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
@@ -1169,15 +1191,15 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 
 		// printf("reg = %u (%s)\n", reg, RegName);
 
-		// convert internal register ID to public register ID
-		reg = PPC_name_reg(RegName);
+		// convert internal register ID to public register ID.
+		// this searches all register names, so only do it for detail
+		if (MI->csh->detail)
+			reg = PPC_name_reg(RegName);
 
 		// The linux and AIX assembler does not take register prefixes.
-		if (MI->csh->syntax == CS_OPT_SYNTAX_NOREGNAME) {
-			char *name = stripRegisterPrefix(RegName);
-			SStream_concat0(O, name);
-			cs_mem_free(name);
-		} else
+		if (MI->csh->syntax == CS_OPT_SYNTAX_NOREGNAME)
+			printStrippedRegName(O, RegName);
+		else
 			SStream_concat0(O, RegName);
 #endif
 
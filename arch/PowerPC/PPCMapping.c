@@ -323,7 +323,7 @@ void PPC_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
 {
 	int i;
 
-	i = insn_find(insns, ARR_SIZE(insns), id, &h->insn_cache);
+	i = insn_find(insns, ARR_SIZE(insns), id);
 	if (i != 0) {
 		insn->id = insns[i].mapid;
 
@@ -333,13 +333,13 @@ void PPC_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
 			handle.detail = h->detail;
 
 			memcpy(insn->detail->regs_read, insns[i].regs_use, sizeof(insns[i].regs_use));
-			insn->detail->regs_read_count = (uint8_t)count_positive(insns[i].regs_use);
+			insn->detail->regs_read_count = insns[i].regs_use_count;
 
 			memcpy(insn->detail->regs_write, insns[i].regs_mod, sizeof(insns[i].regs_mod));
-			insn->detail->regs_write_count = (uint8_t)count_positive(insns[i].regs_mod);
+			insn->detail->regs_write_count = insns[i].regs_mod_count;
 
 			memcpy(insn->detail->groups, insns[i].groups, sizeof(insns[i].groups));
-			insn->detail->groups_count = (uint8_t)count_positive8(insns[i].groups);
+			insn->detail->groups_count = insns[i].groups_count;
 
 			if (insns[i].branch || insns[i].indirect_branch) {
 				// this insn also belongs to JUMP group. add JUMP group
@@ -373,15 +373,14 @@ const char *PPC_insn_name(csh handle, unsigned int id)
 // map instruction name to public instruction ID
 ppc_insn PPC_map_insn(const char *name)
 {
-	unsigned int i;
+	static const name_map insn_name_index[] = {
+#include "PPCMappingInsnNameIndex.inc"
+	};
+	int i;
 
-	for(i = 1; i < ARR_SIZE(insn_name_maps); i++) {
-		if (!strcmp(name, insn_name_maps[i]))
-			return i;
-	}
+	i = name2id_sorted(insn_name_index, ARR_SIZE(insn_name_index), name);
 
-	// not found
-	return PPC_INS_INVALID;
+	return (i != -1)? i : PPC_INS_INVALID;
 }
 
 #ifndef CAPSTONE_DIET
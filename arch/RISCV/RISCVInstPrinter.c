@@ -411,7 +411,7 @@ static void printCSRSystemRegister(MCInst *MI, unsigned OpNo,
 	if (Name) {
 		SStream_concat0(O, Name);
 	} else {
-		SStream_concat(O, "%u", Imm);
+		SStream_concatDec(O, "", (uint32_t)Imm);
 	}
 }
 
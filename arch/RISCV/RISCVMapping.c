@@ -144,7 +144,7 @@ void RISCV_get_insn_id(cs_struct * h, cs_insn * insn, unsigned int id)
 {
   	unsigned int i;
 
-  	i = insn_find(insns, ARR_SIZE(insns), id, &h->insn_cache);
+  	i = insn_find(insns, ARR_SIZE(insns), id);
   	if (i != 0) {
     		insn->id = insns[i].mapid;
 
@@ -152,13 +152,13 @@ void RISCV_get_insn_id(cs_struct * h, cs_insn * insn, unsigned int id)
 #ifndef CAPSTONE_DIET
       			memcpy(insn->detail->regs_read,
       			insns[i].regs_use, sizeof(insns[i].regs_use));
-      			insn->detail->regs_read_count = (uint8_t)count_positive(insns[i].regs_use);
+      			insn->detail->regs_read_count = insns[i].regs_use_count;
 
       			memcpy(insn->detail->regs_write, insns[i].regs_mod, sizeof(insns[i].regs_mod));
-      			insn->detail->regs_write_count = (uint8_t)count_positive(insns[i].regs_mod);
+      			insn->detail->regs_write_count = insns[i].regs_mod_count;
 
      			memcpy(insn->detail->groups, insns[i].groups, sizeof(insns[i].groups));
-      			insn->detail->groups_count = (uint8_t)count_positive8(insns[i].groups);
+      			insn->detail->groups_count = insns[i].groups_count;
 
       			if (insns[i].branch || insns[i].indirect_branch) {
         			// this insn also belongs to JUMP group. add JUMP group
@@ -352,19 +352,25 @@ static bool printGetPCX(MCInst *MI, unsigned opNum, SStream *O)
 
 void Sparc_printInst(MCInst *MI, SStream *O, void *Info)
 {
-	char *mnem, *p;
-	char instr[64];	// Sparc has no instruction this long
-
-	mnem = printAliasInstr(MI, O, Info);
-	if (mnem) {
-		// fixup instruction id due to the change in alias instruction
-		strncpy(instr, mnem, sizeof(instr));
-		instr[sizeof(instr) - 1] = '\0';
+	const char *alias;
+	char *p;
+	char mnem[64], instr[64];	// Sparc has no instruction this long
+	size_t len;
+
+	// this also sets the instruction ID of the alias
+	alias = printAliasInstr(MI, O, Info);
+	if (alias) {
+		// the mnemonic is the alias template up to the first space or tab
+		len = strcspn(alias, " \t");
+		if (len > sizeof(mnem) - 1)
+			len = sizeof(mnem) - 1;
+		memcpy(mnem, alias, len);
+		mnem[len] = '\0';
+		memcpy(instr, mnem, len + 1);
 		// does this contains hint with a coma?
 		p = strchr(instr, ',');
 		if (p)
 			*p = '\0';	// now instr only has instruction mnemonic
-		MCInst_setOpcodePub(MI, Sparc_map_insn(instr));
 		switch(MCInst_getOpcode(MI)) {
 			case SP_BCOND:
 			case SP_BCONDA:
@@ -430,7 +436,6 @@ void Sparc_printInst(MCInst *MI, SStream *O, void *Info)
 			default:
 				break;
 		}
-		cs_mem_free(mnem);
 	} else {
 		if (!printSparcAliasInstr(MI, O))
 			printInstruction(MI, O, NULL);
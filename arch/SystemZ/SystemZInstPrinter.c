@@ -174,14 +174,14 @@ static void printS8ImmOperand(MCInst *MI, int OpNum, SStream *O)
 
 	if (Value >= 0) {
 		if (Value > HEX_THRESHOLD)
-			SStream_concat(O, "0x%x", Value);
+			SStream_concatHex(O, "0x", (uint32_t)Value);
 		else
-			SStream_concat(O, "%u", Value);
+			SStream_concatDec(O, "", (uint32_t)Value);
 	} else {
 		if (Value < -HEX_THRESHOLD)
-			SStream_concat(O, "-0x%x", -Value);
+			SStream_concatHex(O, "-0x", (uint32_t)-Value);
 		else
-			SStream_concat(O, "-%u", -Value);
+			SStream_concatDec(O, "-", (uint32_t)-Value);
 	}
 
 	if (MI->csh->detail) {
@@ -197,9 +197,9 @@ static void printU8ImmOperand(MCInst *MI, int OpNum, SStream *O)
 	// assert(isUInt<8>(Value) && "Invalid u8imm argument");
 
 	if (Value > HEX_THRESHOLD)
-		SStream_concat(O, "0x%x", Value);
+		SStream_concatHex(O, "0x", (uint32_t)Value);
 	else
-		SStream_concat(O, "%u", Value);
+		SStream_concatDec(O, "", (uint32_t)Value);
 
 	if (MI->csh->detail) {
 		MI->flat_insn->detail->sysz.operands[MI->flat_insn->detail->sysz.op_count].type = SYSZ_OP_IMM;
@@ -228,14 +228,14 @@ static void printS16ImmOperand(MCInst *MI, int OpNum, SStream *O)
 
 	if (Value >= 0) {
 		if (Value > HEX_THRESHOLD)
-			SStream_concat(O, "0x%x", Value);
+			SStream_concatHex(O, "0x", (uint32_t)Value);
 		else
-			SStream_concat(O, "%u", Value);
+			SStream_concatDec(O, "", (uint32_t)Value);
 	} else {
 		if (Value < -HEX_THRESHOLD)
-			SStream_concat(O, "-0x%x", -Value);
+			SStream_concatHex(O, "-0x", (uint32_t)-Value);
 		else
-			SStream_concat(O, "-%u", -Value);
+			SStream_concatDec(O, "-", (uint32_t)-Value);
 	}
 
 	if (MI->csh->detail) {
@@ -251,9 +251,9 @@ static void printU16ImmOperand(MCInst *MI, int OpNum, SStream *O)
 	// assert(isUInt<16>(Value) && "Invalid u16imm argument");
 
 	if (Value > HEX_THRESHOLD)
-		SStream_concat(O, "0x%x", Value);
+		SStream_concatHex(O, "0x", (uint32_t)Value);
 	else
-		SStream_concat(O, "%u", Value);
+		SStream_concatDec(O, "", (uint32_t)Value);
 
 	if (MI->csh->detail) {
 		MI->flat_insn->detail->sysz.operands[MI->flat_insn->detail->sysz.op_count].type = SYSZ_OP_IMM;
@@ -351,14 +351,14 @@ static void printBDLAddrOperand(MCInst *MI, int OpNum, SStream *O)
 	uint64_t Length = (uint64_t)MCOperand_getImm(MCInst_getOperand(MI, OpNum + 2));
 
 	if (Disp > HEX_THRESHOLD)
-		SStream_concat(O, "0x%"PRIx64, Disp);
+		SStream_concatHex(O, "0x", Disp);
 	else
-		SStream_concat(O, "%"PRIu64, Disp);
+		SStream_concatDec(O, "", Disp);
 
 	if (Length > HEX_THRESHOLD)
-		SStream_concat(O, "(0x%"PRIx64, Length);
+		SStream_concatHex(O, "(0x", Length);
 	else
-		SStream_concat(O, "(%"PRIu64, Length);
+		SStream_concatDec(O, "(", Length);
 
 	if (Base)
 		SStream_concat(O, ", %%%s", getRegisterName(Base));
@@ -380,9 +380,9 @@ static void printBDRAddrOperand(MCInst *MI, int OpNum, SStream *O)
 	uint64_t Length = MCOperand_getReg(MCInst_getOperand(MI, OpNum + 2));
 
 	if (Disp > HEX_THRESHOLD)
-		SStream_concat(O, "0x%"PRIx64, Disp);
+		SStream_concatHex(O, "0x", Disp);
 	else
-		SStream_concat(O, "%"PRIu64, Disp);
+		SStream_concatDec(O, "", Disp);
 
 	SStream_concat0(O, "(");
 	SStream_concat(O, "%%%s", getRegisterName((unsigned int)Length));
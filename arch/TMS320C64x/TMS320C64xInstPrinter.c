@@ -37,6 +37,7 @@ void TMS320C64x_post_printer(csh ud, cs_insn *insn, char *insn_asm, MCInst *mci)
 {
 	SStream ss;
 	char *p, *p2, tmp[8];
+	const char *unit_name;
 	unsigned int unit = 0;
 	int i;
 	cs_tms320c64x *tms320c64x;
@@ -92,17 +93,25 @@ void TMS320C64x_post_printer(csh ud, cs_insn *insn, char *insn_asm, MCInst *mci)
 		}
 		switch(tms320c64x->funit.unit) {
 			case TMS320C64X_FUNIT_D:
-				SStream_concat(&ss, ".D%s%u", tmp, tms320c64x->funit.side);
+				unit_name = ".D";
 				break;
 			case TMS320C64X_FUNIT_L:
-				SStream_concat(&ss, ".L%s%u", tmp, tms320c64x->funit.side);
+				unit_name = ".L";
 				break;
 			case TMS320C64X_FUNIT_M:
-				SStream_concat(&ss, ".M%s%u", tmp, tms320c64x->funit.side);
+				unit_name = ".M";
 				break;
 			case TMS320C64X_FUNIT_S:
-				SStream_concat(&ss, ".S%s%u", tmp, tms320c64x->funit.side);
+				unit_name = ".S";
 				break;
+			default:
+				unit_name = NULL;
+				break;
+		}
+		if (unit_name != NULL) {
+			SStream_concat0(&ss, unit_name);
+			SStream_concat0(&ss, tmp);
+			SStream_concatDec(&ss, "", tms320c64x->funit.side);
 		}
 		if (tms320c64x->funit.crosspath > 0)
 			SStream_concat0(&ss, "X");
@@ -157,14 +166,14 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 
 		if (Imm >= 0) {
 			if (Imm > HEX_THRESHOLD)
-				SStream_concat(O, "0x%"PRIx64, Imm);
+				SStream_concatHex(O, "0x", Imm);
 			else
-				SStream_concat(O, "%"PRIu64, Imm);
+				SStream_concatDec(O, "", Imm);
 		} else {
 			if (Imm < -HEX_THRESHOLD)
-				SStream_concat(O, "-0x%"PRIx64, -Imm);
+				SStream_concatHex(O, "-0x", -Imm);
 			else
-				SStream_concat(O, "-%"PRIu64, -Imm);
+				SStream_concatDec(O, "-", -Imm);
 		}
 
 		if (MI->csh->detail) {
@@ -175,6 +184,18 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 	}
 }
 
+// print memory operand "<pre><base><post><st><offset><nd>" with a constant offset
+static void printMemOffset(SStream *O, const char *pre, unsigned base, const char *post,
+		char st, unsigned offset, char nd)
+{
+	SStream_concat0(O, pre);
+	SStream_concat0(O, getRegisterName(base));
+	SStream_concat0(O, post);
+	SStream_concat1(O, st);
+	SStream_concatDec(O, "", offset);
+	SStream_concat1(O, nd);
+}
+
 static void printMemOperand(MCInst *MI, unsigned OpNo, SStream *O)
 {
 	MCOperand *Op = MCInst_getOperand(MI, OpNo);
@@ -199,10 +220,10 @@ static void printMemOperand(MCInst *MI, unsigned OpNo, SStream *O)
 
 	switch(mode) {
 		case 0:
-			SStream_concat(O, "*-%s%c%u%c", getRegisterName(base), st, offset, nd);
+			printMemOffset(O, "*-", base, "", st, offset, nd);
 			break;
 		case 1:
-			SStream_concat(O, "*+%s%c%u%c", getRegisterName(base), st, offset, nd);
+			printMemOffset(O, "*+", base, "", st, offset, nd);
 			break;
 		case 4:
 			SStream_concat(O, "*-%s%c%s%c", getRegisterName(base), st, getRegisterName(offset), nd);
@@ -211,16 +232,16 @@ static void printMemOperand(MCInst *MI, unsigned OpNo, SStream *O)
 			SStream_concat(O, "*+%s%c%s%c", getRegisterName(base), st, getRegisterName(offset), nd);
 			break;
 		case 8:
-			SStream_concat(O, "*--%s%c%u%c", getRegisterName(base), st, offset, nd);
+			printMemOffset(O, "*--", base, "", st, offset, nd);
 			break;
 		case 9:
-			SStream_concat(O, "*++%s%c%u%c", getRegisterName(base), st, offset, nd);
+			printMemOffset(O, "*++", base, "", st, offset, nd);
 			break;
 		case 10:
-			SStream_concat(O, "*%s--%c%u%c", getRegisterName(base), st, offset, nd);
+			printMemOffset(O, "*", base, "--", st, offset, nd);
 			break;
 		case 11:
-			SStream_concat(O, "*%s++%c%u%c", getRegisterName(base), st, offset, nd);
+			printMemOffset(O, "*", base, "++", st, offset, nd);
 			break;
 		case 12:
 			SStream_concat(O, "*--%s%c%s%c", getRegisterName(base), st, getRegisterName(offset), nd);
@@ -320,7 +341,10 @@ static void printMemOperand2(MCInst *MI, unsigned OpNo, SStream *O)
 
 	basereg = Val & 0x7f;
 	offset = (Val >> 7) & 0x7fff;
-	SStream_concat(O, "*+%s[0x%x]", getRegisterName(basereg), offset);
+	SStream_concat0(O, "*+");
+	SStream_concat0(O, getRegisterName(basereg));
+	SStream_concatHex(O, "[0x", offset);
+	SStream_concat0(O, "]");
 
 	if (MI->csh->detail) {
 		tms320c64x = &MI->flat_insn->detail->tms320c64x;
@@ -6,6 +6,7 @@
 // alternatively #include "../../utils.h" like everyone else
 
 #include "WASMDisassembler.h"
+#include "WASMInstPrinter.h"
 #include "WASMMapping.h"
 #include "../../cs_priv.h"
 
@@ -375,28 +376,29 @@ static int8_t get_varint7(const uint8_t *code, size_t code_len, size_t *leng)
 // input 	| code : code pointer start from varuint32
 // 			| code_len : start from the code pointer to the end, how long is it
 // 			| param_size : pointer of the param size
-// 			| MI : Mcinst handler in this round of disasm
+// 			| insn : instruction being decoded
+// 			| data : return value, its operand
 // return 	| true/false if the function successfully finished 
-static bool read_varuint32(const uint8_t *code, size_t code_len, uint16_t *param_size, MCInst *MI)
+static bool read_varuint32(const uint8_t *code, size_t code_len, uint16_t *param_size, cs_insn *insn, cs_wasm_op *data)
 {
 	size_t len = 0;
-	uint32_t data;
+	uint32_t value;
 
-	data = get_varuint32(code, code_len, &len);
+	value = get_varuint32(code, code_len, &len);
 	if (len == -1) {
 		return false;
 	}
 
-	if (MI->flat_insn->detail) {
-		MI->flat_insn->detail->wasm.op_count = 1;
-		MI->flat_insn->detail->wasm.operands[0].type = WASM_OP_VARUINT32;
-		MI->flat_insn->detail->wasm.operands[0].size= len;
-		MI->flat_insn->detail->wasm.operands[0].varuint32= data;
+	if (insn->detail) {
+		insn->detail->wasm.op_count = 1;
+		insn->detail->wasm.operands[0].type = WASM_OP_VARUINT32;
+		insn->detail->wasm.operands[0].size= len;
+		insn->detail->wasm.operands[0].varuint32= value;
 	}
 
-	MI->wasm_data.size = len;
-	MI->wasm_data.type = WASM_OP_VARUINT32;
-	MI->wasm_data.uint32 = data;
+	data->size = len;
+	data->type = WASM_OP_VARUINT32;
+	data->uint32 = value;
 	*param_size = len;
 
 	return true;
@@ -405,28 +407,29 @@ static bool read_varuint32(const uint8_t *code, size_t code_len, uint16_t *param
 // input 	| code : code pointer start from varuint64
 // 			| code_len : start from the code pointer to the end, how long is it
 // 			| param_size : pointer of the param size
-// 			| MI : Mcinst handler in this round of disasm
+// 			| insn : instruction being decoded
+// 			| data : return value, its operand
 // return 	| true/false if the function successfully finished 
-static bool read_varuint64(const uint8_t *code, size_t code_len, uint16_t *param_size, MCInst *MI)
+static bool read_varuint64(const uint8_t *code, size_t code_len, uint16_t *param_size, cs_insn *insn, cs_wasm_op *data)
 {
 	size_t len = 0;
-	uint64_t data;
+	uint64_t value;
 
-	data = get_varuint64(code, code_len, &len);
+	value = get_varuint64(code, code_len, &len);
 	if (len == -1) {
 		return false;
 	}
 
-	if (MI->flat_insn->detail) {
-		MI->flat_insn->detail->wasm.op_count = 1;
-		MI->flat_insn->detail->wasm.operands[0].type = WASM_OP_VARUINT64;
-		MI->flat_insn->detail->wasm.operands[0].size = len;
-		MI->flat_insn->detail->wasm.operands[0].varuint64 = data;
+	if (insn->detail) {
+		insn->detail->wasm.op_count = 1;
+		insn->detail->wasm.operands[0].type = WASM_OP_VARUINT64;
+		insn->detail->wasm.operands[0].size = len;
+		insn->detail->wasm.operands[0].varuint64 = value;
 	}
 
-	MI->wasm_data.size = len;
-	MI->wasm_data.type = WASM_OP_VARUINT64;
-	MI->wasm_data.uint64 = data;
+	data->size = len;
+	data->type = WASM_OP_VARUINT64;
+	data->uint64 = value;
 	*param_size = len;
 
 	return true;
@@ -435,45 +438,46 @@ static bool read_varuint64(const uint8_t *code, size_t code_len, uint16_t *param
 // input 	| code : code pointer start from memoryimmediate
 // 			| code_len : start from the code pointer to the end, how long is it
 // 			| param_size : pointer of the param size (sum of two params)
-// 			| MI : Mcinst handler in this round of disasm
+// 			| insn : instruction being decoded
+// 			| data : return value, its operand
 // return 	| true/false if the function successfully finished 
-static bool read_memoryimmediate(const uint8_t *code, size_t code_len, uint16_t *param_size, MCInst *MI)
+static bool read_memoryimmediate(const uint8_t *code, size_t code_len, uint16_t *param_size, cs_insn *insn, cs_wasm_op *data)
 {
 	size_t tmp, len = 0;
-	uint32_t data[2];
+	uint32_t imm[2];
 
-	if (MI->flat_insn->detail) {
-		MI->flat_insn->detail->wasm.op_count = 2;
+	if (insn->detail) {
+		insn->detail->wasm.op_count = 2;
 	}
 
-	data[0] = get_varuint32(code, code_len, &tmp);
+	imm[0] = get_varuint32(code, code_len, &tmp);
 	if (tmp == -1) {
 		return false;
 	}
 
-	if (MI->flat_insn->detail) {
-		MI->flat_insn->detail->wasm.operands[0].type = WASM_OP_VARUINT32;
-		MI->flat_insn->detail->wasm.operands[0].size = tmp;
-		MI->flat_insn->detail->wasm.operands[0].varuint32 = data[0];
+	if (insn->detail) {
+		insn->detail->wasm.operands[0].type = WASM_OP_VARUINT32;
+		insn->detail->wasm.operands[0].size = tmp;
+		insn->detail->wasm.operands[0].varuint32 = imm[0];
 	}
 
 	len = tmp;
-	data[1] = get_varuint32(&code[len], code_len - len, &tmp);
-	if (len == -1) {
+	imm[1] = get_varuint32(&code[len], code_len - len, &tmp);
+	if (tmp == -1) {
 		return false;
 	}
 
-	if (MI->flat_insn->detail) {
-		MI->flat_insn->detail->wasm.operands[1].type = WASM_OP_VARUINT32;
-		MI->flat_insn->detail->wasm.operands[1].size = tmp;
-		MI->flat_insn->detail->wasm.operands[1].varuint32 = data[1];
+	if (insn->detail) {
+		insn->detail->wasm.operands[1].type = WASM_OP_VARUINT32;
+		insn->detail->wasm.operands[1].size = tmp;
+		insn->detail->wasm.operands[1].varuint32 = imm[1];
 	}
 
 	len += tmp;
-	MI->wasm_data.size = len;
-	MI->wasm_data.type = WASM_OP_IMM;
-	MI->wasm_data.immediate[0] = data[0];
-	MI->wasm_data.immediate[1] = data[1];
+	data->size = len;
+	data->type = WASM_OP_IMM;
+	data->immediate[0] = imm[0];
+	data->immediate[1] = imm[1];
 	*param_size = len;
 
 	return true;
@@ -482,25 +486,26 @@ static bool read_memoryimmediate(const uint8_t *code, size_t code_len, uint16_t
 // input 	| code : code pointer start from uint32
 // 			| code_len : start from the code pointer to the end, how long is it
 // 			| param_size : pointer of the param size
-// 			| MI : Mcinst handler in this round of disasm
+// 			| insn : instruction being decoded
+// 			| data : return value, its operand
 // return 	| true/false if the function successfully finished 
-static bool read_uint32(const uint8_t *code, size_t code_len, uint16_t *param_size, MCInst *MI)
+static bool read_uint32(const uint8_t *code, size_t code_len, uint16_t *param_size, cs_insn *insn, cs_wasm_op *data)
 {
 	if (code_len < 4) {
 		return false;
 	}
 
-	get_uint32(code, &(MI->wasm_data.uint32));
+	get_uint32(code, &(data->uint32));
 
-	if (MI->flat_insn->detail) {
-		MI->flat_insn->detail->wasm.op_count = 1;
-		MI->flat_insn->detail->wasm.operands[0].type = WASM_OP_UINT32;
-		MI->flat_insn->detail->wasm.operands[0].size = 4;
-		get_uint32(code, &(MI->flat_insn->detail->wasm.operands[0].uint32));
+	if (insn->detail) {
+		insn->detail->wasm.op_count = 1;
+		insn->detail->wasm.operands[0].type = WASM_OP_UINT32;
+		insn->detail->wasm.operands[0].size = 4;
+		get_uint32(code, &(insn->detail->wasm.operands[0].uint32));
 	}
 
-	MI->wasm_data.size = 4;
-	MI->wasm_data.type = WASM_OP_UINT32;
+	data->size = 4;
+	data->type = WASM_OP_UINT32;
 	*param_size = 4;
 
 	return true;
@@ -509,25 +514,26 @@ static bool read_uint32(const uint8_t *code, size_t code_len, uint16_t *param_si
 // input 	| code : code pointer start from uint64
 // 			| code_len : start from the code pointer to the end, how long is it
 // 			| param_size : pointer of the param size
-// 			| MI : Mcinst handler in this round of disasm
+// 			| insn : instruction being decoded
+// 			| data : return value, its operand
 // return 	| true/false if the function successfully finished 
-static bool read_uint64(const uint8_t *code, size_t code_len, uint16_t *param_size, MCInst *MI)
+static bool read_uint64(const uint8_t *code, size_t code_len, uint16_t *param_size, cs_insn *insn, cs_wasm_op *data)
 {
 	if (code_len < 8) {
 		return false;
 	}
 
-	get_uint64(code, &(MI->wasm_data.uint64));
+	get_uint64(code, &(data->uint64));
 
-	if (MI->flat_insn->detail) {
-		MI->flat_insn->detail->wasm.op_count = 1;
-		MI->flat_insn->detail->wasm.operands[0].type = WASM_OP_UINT64;
-		MI->flat_insn->detail->wasm.operands[0].size = 8;
-		get_uint64(code, &(MI->flat_insn->detail->wasm.operands[0].uint64));
+	if (insn->detail) {
+		insn->detail->wasm.op_count = 1;
+		insn->detail->wasm.operands[0].type = WASM_OP_UINT64;
+		insn->detail->wasm.operands[0].size = 8;
+		get_uint64(code, &(insn->detail->wasm.operands[0].uint64));
 	}
 
-	MI->wasm_data.size = 8;
-	MI->wasm_data.type = WASM_OP_UINT64;
+	data->size = 8;
+	data->type = WASM_OP_UINT64;
 	*param_size = 8;
 
 	return true;
@@ -535,68 +541,90 @@ static bool read_uint64(const uint8_t *code, size_t code_len, uint16_t *param_si
 
 // input 	| code : code pointer start from brtable
 // 			| code_len : start from the code pointer to the end, how long is it
-// 			| param_size : pointer of the param size (sum of all param)
-// 			| MI : Mcinst handler in this round of disasm
-// return 	| true/false if the function successfully finished 
-static bool read_brtable(const uint8_t *code, size_t code_len, uint16_t *param_size, MCInst *MI)
+// 			| length : return value, number of targets
+// 			| length_size : return value, length of the varuint32 of @length
+// 			| default_target : return value, default target
+// return 	| size of brtable, 0 means error
+static size_t get_brtable(const uint8_t *code, size_t code_len, uint32_t *length,
+		size_t *length_size, uint32_t *default_target)
 {
-	uint32_t length, default_target;
 	int tmp_len = 0, i;
 	size_t var_len;
 
 	// read length
-	length = get_varuint32(code, code_len, &var_len);
+	*length = get_varuint32(code, code_len, &var_len);
 	if (var_len == -1) {
-		return false;
+		return 0;
 	}
 
 	tmp_len += var_len;
-	MI->wasm_data.brtable.length = length;
-	if (length >= UINT32_MAX - tmp_len) {
+	*length_size = var_len;
+	if (*length >= UINT32_MAX - tmp_len) {
 		// integer overflow check
-		return false;
+		return 0;
 	}
-	if (code_len < tmp_len + length) {
+	if (code_len < tmp_len + *length) {
 		// safety check that we have minimum enough data to read
-		return false;
-	}
-	// base address + 1 byte opcode + tmp_len for number of cases = start of targets
-	MI->wasm_data.brtable.address = MI->address + 1 + tmp_len;
-
-	if (MI->flat_insn->detail) {
-		MI->flat_insn->detail->wasm.op_count = 1;
-		MI->flat_insn->detail->wasm.operands[0].type = WASM_OP_BRTABLE;
-		MI->flat_insn->detail->wasm.operands[0].brtable.length = MI->wasm_data.brtable.length;
-		MI->flat_insn->detail->wasm.operands[0].brtable.address = MI->wasm_data.brtable.address;
+		return 0;
 	}
 
 	// read data
-	for(i = 0; i < length; i++){
+	for(i = 0; i < *length; i++){
 		if (code_len < tmp_len) {
-			return false;
+			return 0;
 		}
 
 		get_varuint32(code + tmp_len, code_len - tmp_len, &var_len);
 		if (var_len == -1) {
-			return false;
+			return 0;
 		}
 
 		tmp_len += var_len;
 	}
 
 	// read default target
-	default_target = get_varuint32(code + tmp_len, code_len - tmp_len, &var_len);
+	*default_target = get_varuint32(code + tmp_len, code_len - tmp_len, &var_len);
 	if (var_len == -1) {
+		return 0;
+	}
+
+	return tmp_len + var_len;
+}
+
+// input 	| code : code pointer start from brtable
+// 			| code_len : start from the code pointer to the end, how long is it
+// 			| param_size : pointer of the param size (sum of all param)
+// 			| insn : instruction being decoded
+// 			| data : return value, its operand
+// return 	| true/false if the function successfully finished 
+static bool read_brtable(const uint8_t *code, size_t code_len, uint16_t *param_size, cs_insn *insn, cs_wasm_op *data)
+{
+	uint32_t length, default_target;
+	size_t size, length_size;
+
+	size = get_brtable(code, code_len, &length, &length_size, &default_target);
+	if (size == 0) {
 		return false;
 	}
 
-	MI->wasm_data.brtable.default_target = default_target;
-	MI->wasm_data.type = WASM_OP_BRTABLE;
-	*param_size = tmp_len + var_len;
+	data->brtable.length = length;
+	// base address + 1 byte opcode + length_size for number of cases = start of targets
+	data->brtable.address = insn->address + 1 + length_size;
 
-	if (MI->flat_insn->detail) {
-		MI->flat_insn->detail->wasm.operands[0].size = *param_size;
-		MI->flat_insn->detail->wasm.operands[0].brtable.default_target = MI->wasm_data.brtable.default_target;
+	if (insn->detail) {
+		insn->detail->wasm.op_count = 1;
+		insn->detail->wasm.operands[0].type = WASM_OP_BRTABLE;
+		insn->detail->wasm.operands[0].brtable.length = data->brtable.length;
+		insn->detail->wasm.operands[0].brtable.address = data->brtable.address;
+	}
+
+	data->brtable.default_target = default_target;
+	data->type = WASM_OP_BRTABLE;
+	*param_size = size;
+
+	if (insn->detail) {
+		insn->detail->wasm.operands[0].size = *param_size;
+		insn->detail->wasm.operands[0].brtable.default_target = data->brtable.default_target;
 	}
 
 	return true;
@@ -605,23 +633,24 @@ static bool read_brtable(const uint8_t *code, size_t code_len, uint16_t *param_s
 // input 	| code : code pointer start from varint7
 // 			| code_len : start from the code pointer to the end, how long is it
 // 			| param_size : pointer of the param size
-// 			| MI : Mcinst handler in this round of disasm
+// 			| insn : instruction being decoded
+// 			| data : return value, its operand
 // return 	| true/false if the function successfully finished 
-static bool read_varint7(const uint8_t *code, size_t code_len, uint16_t *param_size, MCInst *MI)
+static bool read_varint7(const uint8_t *code, size_t code_len, uint16_t *param_size, cs_insn *insn, cs_wasm_op *data)
 {
 	size_t len = 0;
 
-	MI->wasm_data.type = WASM_OP_INT7;
-	MI->wasm_data.int7 = get_varint7(code, code_len, &len);
+	data->type = WASM_OP_INT7;
+	data->int7 = get_varint7(code, code_len, &len);
 	if (len == -1) {
 		return false;
 	}
 
-	if (MI->flat_insn->detail) {
-		MI->flat_insn->detail->wasm.op_count = 1;
-		MI->flat_insn->detail->wasm.operands[0].type = WASM_OP_INT7;
-		MI->flat_insn->detail->wasm.operands[0].size = 1;
-		MI->flat_insn->detail->wasm.operands[0].int7 = MI->wasm_data.int7;
+	if (insn->detail) {
+		insn->detail->wasm.op_count = 1;
+		insn->detail->wasm.operands[0].type = WASM_OP_INT7;
+		insn->detail->wasm.operands[0].size = 1;
+		insn->detail->wasm.operands[0].int7 = data->int7;
 	}
 
 	*param_size = len;
@@ -629,8 +658,10 @@ static bool read_varint7(const uint8_t *code, size_t code_len, uint16_t *param_s
 	return true;
 }
 
-bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
-		MCInst *MI, uint16_t *size, uint64_t address, void *inst_info)
+// decode the instruction at @code into @insn, whose address is set, and its
+// operand into @data. return false if it is invalid
+static bool decode(cs_struct *ud, const uint8_t *code, size_t code_len,
+		cs_insn *insn, cs_wasm_op *data, uint16_t *size)
 {
 	unsigned char opcode;
 	uint16_t param_size;
@@ -644,13 +675,9 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 		return false;
 	}
 
-	// valid opcode
-	MI->address = address;
-	MI->OpcodePub = MI->Opcode = opcode;
-
-	if (MI->flat_insn->detail) {
-		memset(MI->flat_insn->detail, 0, offsetof(cs_detail, wasm)+sizeof(cs_wasm));
-		WASM_get_insn_id((cs_struct *)ud, MI->flat_insn, opcode);
+	if (insn->detail) {
+		memset(insn->detail, 0, offsetof(cs_detail, wasm)+sizeof(cs_wasm));
+		WASM_get_insn_id(ud, insn, opcode);
 	}
 
 	// setup groups
@@ -659,14 +686,14 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 			return false;
 
 		case WASM_INS_I32_CONST:
-			if (code_len == 1 || !read_varuint32(&code[1], code_len - 1, &param_size, MI)) {
+			if (code_len == 1 || !read_varuint32(&code[1], code_len - 1, &param_size, insn, data)) {
 				return false;
 			}
 
-			if (MI->flat_insn->detail) {
-				MI->flat_insn->detail->wasm.op_count = 1;
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = WASM_GRP_NUMBERIC;
-				MI->flat_insn->detail->groups_count++;
+			if (insn->detail) {
+				insn->detail->wasm.op_count = 1;
+				insn->detail->groups[insn->detail->groups_count] = WASM_GRP_NUMBERIC;
+				insn->detail->groups_count++;
 			}
 
 			*size = param_size + 1;
@@ -674,14 +701,14 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 			break;
 
 		case WASM_INS_I64_CONST:
-			if (code_len == 1 || !read_varuint64(&code[1], code_len - 1, &param_size, MI)) {
+			if (code_len == 1 || !read_varuint64(&code[1], code_len - 1, &param_size, insn, data)) {
 				return false;
 			}
 
-			if (MI->flat_insn->detail) {
-				MI->flat_insn->detail->wasm.op_count = 1;
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = WASM_GRP_NUMBERIC;
-				MI->flat_insn->detail->groups_count++;
+			if (insn->detail) {
+				insn->detail->wasm.op_count = 1;
+				insn->detail->groups[insn->detail->groups_count] = WASM_GRP_NUMBERIC;
+				insn->detail->groups_count++;
 			}
 
 			*size = param_size + 1;
@@ -689,14 +716,14 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 			break;
 
 		case WASM_INS_F32_CONST:
-			if (code_len == 1 || !read_uint32(&code[1], code_len - 1, &param_size, MI)) {
+			if (code_len == 1 || !read_uint32(&code[1], code_len - 1, &param_size, insn, data)) {
 				return false;
 			}
 
-			if (MI->flat_insn->detail) {
-				MI->flat_insn->detail->wasm.op_count = 1;
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = WASM_GRP_NUMBERIC;
-				MI->flat_insn->detail->groups_count++;
+			if (insn->detail) {
+				insn->detail->wasm.op_count = 1;
+				insn->detail->groups[insn->detail->groups_count] = WASM_GRP_NUMBERIC;
+				insn->detail->groups_count++;
 			}
 
 			*size = param_size + 1;
@@ -704,14 +731,14 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 			break;
 
 		case WASM_INS_F64_CONST:
-			if (code_len == 1 || !read_uint64(&code[1], code_len - 1, &param_size, MI)) {
+			if (code_len == 1 || !read_uint64(&code[1], code_len - 1, &param_size, insn, data)) {
 				return false;
 			}
 
-			if (MI->flat_insn->detail) {
-				MI->flat_insn->detail->wasm.op_count = 1;
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = WASM_GRP_NUMBERIC;
-				MI->flat_insn->detail->groups_count++;
+			if (insn->detail) {
+				insn->detail->wasm.op_count = 1;
+				insn->detail->groups[insn->detail->groups_count] = WASM_GRP_NUMBERIC;
+				insn->detail->groups_count++;
 			}
 
 			*size = param_size + 1;
@@ -841,12 +868,12 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 		case WASM_INS_I64_REINTERPRET_F64:
 		case WASM_INS_F32_REINTERPRET_I32:
 		case WASM_INS_F64_REINTERPRET_I64:
-			MI->wasm_data.type = WASM_OP_NONE;
+			data->type = WASM_OP_NONE;
 
-			if (MI->flat_insn->detail) {
-				MI->flat_insn->detail->wasm.op_count = 0;
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = WASM_GRP_NUMBERIC;
-				MI->flat_insn->detail->groups_count++;
+			if (insn->detail) {
+				insn->detail->wasm.op_count = 0;
+				insn->detail->groups[insn->detail->groups_count] = WASM_GRP_NUMBERIC;
+				insn->detail->groups_count++;
 			}
 
 			*size = 1;
@@ -855,12 +882,12 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 
 		case WASM_INS_DROP:
 		case WASM_INS_SELECT:
-			MI->wasm_data.type = WASM_OP_NONE;
+			data->type = WASM_OP_NONE;
 
-			if (MI->flat_insn->detail) {
-				MI->flat_insn->detail->wasm.op_count = 0;
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = WASM_GRP_PARAMETRIC;
-				MI->flat_insn->detail->groups_count++;
+			if (insn->detail) {
+				insn->detail->wasm.op_count = 0;
+				insn->detail->groups[insn->detail->groups_count] = WASM_GRP_PARAMETRIC;
+				insn->detail->groups_count++;
 			}
 
 			*size = 1;
@@ -872,14 +899,14 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 		case WASM_INS_TEE_LOCAL:
 		case WASM_INS_GET_GLOBAL:
 		case WASM_INS_SET_GLOBAL:
-			if (code_len == 1 || !read_varuint32(&code[1], code_len - 1, &param_size, MI)) {
+			if (code_len == 1 || !read_varuint32(&code[1], code_len - 1, &param_size, insn, data)) {
 				return false;
 			}
 
-			if (MI->flat_insn->detail) {
-				MI->flat_insn->detail->wasm.op_count = 1;
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = WASM_GRP_VARIABLE;
-				MI->flat_insn->detail->groups_count++;
+			if (insn->detail) {
+				insn->detail->wasm.op_count = 1;
+				insn->detail->groups[insn->detail->groups_count] = WASM_GRP_VARIABLE;
+				insn->detail->groups_count++;
 			}
 
 			*size = param_size + 1;
@@ -909,14 +936,14 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 		case WASM_INS_I64_STORE8:
 		case WASM_INS_I64_STORE16:
 		case WASM_INS_I64_STORE32:
-			if (code_len == 1 || !read_memoryimmediate(&code[1], code_len - 1, &param_size, MI)) {
+			if (code_len == 1 || !read_memoryimmediate(&code[1], code_len - 1, &param_size, insn, data)) {
 				return false;
 			}
 
-			if (MI->flat_insn->detail) {
-				MI->flat_insn->detail->wasm.op_count = 2;
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = WASM_GRP_MEMORY;
-				MI->flat_insn->detail->groups_count++;
+			if (insn->detail) {
+				insn->detail->wasm.op_count = 2;
+				insn->detail->groups[insn->detail->groups_count] = WASM_GRP_MEMORY;
+				insn->detail->groups_count++;
 			}
 
 			*size = param_size + 1;
@@ -925,12 +952,12 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 
 		case WASM_INS_CURRENT_MEMORY:
 		case WASM_INS_GROW_MEMORY:
-			MI->wasm_data.type = WASM_OP_NONE;
+			data->type = WASM_OP_NONE;
 
-			if (MI->flat_insn->detail) {
-				MI->flat_insn->detail->wasm.op_count = 0;
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = WASM_GRP_MEMORY;
-				MI->flat_insn->detail->groups_count++;
+			if (insn->detail) {
+				insn->detail->wasm.op_count = 0;
+				insn->detail->groups[insn->detail->groups_count] = WASM_GRP_MEMORY;
+				insn->detail->groups_count++;
 			}
 
 			*size = 1;
@@ -942,12 +969,12 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 		case WASM_INS_ELSE:
 		case WASM_INS_END:
 		case WASM_INS_RETURN:
-			MI->wasm_data.type = WASM_OP_NONE;
+			data->type = WASM_OP_NONE;
 
-			if (MI->flat_insn->detail) {
-				MI->flat_insn->detail->wasm.op_count = 0;
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = WASM_GRP_CONTROL;
-				MI->flat_insn->detail->groups_count++;
+			if (insn->detail) {
+				insn->detail->wasm.op_count = 0;
+				insn->detail->groups[insn->detail->groups_count] = WASM_GRP_CONTROL;
+				insn->detail->groups_count++;
 			}
 
 			*size = 1;
@@ -957,14 +984,14 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 		case WASM_INS_BLOCK:
 		case WASM_INS_LOOP:
 		case WASM_INS_IF:
-			if (code_len == 1 || !read_varint7(&code[1], code_len - 1, &param_size, MI)) {
+			if (code_len == 1 || !read_varint7(&code[1], code_len - 1, &param_size, insn, data)) {
 				return false;
 			}
 
-			if (MI->flat_insn->detail) {
-				MI->flat_insn->detail->wasm.op_count = 1;
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = WASM_GRP_CONTROL;
-				MI->flat_insn->detail->groups_count++;
+			if (insn->detail) {
+				insn->detail->wasm.op_count = 1;
+				insn->detail->groups[insn->detail->groups_count] = WASM_GRP_CONTROL;
+				insn->detail->groups_count++;
 			}
 
 			*size = param_size + 1;
@@ -975,14 +1002,14 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 		case WASM_INS_BR_IF:
 		case WASM_INS_CALL:
 		case WASM_INS_CALL_INDIRECT:
-			if (code_len == 1 || !read_varuint32(&code[1], code_len - 1, &param_size, MI)) {
+			if (code_len == 1 || !read_varuint32(&code[1], code_len - 1, &param_size, insn, data)) {
 				return false;
 			}
 
-			if (MI->flat_insn->detail) {
-				MI->flat_insn->detail->wasm.op_count = 1;
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = WASM_GRP_CONTROL;
-				MI->flat_insn->detail->groups_count++;
+			if (insn->detail) {
+				insn->detail->wasm.op_count = 1;
+				insn->detail->groups[insn->detail->groups_count] = WASM_GRP_CONTROL;
+				insn->detail->groups_count++;
 			}
 
 			*size = param_size + 1;
@@ -990,14 +1017,14 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 			break;
 
 		case WASM_INS_BR_TABLE:
-			if (code_len == 1 || !read_brtable(&code[1], code_len - 1, &param_size, MI)) {
+			if (code_len == 1 || !read_brtable(&code[1], code_len - 1, &param_size, insn, data)) {
 				return false;
 			}
 
-			if (MI->flat_insn->detail) {
-				MI->flat_insn->detail->wasm.op_count = 1;
-				MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = WASM_GRP_CONTROL;
-				MI->flat_insn->detail->groups_count++;
+			if (insn->detail) {
+				insn->detail->wasm.op_count = 1;
+				insn->detail->groups[insn->detail->groups_count] = WASM_GRP_CONTROL;
+				insn->detail->groups_count++;
 			}
 
 			*size = param_size + 1;
@@ -1007,3 +1034,122 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 
 	return true;
 }
+
+bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
+		MCInst *MI, uint16_t *size, uint64_t address, void *inst_info)
+{
+	if (!decode((cs_struct *)ud, code, code_len, MI->flat_insn, &MI->wasm_data, size))
+		return false;
+
+	MI->address = address;
+	MI->OpcodePub = MI->Opcode = code[0];
+
+	return true;
+}
+
+bool WASM_disasmInsn(cs_struct *ud, const uint8_t *code, size_t code_len,
+		cs_insn *insn, uint16_t *size)
+{
+	cs_wasm_op data;
+
+	data.type = WASM_OP_INVALID;
+	if (!decode(ud, code, code_len, insn, &data, size))
+		return false;
+
+	insn->id = code[0];
+
+	if (!ud->no_text)
+		WASM_printInsn(insn, &data);
+
+	return true;
+}
+
+uint16_t WASM_getInsnLength(csh ud, const uint8_t *code, size_t code_len,
+		uint64_t address)
+{
+	uint32_t length, default_target;
+	size_t len, tmp;
+
+	if (code_len == 0 || opcodes[code[0]] == -1)
+		return 0;
+
+	// find the size of immediates, without decoding them into MCInst
+	switch(code[0]) {
+		default:
+			return 1;
+
+		case WASM_INS_I32_CONST:
+		case WASM_INS_GET_LOCAL:
+		case WASM_INS_SET_LOCAL:
+		case WASM_INS_TEE_LOCAL:
+		case WASM_INS_GET_GLOBAL:
+		case WASM_INS_SET_GLOBAL:
+		case WASM_INS_BR:
+		case WASM_INS_BR_IF:
+		case WASM_INS_CALL:
+		case WASM_INS_CALL_INDIRECT:
+			get_varuint32(code + 1, code_len - 1, &len);
+			break;
+
+		case WASM_INS_I64_CONST:
+			get_varuint64(code + 1, code_len - 1, &len);
+			break;
+
+		case WASM_INS_F32_CONST:
+			len = code_len - 1 < 4 ? -1 : 4;
+			break;
+
+		case WASM_INS_F64_CONST:
+			len = code_len - 1 < 8 ? -1 : 8;
+			break;
+
+		case WASM_INS_I32_LOAD:
+		case WASM_INS_I64_LOAD:
+		case WASM_INS_F32_LOAD:
+		case WASM_INS_F64_LOAD:
+		case WASM_INS_I32_LOAD8_S:
+		case WASM_INS_I32_LOAD8_U:
+		case WASM_INS_I32_LOAD16_S:
+		case WASM_INS_I32_LOAD16_U:
+		case WASM_INS_I64_LOAD8_S:
+		case WASM_INS_I64_LOAD8_U:
+		case WASM_INS_I64_LOAD16_S:
+		case WASM_INS_I64_LOAD16_U:
+		case WASM_INS_I64_LOAD32_S:
+		case WASM_INS_I64_LOAD32_U:
+		case WASM_INS_I32_STORE:
+		case WASM_INS_I64_STORE:
+		case WASM_INS_F32_STORE:
+		case WASM_INS_F64_STORE:
+		case WASM_INS_I32_STORE8:
+		case WASM_INS_I32_STORE16:
+		case WASM_INS_I64_STORE8:
+		case WASM_INS_I64_STORE16:
+		case WASM_INS_I64_STORE32:
+			// memoryimmediate: flags & offset
+			get_varuint32(code + 1, code_len - 1, &len);
+			if (len == -1)
+				break;
+
+			get_varuint32(code + 1 + len, code_len - 1 - len, &tmp);
+			len = tmp == -1 ? -1 : len + tmp;
+			break;
+
+		case WASM_INS_BLOCK:
+		case WASM_INS_LOOP:
+		case WASM_INS_IF:
+			get_varint7(code + 1, code_len - 1, &len);
+			break;
+
+		case WASM_INS_BR_TABLE:
+			len = get_brtable(code + 1, code_len - 1, &length, &tmp, &default_target);
+			if (len == 0)
+				len = -1;
+			break;
+	}
+
+	if (len == -1)
+		return 0;
+
+	return (uint16_t)len + 1;
+}
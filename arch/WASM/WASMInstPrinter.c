@@ -1,47 +1,76 @@
 /* Capstone Disassembly Engine */
 /* By Spike, xwings  2019 */
 
+#include <string.h>
+
 #include "WASMInstPrinter.h"
 #include "WASMMapping.h"
 
 
-void WASM_printInst(MCInst *MI, struct SStream *O, void *PrinterInfo)
+// print operand @data of an instruction, without the tab before it
+static void printOperands(SStream *O, const cs_wasm_op *data)
 {
-	SStream_concat(O, WASM_insn_name((csh)MI->csh, MI->Opcode));
-
-	switch (MI->wasm_data.type) {
+	switch (data->type) {
 		default:
 			break;
 
 		case WASM_OP_VARUINT32:
-			SStream_concat(O, "\t0x%x", MI->wasm_data.varuint32);
+			SStream_concatHex(O, "0x", (uint32_t)data->varuint32);
 			break;
 
 		case WASM_OP_VARUINT64:
-			SStream_concat(O, "\t0x%lx", MI->wasm_data.varuint64);
+			SStream_concat(O, "0x%lx", data->varuint64);
 			break;
 
 		case WASM_OP_UINT32:
-			SStream_concat(O, "\t0x%2" PRIx32, MI->wasm_data.uint32);
+			SStream_concat(O, "0x%2" PRIx32, data->uint32);
 			break;
 
 		case WASM_OP_UINT64:
-			SStream_concat(O, "\t0x%2" PRIx64, MI->wasm_data.uint64);
+			SStream_concat(O, "0x%2" PRIx64, data->uint64);
 			break;
 
 		case WASM_OP_IMM:
-			SStream_concat(O, "\t0x%x, 0x%x", MI->wasm_data.immediate[0], MI->wasm_data.immediate[1]);
+			SStream_concat(O, "0x%x, 0x%x", data->immediate[0], data->immediate[1]);
 			break;
 
 		case WASM_OP_INT7:
-			SStream_concat(O, "\t%d", MI->wasm_data.int7);
+			SStream_concat(O, "%d", data->int7);
 			break;
 
 		case WASM_OP_BRTABLE:
-			SStream_concat(O, "\t0x%x, [", MI->wasm_data.brtable.length);
-			SStream_concat(O, "0x%x", MI->wasm_data.brtable.address);
-			SStream_concat(O, "], 0x%x", MI->wasm_data.brtable.default_target);
+			SStream_concat(O, "0x%x, [", data->brtable.length);
+			SStream_concatHex(O, "0x", (uint32_t)data->brtable.address);
+			SStream_concatHex(O, "], 0x", (uint32_t)data->brtable.default_target);
 
 			break;
 	}
 }
+
+void WASM_printInst(MCInst *MI, struct SStream *O, void *PrinterInfo)
+{
+	SStream_concat(O, WASM_insn_name((csh)MI->csh, MI->Opcode));
+
+	if (MI->wasm_data.type != WASM_OP_INVALID && MI->wasm_data.type != WASM_OP_NONE) {
+		SStream_concat0(O, "\t");
+		printOperands(O, &MI->wasm_data);
+	}
+}
+
+// render the text of @insn, whose operand is @data, straight into its
+// mnemonic & op_str, like WASM_printInst() then fill_insn() would do
+void WASM_printInsn(cs_insn *insn, const cs_wasm_op *data)
+{
+#ifndef CAPSTONE_DIET
+	SStream ss;
+
+	strcpy(insn->mnemonic, WASM_insn_name(0, insn->id));
+
+	if (data->type != WASM_OP_INVALID && data->type != WASM_OP_NONE) {
+		SStream_Init(&ss);
+		printOperands(&ss, data);
+		strncpy(insn->op_str, ss.buffer, sizeof(insn->op_str) - 1);
+		insn->op_str[sizeof(insn->op_str) - 1] = '\0';
+	}
+#endif
+}
@@ -13,6 +13,7 @@
 struct SStream;
 
 void WASM_printInst(MCInst *MI, struct SStream *O, void *Info);
+void WASM_printInsn(cs_insn *insn, const cs_wasm_op *data);
 void printOperand(MCInst *MI, unsigned OpNo, SStream *O);
 
 #endif
@@ -21,6 +21,8 @@ cs_err WASM_global_init(cs_struct *ud)
 	ud->insn_name = WASM_insn_name;
 	ud->group_name = WASM_group_name;
 	ud->disasm = WASM_getInstruction;
+	ud->insn_length = WASM_getInsnLength;
+	ud->disasm_insn = WASM_disasmInsn;
 
 	return CS_ERR_OK;
 }
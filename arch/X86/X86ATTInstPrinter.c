@@ -264,18 +264,18 @@ static void _printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 					}
 				}
 
-				SStream_concat(O, "$0x%"PRIx64, imm);
+				SStream_concatHex(O, "$0x", imm);
 			} else {
 				if (imm < -HEX_THRESHOLD)
-					SStream_concat(O, "$-0x%"PRIx64, -imm);
+					SStream_concatHex(O, "$-0x", -imm);
 				else
-					SStream_concat(O, "$-%"PRIu64, -imm);
+					SStream_concatDec(O, "$-", -imm);
 			}
 		} else {
 			if (imm > HEX_THRESHOLD)
-				SStream_concat(O, "$0x%"PRIx64, imm);
+				SStream_concatHex(O, "$0x", imm);
 			else
-				SStream_concat(O, "$%"PRIu64, imm);
+				SStream_concatDec(O, "$", imm);
 		}
 	}
 }
@@ -467,12 +467,12 @@ static void printMemOffset(MCInst *MI, unsigned Op, SStream *O)
 		if (MI->csh->detail)
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.disp = imm;
 		if (imm < 0) {
-			SStream_concat(O, "0x%"PRIx64, arch_masks[MI->csh->mode] & imm);
+			SStream_concatHex(O, "0x", arch_masks[MI->csh->mode] & imm);
 		} else {
 			if (imm > HEX_THRESHOLD)
-				SStream_concat(O, "0x%"PRIx64, imm);
+				SStream_concatHex(O, "0x", imm);
 			else
-				SStream_concat(O, "%"PRIu64, imm);
+				SStream_concatDec(O, "", imm);
 		}
 	}
 
@@ -485,9 +485,9 @@ static void printU8Imm(MCInst *MI, unsigned Op, SStream *O)
 	uint8_t val = MCOperand_getImm(MCInst_getOperand(MI, Op)) & 0xff;
 
 	if (val > HEX_THRESHOLD)
-		SStream_concat(O, "$0x%x", val);
+		SStream_concatHex(O, "$0x", val);
 	else
-		SStream_concat(O, "$%u", val);
+		SStream_concatDec(O, "$", val);
 
 	if (MI->csh->detail) {
 		MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].type = X86_OP_IMM;
@@ -537,12 +537,12 @@ static void printPCRelImm(MCInst *MI, unsigned OpNo, SStream *O)
 		}
 
 		if (imm < 0) {
-			SStream_concat(O, "0x%"PRIx64, imm);
+			SStream_concatHex(O, "0x", imm);
 		} else {
 			if (imm > HEX_THRESHOLD)
-				SStream_concat(O, "0x%"PRIx64, imm);
+				SStream_concatHex(O, "0x", imm);
 			else
-				SStream_concat(O, "%"PRIu64, imm);
+				SStream_concatDec(O, "", imm);
 		}
 		if (MI->csh->detail) {
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].type = X86_OP_IMM;
@@ -588,9 +588,9 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 			default:
 				if (imm >= 0) {
 					if (imm > HEX_THRESHOLD)
-						SStream_concat(O, "$0x%"PRIx64, imm);
+						SStream_concatHex(O, "$0x", imm);
 					else
-						SStream_concat(O, "$%"PRIu64, imm);
+						SStream_concatDec(O, "$", imm);
 				} else {
 					if (MI->csh->imm_unsigned) {
 						if (opsize) {
@@ -609,14 +609,14 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 							}
 						}
 
-						SStream_concat(O, "$0x%"PRIx64, imm);
+						SStream_concatHex(O, "$0x", imm);
 					} else {
 						if (imm == 0x8000000000000000LL)  // imm == -imm
 							SStream_concat0(O, "$0x8000000000000000");
 						else if (imm < -HEX_THRESHOLD)
-							SStream_concat(O, "$-0x%"PRIx64, -imm);
+							SStream_concatHex(O, "$-0x", -imm);
 						else
-							SStream_concat(O, "$-%"PRIu64, -imm);
+							SStream_concatDec(O, "$-", -imm);
 					}
 				}
 				break;
@@ -625,9 +625,9 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 			case X86_INS_MOV:
 				// do not print number in negative form
 				if (imm > HEX_THRESHOLD)
-					SStream_concat(O, "$0x%"PRIx64, imm);
+					SStream_concatHex(O, "$0x", imm);
 				else
-					SStream_concat(O, "$%"PRIu64, imm);
+					SStream_concatDec(O, "$", imm);
 				break;
 
 			case X86_INS_IN:
@@ -636,9 +636,9 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 				// do not print number in negative form
 				imm = imm & 0xff;
 				if (imm >= 0 && imm <= HEX_THRESHOLD)
-					SStream_concat(O, "$%u", imm);
+					SStream_concatDec(O, "$", imm);
 				else {
-					SStream_concat(O, "$0x%x", imm);
+					SStream_concatHex(O, "$0x", imm);
 				}
 				break;
 
@@ -651,7 +651,7 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 					opsize = 2;
 				} else
 					opsize = 4;
-				SStream_concat(O, "$0x%"PRIx64, imm);
+				SStream_concatHex(O, "$0x", imm);
 				break;
 
 			case X86_INS_AND:
@@ -659,10 +659,10 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 			case X86_INS_XOR:
 				// do not print number in negative form
 				if (imm >= 0 && imm <= HEX_THRESHOLD)
-					SStream_concat(O, "$%u", imm);
+					SStream_concatDec(O, "$", imm);
 				else {
 					imm = arch_masks[opsize? opsize : MI->imm_size] & imm;
-					SStream_concat(O, "$0x%"PRIx64, imm);
+					SStream_concatHex(O, "$0x", imm);
 				}
 				break;
 
@@ -670,10 +670,10 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 			case X86_INS_RETF:
 				// RET imm16
 				if (imm >= 0 && imm <= HEX_THRESHOLD)
-					SStream_concat(O, "$%u", imm);
+					SStream_concatDec(O, "$", imm);
 				else {
 					imm = 0xffff & imm;
-					SStream_concat(O, "$0x%x", imm);
+					SStream_concatHex(O, "$0x", imm);
 				}
 				break;
 		}
@@ -749,12 +749,12 @@ static void printMemReference(MCInst *MI, unsigned Op, SStream *O)
 			} else {
 				// only immediate as address of memory
 				if (DispVal < 0) {
-					SStream_concat(O, "0x%"PRIx64, arch_masks[MI->csh->mode] & DispVal);
+					SStream_concatHex(O, "0x", arch_masks[MI->csh->mode] & DispVal);
 				} else {
 					if (DispVal > HEX_THRESHOLD)
-						SStream_concat(O, "0x%"PRIx64, DispVal);
+						SStream_concatHex(O, "0x", DispVal);
 					else
-						SStream_concat(O, "%"PRIu64, DispVal);
+						SStream_concatDec(O, "", DispVal);
 				}
 			}
 		}
@@ -773,7 +773,7 @@ static void printMemReference(MCInst *MI, unsigned Op, SStream *O)
 			if (MI->csh->detail)
 				MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.scale = (int)ScaleVal;
 			if (ScaleVal != 1) {
-				SStream_concat(O, ", %u", ScaleVal);
+				SStream_concatDec(O, ", ", ScaleVal);
 			}
 		}
 
@@ -829,7 +829,8 @@ static void printanymem(MCInst *MI, unsigned OpNo, SStream *O)
 
 static void printRegName(SStream *OS, unsigned RegNo)
 {
-	SStream_concat(OS, "%%%s", getRegisterName(RegNo));
+	SStream_concat1(OS, '%');
+	SStream_concat0(OS, getRegisterName(RegNo));
 }
 
 void X86_ATT_printInst(MCInst *MI, SStream *OS, void *info)
@@ -855,17 +855,6 @@ static bool translateInstruction(MCInst *mcInst, InternalInstruction *insn)
 	return false;
 }
 
-static int reader(const struct reader_info *info, uint8_t *byte, uint64_t address)
-{
-	if (address - info->offset >= info->size)
-		// out of buffer range
-		return -1;
-
-	*byte = info->code[address - info->offset];
-
-	return 0;
-}
-
 // copy x86 detail information from internal structure to public structure
 static void update_pub_insn(cs_insn *pub, InternalInstruction *inter)
 {
@@ -942,14 +931,9 @@ bool X86_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 {
 	cs_struct *handle = (cs_struct *)(uintptr_t)ud;
 	InternalInstruction insn = { 0 };
-	struct reader_info info;
 	int ret;
 	bool result;
 
-	info.code = code;
-	info.size = code_len;
-	info.offset = address;
-
 	if (instr->flat_insn->detail) {
 		// instr->flat_insn->detail initialization: 3 alternatives
 
@@ -970,17 +954,17 @@ bool X86_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 
 	if (handle->mode & CS_MODE_16)
 		ret = decodeInstruction(&insn,
-				reader, &info,
+				code, code_len,
 				address,
 				MODE_16BIT);
 	else if (handle->mode & CS_MODE_32)
 		ret = decodeInstruction(&insn,
-				reader, &info,
+				code, code_len,
 				address,
 				MODE_32BIT);
 	else
 		ret = decodeInstruction(&insn,
-				reader, &info,
+				code, code_len,
 				address,
 				MODE_64BIT);
 
@@ -1030,4 +1014,246 @@ bool X86_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 	}
 }
 
+// properties of the opcodes handled by fast_length()
+#define L_OK	0x001	// opcode is always valid, with the properties below
+#define L_MODRM	0x002	// has ModRM byte
+#define L_MEM	0x004	// ModRM must be a memory operand
+#define L_GROUP	0x008	// validity depends on ModRM.reg or prefixes, see fast_length()
+#define L_IMM8	0x010	// has 1-byte immediate (or rel8)
+#define L_IMM16	0x020	// has 2-byte immediate
+#define L_IMMZ	0x040	// has 2 or 4-byte immediate, depending on operand size
+#define L_IMMV	0x080	// has 2, 4 or 8-byte immediate, depending on operand size
+#define L_NO66	0x100	// 0x66 prefix is not handled, as it changes the immediate size in 64-bit mode
+#define L_NO64	0x200	// invalid, or prefix (REX), in 64-bit mode
+
+#define FN	L_OK
+#define FX	(L_OK | L_NO64)
+#define FB	(L_OK | L_IMM8)
+#define FZ	(L_OK | L_IMMZ)
+#define FV	(L_OK | L_IMMV)
+#define FW	(L_OK | L_IMM16 | L_NO66)
+#define FR	(L_OK | L_IMMZ | L_NO66)
+#define FM	(L_OK | L_MODRM)
+#define FME	(L_OK | L_MODRM | L_MEM)
+#define FMB	(L_OK | L_MODRM | L_IMM8)
+#define FMZ	(L_OK | L_MODRM | L_IMMZ)
+#define FG	(L_OK | L_MODRM | L_GROUP)
+#define FGB	(L_OK | L_MODRM | L_GROUP | L_IMM8)
+#define FGZ	(L_OK | L_MODRM | L_GROUP | L_IMMZ)
+
+// one-byte opcodes of the general purpose instructions found in compiler output
+static const uint16_t fast_onebyte[256] = {
+	/*      0    1    2    3    4    5    6    7    8    9    a    b    c    d    e    f */
+	/* 0 */ FM,   FM,   FM,   FM,   FB,   FZ,   0,    0,    FM,   FM,   FM,   FM,   FB,   FZ,   0,    0,
+	/* 1 */ FM,   FM,   FM,   FM,   FB,   FZ,   0,    0,    FM,   FM,   FM,   FM,   FB,   FZ,   0,    0,
+	/* 2 */ FM,   FM,   FM,   FM,   FB,   FZ,   0,    0,    FM,   FM,   FM,   FM,   FB,   FZ,   0,    0,
+	/* 3 */ FM,   FM,   FM,   FM,   FB,   FZ,   0,    0,    FM,   FM,   FM,   FM,   FB,   FZ,   0,    0,
+	/* 4 */ FX,   FX,   FX,   FX,   FX,   FX,   FX,   FX,   FX,   FX,   FX,   FX,   FX,   FX,   FX,   FX,
+	/* 5 */ FN,   FN,   FN,   FN,   FN,   FN,   FN,   FN,   FN,   FN,   FN,   FN,   FN,   FN,   FN,   FN,
+	/* 6 */ 0,    0,    0,    FG,   0,    0,    0,    0,    FZ,   FMZ,  FB,   FMB,  0,    0,    0,    0,
+	/* 7 */ FB,   FB,   FB,   FB,   FB,   FB,   FB,   FB,   FB,   FB,   FB,   FB,   FB,   FB,   FB,   FB,
+	/* 8 */ FMB,  FMZ,  0,    FMB,  FM,   FM,   FM,   FM,   FM,   FM,   FM,   FM,   0,    FME,  0,    FG,
+	/* 9 */ FN,   FN,   FN,   FN,   FN,   FN,   FN,   FN,   FN,   FN,   0,    0,    FN,   FN,   0,    0,
+	/* a */ 0,    0,    0,    0,    0,    0,    0,    0,    FB,   FZ,   0,    0,    0,    0,    0,    0,
+	/* b */ FB,   FB,   FB,   FB,   FB,   FB,   FB,   FB,   FV,   FV,   FV,   FV,   FV,   FV,   FV,   FV,
+	/* c */ FGB,  FGB,  FW,   FN,   0,    0,    FGB,  FGZ,  0,    FN,   0,    0,    FN,   0,    0,    0,
+	/* d */ FG,   FG,   FG,   FG,   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	/* e */ 0,    0,    0,    0,    0,    0,    0,    0,    FR,   FR,   0,    FB,   0,    0,    0,    0,
+	/* f */ 0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    FG,
+};
+
+// two-byte opcodes (0x0f 0xnn) of the general purpose instructions
+static const uint16_t fast_twobyte[256] = {
+	/*      0    1    2    3    4    5    6    7    8    9    a    b    c    d    e    f */
+	/* 0 */ 0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    FN,   0,    0,    0,    0,
+	/* 1 */ 0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    FG,
+	/* 2 */ 0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	/* 3 */ 0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	/* 4 */ FM,   FM,   FM,   FM,   FM,   FM,   FM,   FM,   FM,   FM,   FM,   FM,   FM,   FM,   FM,   FM,
+	/* 5 */ 0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	/* 6 */ 0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	/* 7 */ 0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	/* 8 */ FR,   FR,   FR,   FR,   FR,   FR,   FR,   FR,   FR,   FR,   FR,   FR,   FR,   FR,   FR,   FR,
+	/* 9 */ FG,   FG,   FG,   FG,   FG,   FG,   FG,   FG,   FG,   FG,   FG,   FG,   FG,   FG,   FG,   FG,
+	/* a */ 0,    0,    FN,   FM,   FMB,  FM,   0,    0,    0,    0,    0,    FM,   FMB,  FM,   0,    FM,
+	/* b */ FM,   FM,   0,    FM,   0,    0,    FM,   FM,   0,    0,    FGB,  FM,   FM,   FM,   FM,   FM,
+	/* c */ FM,   FM,   0,    0,    0,    0,    0,    0,    FN,   FN,   FN,   FN,   FN,   FN,   FN,   FN,
+	/* d */ 0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	/* e */ 0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	/* f */ 0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+};
+
+#undef FN
+#undef FX
+#undef FB
+#undef FZ
+#undef FV
+#undef FW
+#undef FR
+#undef FM
+#undef FME
+#undef FMB
+#undef FMZ
+#undef FG
+#undef FGB
+#undef FGZ
+
+// length of the instruction at @code, for the most common general purpose
+// instructions in 32 & 64-bit mode, without going through the decoder tables.
+// return 0 if this is not one of these instructions, so the decoder must be
+// used instead.
+static unsigned int fast_length(const uint8_t *code, size_t code_len, DisassemblerMode mode)
+{
+	const uint8_t *p = code, *end = code + (code_len < 15 ? code_len : 15);
+	uint16_t props;
+	uint8_t opcode, modrm, reg;
+	bool opsize = false, rexw = false, twobyte = false;
+
+	if (p < end && *p == 0x66) {
+		opsize = true;
+		p++;
+	}
+
+	if (mode == MODE_64BIT && p < end && (*p & 0xf0) == 0x40) {
+		rexw = (*p & 0x08) != 0;
+		p++;
+	}
+
+	if (p >= end)
+		return 0;
+
+	opcode = *p++;
+	if (opcode == 0x0f) {
+		if (p >= end)
+			return 0;
+		opcode = *p++;
+		twobyte = true;
+		props = fast_twobyte[opcode];
+	} else
+		props = fast_onebyte[opcode];
+
+	if (!(props & L_OK))
+		return 0;
+
+	if (mode == MODE_64BIT && (props & L_NO64))
+		return 0;
+
+	if (opsize && (props & L_NO66))
+		return 0;
+
+	if (props & L_MODRM) {
+		if (p >= end)
+			return 0;
+
+		modrm = *p++;
+		reg = (modrm >> 3) & 7;
+
+		if ((props & L_MEM) && (modrm >> 6) == 3)
+			return 0;
+
+		if (props & L_GROUP) {
+			switch (twobyte ? 0x100 | opcode : opcode) {
+				default:
+					// only /0 is valid (or not a general purpose instruction)
+					if (reg)
+						return 0;
+					break;
+				case 0x63:
+					// arpl, or movsxd which needs REX.W in 64-bit mode
+					if (mode == MODE_64BIT && !rexw)
+						return 0;
+					break;
+				case 0xc0: case 0xc1: case 0xd0: case 0xd1: case 0xd2: case 0xd3:
+					// shifts & rotates, except the undocumented /6
+					if (reg == 6)
+						return 0;
+					break;
+				case 0xff:
+					// inc, dec, call, jmp & push; far call & jmp need memory
+					if (reg == 7 || ((reg == 3 || reg == 5) && (modrm >> 6) == 3))
+						return 0;
+					if (mode == MODE_64BIT && opsize && (reg == 2 || reg == 4))
+						return 0;
+					break;
+				case 0x1ba:
+					// bt, bts, btr & btc with immediate
+					if (reg < 4)
+						return 0;
+					break;
+			}
+		}
+
+		if ((modrm >> 6) != 3) {
+			// memory operand, with 32 or 64-bit addressing
+			if ((modrm & 7) == 4) {
+				if (p >= end)
+					return 0;
+				// SIB byte, without base if mod == 0 & base == 5
+				if ((modrm >> 6) == 0 && (*p & 7) == 5)
+					p += 4;
+				p++;
+			}
+
+			switch (modrm >> 6) {
+				case 0:
+					if ((modrm & 7) == 5)
+						p += 4;
+					break;
+				case 1:
+					p += 1;
+					break;
+				case 2:
+					p += 4;
+					break;
+			}
+		}
+	}
+
+	if (props & L_IMM8)
+		p += 1;
+	else if (props & L_IMM16)
+		p += 2;
+	else if (props & L_IMMZ)
+		p += (opsize && !rexw) ? 2 : 4;
+	else if (props & L_IMMV)
+		p += rexw ? 8 : (opsize ? 2 : 4);
+
+	if (p > end)
+		return 0;
+
+	return (unsigned int)(p - code);
+}
+
+// length of the instruction at @code, or 0 if it is invalid.
+// the decoder stops once it has read the operands, and the instruction is not
+// translated into MCInst.
+uint16_t X86_getInsnLength(csh ud, const uint8_t *code, size_t code_len,
+		uint64_t address)
+{
+	cs_struct *handle = (cs_struct *)(uintptr_t)ud;
+	InternalInstruction insn;
+	DisassemblerMode mode;
+	unsigned int length;
+
+	if (handle->mode & CS_MODE_16)
+		mode = MODE_16BIT;
+	else if (handle->mode & CS_MODE_32)
+		mode = MODE_32BIT;
+	else
+		mode = MODE_64BIT;
+
+	if (mode != MODE_16BIT) {
+		length = fast_length(code, code_len, mode);
+		if (length)
+			return (uint16_t)length;
+	}
+
+	memset(&insn, 0, sizeof(insn));
+
+	if (decodeInstruction(&insn, code, code_len, address, mode))
+		return 0;
+
+	return (uint16_t)insn.length;
+}
+
 #endif
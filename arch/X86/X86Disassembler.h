@@ -23,6 +23,9 @@
 bool X86_getInstruction(csh handle, const uint8_t *code, size_t code_len,
 		MCInst *instr, uint16_t *size, uint64_t address, void *info);
 
+uint16_t X86_getInsnLength(csh handle, const uint8_t *code, size_t code_len,
+		uint64_t address);
+
 void X86_init(MCRegisterInfo *MRI);
 
 #endif
@@ -57,6 +57,8 @@ struct ContextDecision {
 };
 
 #ifdef CAPSTONE_X86_REDUCE
+// flat tables are only for the full instruction set
+#undef CAPSTONE_X86_FLAT_TABLES
 #include "X86GenDisassemblerTables_reduce.inc"
 #include "X86GenDisassemblerTables_reduce2.inc"
 #include "X86Lookup16_reduce.inc"
@@ -64,6 +66,10 @@ struct ContextDecision {
 #include "X86GenDisassemblerTables.inc"
 #include "X86GenDisassemblerTables2.inc"
 #include "X86Lookup16.inc"
+#ifdef CAPSTONE_X86_FLAT_TABLES
+// direct-indexed one-byte & 0F maps for legacy contexts
+#include "X86GenDisassemblerTablesFlat.inc"
+#endif
 #endif
 
 /*
@@ -101,10 +107,18 @@ static int modRMRequired(OpcodeType type,
 	switch (type) {
 		default: break;
 		case ONEBYTE:
+#ifdef CAPSTONE_X86_FLAT_TABLES
+			if (insnContext < X86_FLAT_CONTEXTS)
+				return x86DisassemblerFlatOneByteOpcodes[insnContext][opcode].modrm_type != MODRM_ONEENTRY;
+#endif
 			decision = ONEBYTE_SYM;
 			indextable = index_x86DisassemblerOneByteOpcodes;
 			break;
 		case TWOBYTE:
+#ifdef CAPSTONE_X86_FLAT_TABLES
+			if (insnContext < X86_FLAT_CONTEXTS)
+				return x86DisassemblerFlatTwoByteOpcodes[insnContext][opcode].modrm_type != MODRM_ONEENTRY;
+#endif
 			decision = TWOBYTE_SYM;
 			indextable = index_x86DisassemblerTwoByteOpcodes;
 			break;
@@ -165,6 +179,15 @@ static InstrUID decode(OpcodeType type,
 	switch (type) {
 		default: break;	// never reach
 		case ONEBYTE:
+#ifdef CAPSTONE_X86_FLAT_TABLES
+			if (insnContext < X86_FLAT_CONTEXTS) {
+				dec = &x86DisassemblerFlatOneByteOpcodes[insnContext][opcode];
+				// flat tables keep the UID of MODRM_ONEENTRY
+				if (dec->modrm_type == MODRM_ONEENTRY)
+					return dec->instructionIDs;
+				break;
+			}
+#endif
 			// dec = &ONEBYTE_SYM.opcodeDecisions[insnContext].modRMDecisions[opcode];
 			index = index_x86DisassemblerOneByteOpcodes[insnContext];
 			if (index)
@@ -173,6 +196,14 @@ static InstrUID decode(OpcodeType type,
 				dec = &emptyDecision.modRMDecisions[opcode];
 			break;
 		case TWOBYTE:
+#ifdef CAPSTONE_X86_FLAT_TABLES
+			if (insnContext < X86_FLAT_CONTEXTS) {
+				dec = &x86DisassemblerFlatTwoByteOpcodes[insnContext][opcode];
+				if (dec->modrm_type == MODRM_ONEENTRY)
+					return dec->instructionIDs;
+				break;
+			}
+#endif
 			//dec = &TWOBYTE_SYM.opcodeDecisions[insnContext].modRMDecisions[opcode];
 			index = index_x86DisassemblerTwoByteOpcodes[insnContext];
 			if (index)
@@ -269,23 +300,25 @@ static const struct InstructionSpecifier *specifierForUID(InstrUID uid)
 }
 
 /*
- * consumeByte - Uses the reader function provided by the user to consume one
- *   byte from the instruction's memory and advance the cursor.
+ * consumeByte - Consume one byte from the instruction's code buffer and advance
+ *   the cursor.
  *
- * @param insn  - The instruction with the reader function to use.  The cursor
+ * @param insn  - The instruction with the code buffer to read.  The cursor
  *                for this instruction is advanced.
  * @param byte  - A pointer to a pre-allocated memory buffer to be populated
  *                with the data read.
- * @return      - 0 if the read was successful; nonzero otherwise.
+ * @return      - 0 if the read was successful; nonzero if the cursor is past
+ *                the end of the buffer.
  */
 static int consumeByte(struct InternalInstruction* insn, uint8_t* byte)
 {
-	int ret = insn->reader(insn->readerArg, byte, insn->readerCursor);
+	if (insn->readerCursor - insn->startLocation >= insn->codeSize)
+		return -1;
 
-	if (!ret)
-		++(insn->readerCursor);
+	*byte = insn->code[insn->readerCursor - insn->startLocation];
+	++(insn->readerCursor);
 
-	return ret;
+	return 0;
 }
 
 /*
@@ -297,7 +330,12 @@ static int consumeByte(struct InternalInstruction* insn, uint8_t* byte)
  */
 static int lookAtByte(struct InternalInstruction* insn, uint8_t* byte)
 {
-	return insn->reader(insn->readerArg, byte, insn->readerCursor);
+	if (insn->readerCursor - insn->startLocation >= insn->codeSize)
+		return -1;
+
+	*byte = insn->code[insn->readerCursor - insn->startLocation];
+
+	return 0;
 }
 
 static void unconsumeByte(struct InternalInstruction* insn)
@@ -309,24 +347,22 @@ static void unconsumeByte(struct InternalInstruction* insn)
   static int name(struct InternalInstruction* insn, type* ptr) {  \
     type combined = 0;                                            \
     unsigned offset;                                              \
-    for (offset = 0; offset < sizeof(type); ++offset) {           \
-      uint8_t byte;                                               \
-      int ret = insn->reader(insn->readerArg,                     \
-                             &byte,                               \
-                             insn->readerCursor + offset);        \
-      if (ret)                                                    \
-        return ret;                                               \
-      combined = combined | ((uint64_t)byte << (offset * 8));     \
-    }                                                             \
+    const uint8_t *p;                                             \
+    if (insn->readerCursor - insn->startLocation > insn->codeSize || \
+        insn->codeSize - (insn->readerCursor - insn->startLocation) \
+        < sizeof(type))                                           \
+      return -1;                                                  \
+    p = insn->code + (insn->readerCursor - insn->startLocation);  \
+    for (offset = 0; offset < sizeof(type); ++offset)             \
+      combined = combined | ((uint64_t)p[offset] << (offset * 8)); \
     *ptr = combined;                                              \
     insn->readerCursor += sizeof(type);                           \
     return 0;                                                     \
   }
 
 /*
- * consume* - Use the reader function provided by the user to consume data
- *   values of various sizes from the instruction's memory and advance the
- *   cursor appropriately.  These readers perform endian conversion.
+ * consume* - Consume data values of various sizes from the instruction's code
+ *   buffer and advance the cursor appropriately.  These readers perform endian conversion.
  *
  * @param insn    - See consumeByte().
  * @param ptr     - A pointer to a pre-allocated memory of appropriate size to
@@ -2310,25 +2346,23 @@ static bool checkPrefix(struct InternalInstruction *insn)
  *
  * @param insn      - A pointer to the instruction to be populated.  Must be
  *                    pre-allocated.
- * @param reader    - The function to be used to read the instruction's bytes.
- * @param readerArg - A generic argument to be passed to the reader to store
- *                    any internal state.
- * @param startLoc  - The address (in the reader's address space) of the first
- *                    byte in the instruction.
+ * @param code      - The buffer of the instruction's bytes.
+ * @param size      - The number of bytes in the buffer.
+ * @param startLoc  - The address of the first byte in the instruction.
  * @param mode      - The mode (real mode, IA-32e, or IA-32e in 64-bit mode) to
  *                    decode the instruction in.
  * @return          - 0 if instruction is valid; nonzero if not.
  */
 int decodeInstruction(struct InternalInstruction *insn,
-		byteReader_t reader,
-		const void *readerArg,
+		const uint8_t *code,
+		uint64_t size,
 		uint64_t startLoc,
 		DisassemblerMode mode)
 {
-	insn->reader = reader;
-	insn->readerArg = readerArg;
 	insn->startLocation = startLoc;
 	insn->readerCursor = startLoc;
+	insn->code = code;
+	insn->codeSize = size;
 	insn->mode = mode;
 	insn->numImmediatesConsumed = 0;
 
@@ -307,6 +307,13 @@ static bool need_zero_prefix(uint64_t imm)
 		return true;
 }
 
+// print @imm in MASM hex form, such as 0A123h
+static void printHexMasm(SStream *O, const char *prefix, uint64_t imm)
+{
+	SStream_concatHex(O, prefix, imm);
+	SStream_concat1(O, 'h');
+}
+
 static void printImm(MCInst *MI, SStream *O, int64_t imm, bool positive)
 {
 	if (positive) {
@@ -332,17 +339,17 @@ static void printImm(MCInst *MI, SStream *O, int64_t imm, bool positive)
 				if (imm == 0x8000000000000000LL)  // imm == -imm
 					SStream_concat0(O, "8000000000000000h");
 				else if (need_zero_prefix(imm))
-					SStream_concat(O, "0%"PRIx64"h", imm);
+					printHexMasm(O, "0", imm);
 				else
-					SStream_concat(O, "%"PRIx64"h", imm);
+					printHexMasm(O, "", imm);
 			} else {
 				if (imm > HEX_THRESHOLD) {
 					if (need_zero_prefix(imm))
-						SStream_concat(O, "0%"PRIx64"h", imm);
+						printHexMasm(O, "0", imm);
 					else
-						SStream_concat(O, "%"PRIx64"h", imm);
+						printHexMasm(O, "", imm);
 				} else
-					SStream_concat(O, "%"PRIu64, imm);
+					SStream_concatDec(O, "", imm);
 			}
 		} else {	// Intel syntax
 			if (imm < 0) {
@@ -362,12 +369,12 @@ static void printImm(MCInst *MI, SStream *O, int64_t imm, bool positive)
 					}
 				}
 
-				SStream_concat(O, "0x%"PRIx64, imm);
+				SStream_concatHex(O, "0x", imm);
 			} else {
 				if (imm > HEX_THRESHOLD)
-					SStream_concat(O, "0x%"PRIx64, imm);
+					SStream_concatHex(O, "0x", imm);
 				else
-					SStream_concat(O, "%"PRIu64, imm);
+					SStream_concatDec(O, "", imm);
 			}
 		}
 	} else {
@@ -377,34 +384,34 @@ static void printImm(MCInst *MI, SStream *O, int64_t imm, bool positive)
 					SStream_concat0(O, "8000000000000000h");
 				else if (imm < -HEX_THRESHOLD) {
 					if (need_zero_prefix(imm))
-						SStream_concat(O, "-0%"PRIx64"h", -imm);
+						printHexMasm(O, "-0", -imm);
 					else
-						SStream_concat(O, "-%"PRIx64"h", -imm);
+						printHexMasm(O, "-", -imm);
 				} else
-					SStream_concat(O, "-%"PRIu64, -imm);
+					SStream_concatDec(O, "-", -imm);
 			} else {
 				if (imm > HEX_THRESHOLD) {
 					if (need_zero_prefix(imm))
-						SStream_concat(O, "0%"PRIx64"h", imm);
+						printHexMasm(O, "0", imm);
 					else
-						SStream_concat(O, "%"PRIx64"h", imm);
+						printHexMasm(O, "", imm);
 				} else
-					SStream_concat(O, "%"PRIu64, imm);
+					SStream_concatDec(O, "", imm);
 			}
 		} else {	// Intel syntax
 			if (imm < 0) {
 				if (imm == 0x8000000000000000LL)  // imm == -imm
 					SStream_concat0(O, "0x8000000000000000");
 				else if (imm < -HEX_THRESHOLD)
-					SStream_concat(O, "-0x%"PRIx64, -imm);
+					SStream_concatHex(O, "-0x", -imm);
 				else
-					SStream_concat(O, "-%"PRIu64, -imm);
+					SStream_concatDec(O, "-", -imm);
 
 			} else {
 				if (imm > HEX_THRESHOLD)
-					SStream_concat(O, "0x%"PRIx64, imm);
+					SStream_concatHex(O, "0x", imm);
 				else
-					SStream_concat(O, "%"PRIu64, imm);
+					SStream_concatDec(O, "", imm);
 			}
 		}
 	}
@@ -977,7 +984,7 @@ static void printMemReference(MCInst *MI, unsigned Op, SStream *O)
 		if (NeedPlus) SStream_concat0(O, " + ");
 		_printOperand(MI, Op + X86_AddrIndexReg, O);
 		if (ScaleVal != 1)
-			SStream_concat(O, "*%u", ScaleVal);
+			SStream_concatDec(O, "*", ScaleVal);
 		NeedPlus = true;
 	}
 
@@ -1019,18 +1019,18 @@ void X86_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
 		if (h->detail) {
 #ifndef CAPSTONE_DIET
 			memcpy(insn->detail->regs_read, insns[i].regs_use, sizeof(insns[i].regs_use));
-			insn->detail->regs_read_count = (uint8_t)count_positive(insns[i].regs_use);
+			insn->detail->regs_read_count = insns[i].regs_use_count;
 
 			// special cases when regs_write[] depends on arch
 			switch(id) {
 				default:
 					memcpy(insn->detail->regs_write, insns[i].regs_mod, sizeof(insns[i].regs_mod));
-					insn->detail->regs_write_count = (uint8_t)count_positive(insns[i].regs_mod);
+					insn->detail->regs_write_count = insns[i].regs_mod_count;
 					break;
 				case X86_RDTSC:
 					if (h->mode == CS_MODE_64) {
 						memcpy(insn->detail->regs_write, insns[i].regs_mod, sizeof(insns[i].regs_mod));
-						insn->detail->regs_write_count = (uint8_t)count_positive(insns[i].regs_mod);
+						insn->detail->regs_write_count = insns[i].regs_mod_count;
 					} else {
 						insn->detail->regs_write[0] = X86_REG_EAX;
 						insn->detail->regs_write[1] = X86_REG_EDX;
@@ -1040,7 +1040,7 @@ void X86_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
 				case X86_RDTSCP:
 					if (h->mode == CS_MODE_64) {
 						memcpy(insn->detail->regs_write, insns[i].regs_mod, sizeof(insns[i].regs_mod));
-						insn->detail->regs_write_count = (uint8_t)count_positive(insns[i].regs_mod);
+						insn->detail->regs_write_count = insns[i].regs_mod_count;
 					} else {
 						insn->detail->regs_write[0] = X86_REG_EAX;
 						insn->detail->regs_write[1] = X86_REG_ECX;
@@ -1173,7 +1173,7 @@ void X86_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
 			}
 
 			memcpy(insn->detail->groups, insns[i].groups, sizeof(insns[i].groups));
-			insn->detail->groups_count = (uint8_t)count_positive8(insns[i].groups);
+			insn->detail->groups_count = insns[i].groups_count;
 
 			if (insns[i].branch || insns[i].indirect_branch) {
 				// this insn also belongs to JUMP group. add JUMP group
@@ -1867,11 +1867,11 @@ bool X86_lockrep(MCInst *MI, SStream *O)
 		case 0xf0:
 #ifndef CAPSTONE_DIET
 			if (MI->xAcquireRelease == 0xf2)
-				SStream_concat(O, "xacquire|lock|");
+				SStream_concat0(O, "xacquire|lock|");
 			else if (MI->xAcquireRelease == 0xf3)
-				SStream_concat(O, "xrelease|lock|");
+				SStream_concat0(O, "xrelease|lock|");
 			else
-				SStream_concat(O, "lock|");
+				SStream_concat0(O, "lock|");
 #endif
 			break;
 		case 0xf2:	// repne
@@ -1879,12 +1879,12 @@ bool X86_lockrep(MCInst *MI, SStream *O)
 
 #ifndef CAPSTONE_DIET	// only care about memonic in standard (non-diet) mode
 			if (xchg_mem(opcode) && MI->xAcquireRelease) {
-				SStream_concat(O, "xacquire|");
+				SStream_concat0(O, "xacquire|");
 			} else if (valid_repne(MI->csh, opcode)) {
-				SStream_concat(O, "repne|");
+				SStream_concat0(O, "repne|");
 				add_cx(MI);
 			} else if (valid_bnd(MI->csh, opcode)) {
-				SStream_concat(O, "bnd|");
+				SStream_concat0(O, "bnd|");
 			} else {
 				// invalid prefix
 				MI->x86_prefix[0] = 0;
@@ -1920,12 +1920,12 @@ bool X86_lockrep(MCInst *MI, SStream *O)
 
 #ifndef CAPSTONE_DIET	// only care about memonic in standard (non-diet) mode
 			if (xchg_mem(opcode) && MI->xAcquireRelease) {
-				SStream_concat(O, "xrelease|");
+				SStream_concat0(O, "xrelease|");
 			} else if (valid_rep(MI->csh, opcode)) {
-				SStream_concat(O, "rep|");
+				SStream_concat0(O, "rep|");
 				add_cx(MI);
 			} else if (valid_repe(MI->csh, opcode)) {
-				SStream_concat(O, "repe|");
+				SStream_concat0(O, "repe|");
 				add_cx(MI);
 			} else {
 				// invalid prefix
@@ -2085,6 +2085,7 @@ void X86_reg_access(const cs_insn *insn,
 {
 	uint8_t i;
 	uint8_t read_count, write_count;
+	cs_regs_bitset read_bits, write_bits;
 	cs_x86 *x86 = &(insn->detail->x86);
 
 	read_count = insn->detail->regs_read_count;
@@ -2093,17 +2094,19 @@ void X86_reg_access(const cs_insn *insn,
 	// implicit registers
 	memcpy(regs_read, insn->detail->regs_read, read_count * sizeof(insn->detail->regs_read[0]));
 	memcpy(regs_write, insn->detail->regs_write, write_count * sizeof(insn->detail->regs_write[0]));
+	regs_bitset_fill(read_bits, regs_read, read_count);
+	regs_bitset_fill(write_bits, regs_write, write_count);
 
 	// explicit registers
 	for (i = 0; i < x86->op_count; i++) {
 		cs_x86_op *op = &(x86->operands[i]);
 		switch((int)op->type) {
 			case X86_OP_REG:
-				if ((op->access & CS_AC_READ) && !arr_exist(regs_read, read_count, op->reg)) {
+				if ((op->access & CS_AC_READ) && regs_bitset_add(read_bits, op->reg)) {
 					regs_read[read_count] = op->reg;
 					read_count++;
 				}
-				if ((op->access & CS_AC_WRITE) && !arr_exist(regs_write, write_count, op->reg)) {
+				if ((op->access & CS_AC_WRITE) && regs_bitset_add(write_bits, op->reg)) {
 					regs_write[write_count] = op->reg;
 					write_count++;
 				}
@@ -2111,14 +2114,15 @@ void X86_reg_access(const cs_insn *insn,
 			case X86_OP_MEM:
 				// registers appeared in memory references always being read
 				if ((op->mem.segment != X86_REG_INVALID)) {
+					regs_bitset_add(read_bits, op->mem.segment);
 					regs_read[read_count] = op->mem.segment;
 					read_count++;
 				}
-				if ((op->mem.base != X86_REG_INVALID) && !arr_exist(regs_read, read_count, op->mem.base)) {
+				if ((op->mem.base != X86_REG_INVALID) && regs_bitset_add(read_bits, op->mem.base)) {
 					regs_read[read_count] = op->mem.base;
 					read_count++;
 				}
-				if ((op->mem.index != X86_REG_INVALID) && !arr_exist(regs_read, read_count, op->mem.index)) {
+				if ((op->mem.index != X86_REG_INVALID) && regs_bitset_add(read_bits, op->mem.index)) {
 					regs_read[read_count] = op->mem.index;
 					read_count++;
 				}
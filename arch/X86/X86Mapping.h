@@ -18,6 +18,9 @@ typedef struct insn_map_x86 {
 	unsigned char groups[8]; // list of group this instruction belong to
 	bool branch;	// branch instruction?
 	bool indirect_branch;	// indirect branch instruction?
+	unsigned char regs_use_count;	// number of registers in regs_use[]
+	unsigned char regs_mod_count;	// number of registers in regs_mod[]
+	unsigned char groups_count;	// number of groups in groups[]
 #endif
 } insn_map_x86;
 
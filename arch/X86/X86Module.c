@@ -22,6 +22,7 @@ cs_err X86_global_init(cs_struct *ud)
 	ud->syntax = CS_OPT_SYNTAX_INTEL;
 	ud->printer_info = mri;
 	ud->disasm = X86_getInstruction;
+	ud->insn_length = X86_getInsnLength;
 	ud->reg_name = X86_reg_name;
 	ud->insn_id = X86_get_insn_id;
 	ud->insn_name = X86_insn_name;
@@ -8,6 +8,7 @@ if _python2:
 __all__ = [
     'Cs',
     'CsInsn',
+    'CsColumns',
 
     'cs_disasm_quick',
     'cs_disasm_lite',
@@ -239,6 +240,11 @@ CS_OPT_SKIPDATA = 5  # Skip data when disassembling
 CS_OPT_SKIPDATA_SETUP = 6      # Setup user-defined function for SKIPDATA option
 CS_OPT_MNEMONIC = 7  # Customize instruction mnemonic
 CS_OPT_UNSIGNED = 8  # Print immediate in unsigned form
+CS_OPT_NO_TEXT = 9  # Do not render mnemonic & op_str
+CS_OPT_COMPACT_DETAIL = 10  # Size detail of each instruction to its operands
+CS_OPT_MEM_CTX = 11  # User-defined dynamic memory functions of one handle
+CS_OPT_ARENA = 12  # Allocate details of one disasm() call in a few blocks
+CS_OPT_REGS_BITSET = 13  # Compute register bitsets of each instruction while decoding it
 
 # Capstone option value
 CS_OPT_OFF = 0             # Turn OFF an option - default option of CS_OPT_DETAIL
@@ -390,6 +396,11 @@ class _cs_arch(ctypes.Union):
         ('riscv', riscv.CsRISCV),
     )
 
+# bitset of registers, with CS_REGS_BITSET_WORDS words
+CS_REGS_BITSET_WORDS = 6
+
+_cs_regs_bitset = ctypes.c_uint64 * CS_REGS_BITSET_WORDS
+
 class _cs_detail(ctypes.Structure):
     _fields_ = (
         ('regs_read', ctypes.c_uint16 * 16),
@@ -398,6 +409,7 @@ class _cs_detail(ctypes.Structure):
         ('regs_write_count', ctypes.c_ubyte),
         ('groups', ctypes.c_ubyte * 8),
         ('groups_count', ctypes.c_ubyte),
+        ('regs_bitset', ctypes.c_ubyte),
         ('arch', _cs_arch),
     )
 
@@ -422,6 +434,34 @@ class _cs_opt_skipdata(ctypes.Structure):
         ('user_data', ctypes.c_void_p),
     )
 
+class _cs_columns(ctypes.Structure):
+    _fields_ = (
+        ('count', ctypes.c_size_t),
+        ('address', ctypes.POINTER(ctypes.c_uint64)),
+        ('size', ctypes.POINTER(ctypes.c_uint16)),
+        ('id', ctypes.POINTER(ctypes.c_uint)),
+        ('groups', ctypes.POINTER(ctypes.c_uint64)),
+        ('text', ctypes.POINTER(ctypes.c_char)),
+        ('text_size', ctypes.c_size_t),
+        ('mnemonic', ctypes.POINTER(ctypes.c_size_t)),
+        ('op_str', ctypes.POINTER(ctypes.c_size_t)),
+        ('op_count', ctypes.POINTER(ctypes.c_uint8)),
+        ('op_first', ctypes.POINTER(ctypes.c_uint32)),
+        ('op_total', ctypes.c_size_t),
+        ('op_type', ctypes.POINTER(ctypes.c_uint8)),
+        ('op_access', ctypes.POINTER(ctypes.c_uint8)),
+        ('op_reg', ctypes.POINTER(ctypes.c_uint16)),
+        ('op_mem_index', ctypes.POINTER(ctypes.c_uint16)),
+        ('op_imm', ctypes.POINTER(ctypes.c_int64)),
+    )
+
+# convert a register bitset to an integer, with bit r set for register r
+def _regs_bitset_int(bits):
+    v = 0
+    for i in range(CS_REGS_BITSET_WORDS):
+        v |= bits[i] << (64 * i)
+    return v
+
 class _cs_opt_mnem(ctypes.Structure):
     _fields_ = (
         ('id', ctypes.c_uint),
@@ -442,6 +482,7 @@ _setup_prototype(_cs, "cs_reg_name", ctypes.c_char_p, ctypes.c_size_t, ctypes.c_
 _setup_prototype(_cs, "cs_insn_name", ctypes.c_char_p, ctypes.c_size_t, ctypes.c_uint)
 _setup_prototype(_cs, "cs_group_name", ctypes.c_char_p, ctypes.c_size_t, ctypes.c_uint)
 _setup_prototype(_cs, "cs_op_count", ctypes.c_int, ctypes.c_size_t, ctypes.POINTER(_cs_insn), ctypes.c_uint)
+_setup_prototype(_cs, "cs_detail_size", ctypes.c_size_t, ctypes.c_size_t, ctypes.POINTER(_cs_insn))
 _setup_prototype(_cs, "cs_op_index", ctypes.c_int, ctypes.c_size_t, ctypes.POINTER(_cs_insn), ctypes.c_uint, ctypes.c_uint)
 _setup_prototype(_cs, "cs_errno", ctypes.c_int, ctypes.c_size_t)
 _setup_prototype(_cs, "cs_option", ctypes.c_int, ctypes.c_size_t, ctypes.c_int, ctypes.c_void_p)
@@ -449,6 +490,10 @@ _setup_prototype(_cs, "cs_version", ctypes.c_int, ctypes.POINTER(ctypes.c_int),
 _setup_prototype(_cs, "cs_support", ctypes.c_bool, ctypes.c_int)
 _setup_prototype(_cs, "cs_strerror", ctypes.c_char_p, ctypes.c_int)
 _setup_prototype(_cs, "cs_regs_access", ctypes.c_int, ctypes.c_size_t, ctypes.POINTER(_cs_insn), ctypes.POINTER(ctypes.c_uint16*64), ctypes.POINTER(ctypes.c_uint8), ctypes.POINTER(ctypes.c_uint16*64), ctypes.POINTER(ctypes.c_uint8))
+_setup_prototype(_cs, "cs_regs_access_bitset", ctypes.c_int, ctypes.c_size_t, ctypes.POINTER(_cs_insn), ctypes.POINTER(_cs_regs_bitset), ctypes.POINTER(_cs_regs_bitset))
+_setup_prototype(_cs, "cs_disasm_columns", ctypes.c_size_t, ctypes.c_size_t, ctypes.POINTER(ctypes.c_char), ctypes.c_size_t, \
+        ctypes.c_uint64, ctypes.c_size_t, ctypes.POINTER(ctypes.POINTER(_cs_columns)))
+_setup_prototype(_cs, "cs_free_columns", None, ctypes.POINTER(_cs_columns))
 
 
 # access to error code via @errno of CsError
@@ -577,9 +622,13 @@ class CsInsn(object):
         self._raw = copy_ctypes(all_info)
         self._cs = cs
         if self._cs._detail and self._raw.id != 0:
-            # save detail
-            self._raw.detail = ctypes.pointer(all_info.detail._type_())
-            ctypes.memmove(ctypes.byref(self._raw.detail[0]), ctypes.byref(all_info.detail[0]), ctypes.sizeof(type(all_info.detail[0])))
+            # save detail. with CS_OPT_COMPACT_DETAIL, it can be smaller than
+            # cs_detail, so only copy its own bytes & leave the rest zeroed.
+            # with CS_OPT_REGS_BITSET, it is larger, with the register bitsets
+            size = _cs.cs_detail_size(self._cs.csh, ctypes.byref(all_info))
+            self._detail_buf = ctypes.create_string_buffer(max(size, ctypes.sizeof(_cs_detail)))
+            ctypes.memmove(self._detail_buf, ctypes.byref(all_info.detail[0]), size)
+            self._raw.detail = ctypes.cast(self._detail_buf, ctypes.POINTER(_cs_detail))
 
     def __repr__(self):
         return '<CsInsn 0x%x [%s]: %s %s>' % (self.address, self.bytes.hex(), self.mnemonic, self.op_str)
@@ -844,6 +893,118 @@ class CsInsn(object):
 
         return (regs_read, regs_write)
 
+    # Return (registers-read, registers-modified) by this instructions as
+    # bitsets: register r is in a set if bit r of this integer is set.
+    # This includes all the implicit & explicit registers.
+    def regs_access_bitset(self):
+        if self._raw.id == 0:
+            raise CsError(CS_ERR_SKIPDATA)
+
+        regs_read = _cs_regs_bitset()
+        regs_write = _cs_regs_bitset()
+
+        status = _cs.cs_regs_access_bitset(self._cs.csh, self._raw, ctypes.byref(regs_read), ctypes.byref(regs_write))
+        if status != CS_ERR_OK:
+            raise CsError(status)
+
+        return (_regs_bitset_int(regs_read), _regs_bitset_int(regs_write))
+
+
+# owner of the native memory of CsColumns, referenced by all the columns,
+# so this memory is freed only when no column is used anymore
+class _CsColumnsMemory(object):
+    def __init__(self, raw):
+        self._raw = raw
+
+    def __del__(self):
+        try:
+            _cs.cs_free_columns(self._raw)
+        except: # _cs might be pulled from under our feet
+            pass
+
+
+# number of 64-bit words of the group bitset of each instruction in CsColumns
+CS_COLUMN_GROUP_WORDS = 4
+
+# Instructions in columns, as returned by Cs.disasm_columns().
+# Each column is a memoryview over the native memory, without any copy nor
+# Python object per instruction, so it can be wrapped by numpy.asarray().
+# Columns which are not available are None.
+class CsColumns(object):
+    def __init__(self, raw=None):
+        if raw:
+            cols = raw.contents
+            mem = _CsColumnsMemory(raw)
+            self.count, self.op_total = cols.count, cols.op_total
+        else:
+            cols = _cs_columns()
+            mem = None
+            self.count, self.op_total = 0, 0
+
+        # instruction columns
+        self.address = self._column(mem, cols.address, self.count)
+        self.size = self._column(mem, cols.size, self.count)
+        self.id = self._column(mem, cols.id, self.count)
+        # group bitsets of CS_COLUMN_GROUP_WORDS words per instruction (detail mode)
+        self.groups = self._column(mem, cols.groups, self.count * CS_COLUMN_GROUP_WORDS)
+        # offsets of the text of each instruction in the text column
+        self.text = self._column(mem, cols.text, cols.text_size)
+        self.mnemonic = self._column(mem, cols.mnemonic, self.count)
+        self.op_str = self._column(mem, cols.op_str, self.count)
+        # operands of instruction i are at indexes op_first[i] to op_first[i + 1] - 1
+        # of operand columns. these are only available in detail mode.
+        self.op_count = self._column(mem, cols.op_count, self.count)
+        self.op_first = self._column(mem, cols.op_first, self.count + 1 if raw else 0)
+
+        # operand columns
+        self.op_type = self._column(mem, cols.op_type, self.op_total)
+        self.op_access = self._column(mem, cols.op_access, self.op_total)
+        self.op_reg = self._column(mem, cols.op_reg, self.op_total)
+        self.op_mem_index = self._column(mem, cols.op_mem_index, self.op_total)
+        self.op_imm = self._column(mem, cols.op_imm, self.op_total)
+
+    # view @count elements of native array @ptr, or None if @ptr is NULL
+    @staticmethod
+    def _column(mem, ptr, count):
+        ctype = ptr._type_
+        if mem and not ptr:
+            return None
+        if count:
+            array = (ctype * count).from_address(ctypes.addressof(ptr.contents))
+            array._mem = mem
+        else:
+            array = (ctype * 0)()
+        if _python2:
+            # no memoryview.cast(), but the ctypes array can be indexed as well
+            return array
+        # cast to the native format, so the view can be indexed from Python
+        return memoryview(array).cast('B').cast(ctype._type_)
+
+    def __len__(self):
+        return self.count
+
+    # indexes of the operands of instruction @i in operand columns
+    def operands(self, i):
+        return range(self.op_first[i], self.op_first[i + 1])
+
+    # does instruction @i belong to group @group_id? (detail mode)
+    def group(self, i, group_id):
+        return bool((self.groups[i * CS_COLUMN_GROUP_WORDS + group_id // 64] >> (group_id % 64)) & 1)
+
+    # read the null-terminated string at @offset of the text column.
+    # mnemonic & op_str of cs_insn are at most 32 + 160 bytes.
+    def _string(self, offset):
+        text = bytes(self.text[offset:offset + 192])
+        return text[:text.index(b'\0')].decode('ascii')
+
+    # mnemonic of instruction @i, unless CS_OPT_NO_TEXT is on
+    def insn_mnemonic(self, i):
+        return self._string(self.mnemonic[i])
+
+    # operand string of instruction @i, unless CS_OPT_NO_TEXT is on
+    def insn_op_str(self, i):
+        return self._string(self.op_str[i])
+
 
 
 class Cs(object):
@@ -1129,6 +1290,25 @@ class Cs(object):
             yield
 
 
+    # Disassemble binary & return disassembled instructions in a CsColumns object,
+    # with a single native call. This is the fastest way to get many instructions,
+    # as there is no Python object per instruction. Operands need detail mode.
+    def disasm_columns(self, code, offset, count=0):
+        all_columns = ctypes.POINTER(_cs_columns)()
+        size = len(code)
+        # Pass a bytearray by reference
+        if isinstance(code, bytearray):
+            code = ctypes.byref(ctypes.c_char.from_buffer(code))
+        res = _cs.cs_disasm_columns(self.csh, code, size, offset, count, ctypes.byref(all_columns))
+        if res > 0:
+            return CsColumns(all_columns)
+
+        status = _cs.cs_errno(self.csh)
+        if status != CS_ERR_OK:
+            raise CsError(status)
+        return CsColumns()
+
+
     # Light function to disassemble binary. This is about 20% faster than disasm() because
     # unlike disasm(), disasm_lite() only return tuples of (address, size, mnemonic, op_str),
     # rather than CsInsn objects.
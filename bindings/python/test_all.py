@@ -2,7 +2,7 @@
 
 import test_basic, test_arm, test_arm64, test_detail, test_lite, test_m68k, test_mips, \
     test_ppc, test_x86, test_skipdata, test_sparc, test_systemz, test_tms320c64x, test_customized_mnem, \
-    test_m680x, test_mos65xx, test_xcore, test_riscv
+    test_m680x, test_mos65xx, test_xcore, test_riscv, test_columns
 
 test_basic.test_class()
 test_arm.test_class()
@@ -22,3 +22,4 @@ test_skipdata.test_class()
 test_customized_mnem.test()
 test_xcore.test_class()
 test_riscv.test_class()
+test_columns.test_class()
@@ -0,0 +1,75 @@
+#!/usr/bin/env python
+
+# Capstone Python bindings, by Nguyen Anh Quynnh <aquynh@gmail.com>
+
+from __future__ import print_function
+from capstone import *
+from xprint import to_hex
+
+
+X86_CODE64 = b"\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff\x48\x8b\x44\x8b\x10"
+ARM64_CODE = b"\x21\x7c\x02\x9b\x21\x7c\x00\x53\x00\x40\x21\x4b\xe1\x0b\x40\xb9\x20\x04\x81\xda\x20\x08\x02\x8b"
+
+all_tests = (
+        (CS_ARCH_X86, CS_MODE_64, X86_CODE64, "X86 64 (Intel syntax)"),
+        (CS_ARCH_ARM64, CS_MODE_ARM, ARM64_CODE, "ARM-64"),
+        )
+
+
+def print_columns(md, cols):
+    for i in range(len(cols)):
+        print("0x%x:\t%u bytes\t%s\t%s" % (cols.address[i], cols.size[i],
+            cols.insn_mnemonic(i), cols.insn_op_str(i)))
+
+        for j in cols.operands(i):
+            print("\t\top[%u]: type %u" % (j - cols.op_first[i], cols.op_type[j]), end="")
+            if cols.op_reg[j]:
+                print(", reg %s" % md.reg_name(cols.op_reg[j]), end="")
+            if cols.op_mem_index[j]:
+                print(", index %s" % md.reg_name(cols.op_mem_index[j]), end="")
+            if cols.op_imm[j]:
+                print(", imm 0x%x" % (cols.op_imm[j] & 0xffffffffffffffff), end="")
+            if cols.op_access[j] & CS_AC_READ:
+                print(", read", end="")
+            if cols.op_access[j] & CS_AC_WRITE:
+                print(", write", end="")
+            print()
+
+        print("\t\tgroups:", end="")
+        for g in range(1, 256):
+            if cols.group(i, g):
+                print(" %s" % md.group_name(g), end="")
+        print()
+    print()
+
+
+# ## Test class Cs
+def test_class():
+    for (arch, mode, code, comment) in all_tests:
+        print("*" * 16)
+        print("Platform: %s" % comment)
+        print("Code: %s" % to_hex(code))
+        print("Disasm:")
+
+        try:
+            md = Cs(arch, mode)
+            md.detail = True
+
+            ref = list(md.disasm(code, 0x1000))
+            cols = md.disasm_columns(code, 0x1000)
+
+            if len(cols) != len(ref) or \
+                    list(cols.address) != [insn.address for insn in ref] or \
+                    list(cols.id) != [insn.id for insn in ref] or \
+                    [cols.insn_op_str(i) for i in range(len(cols))] != [insn.op_str for insn in ref] or \
+                    list(cols.op_count) != [len(insn.operands) for insn in ref]:
+                print("ERROR: columns do not match disasm()")
+                return
+
+            print_columns(md, cols)
+        except CsError as e:
+            print("ERROR: %s" % e)
+
+
+if __name__ == '__main__':
+    test_class()
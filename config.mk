@@ -18,6 +18,15 @@ CAPSTONE_ARCHS ?= arm aarch64 m68k mips powerpc sparc systemz x86 xcore tms320c6
 CAPSTONE_USE_SYS_DYN_MEM ?= yes
 
 
+################################################################################
+# Change 'CAPSTONE_USE_THREADS = yes' to 'CAPSTONE_USE_THREADS = no' if do NOT
+# let cs_disasm_parallel() decode large buffers with multiple threads (pthreads).
+# Then cs_disasm_parallel() disassembles sequentially like cs_disasm().
+# This is always off with CAPSTONE_HAS_OSXKERNEL = yes.
+
+CAPSTONE_USE_THREADS ?= yes
+
+
 ################################################################################
 # Change 'CAPSTONE_DIET = no' to 'CAPSTONE_DIET = yes' to make the library
 # more compact: use less memory & smaller in binary size.
@@ -55,6 +64,15 @@ CAPSTONE_DIET ?= no
 
 CAPSTONE_X86_REDUCE ?= no
 
+################################################################################
+# Change 'CAPSTONE_X86_FLAT_TABLES = no' to 'CAPSTONE_X86_FLAT_TABLES = yes' to
+# decode the one-byte & 0F opcode maps of X86 with direct-indexed tables.
+# This is experimental: it adds ~50KB to the binary, and no speedup over the
+# default tables has been measured yet (see suite/benchmark/README.md).
+# This is ignored when CAPSTONE_X86_REDUCE = yes.
+
+CAPSTONE_X86_FLAT_TABLES ?= no
+
 ################################################################################
 # Change 'CAPSTONE_X86_ATT_DISABLE = no' to 'CAPSTONE_X86_ATT_DISABLE = yes' to
 # disable AT&T syntax on x86 to reduce library size.
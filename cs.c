@@ -19,6 +19,14 @@
 #include "utils.h"
 #include "MCRegisterInfo.h"
 
+#ifdef CAPSTONE_HAS_THREADS
+#if defined (WIN32) || defined (WIN64) || defined (_WIN32) || defined (_WIN64)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#endif
+
 #if defined(_KERNEL_MODE)
 #include "windows\winkernel_mm.h"
 #endif
@@ -45,6 +53,21 @@
 #define INSN_CACHE_SIZE 8
 #endif
 
+// size of the window of input buffered by cs_disasm_stream()
+#define STREAM_WINDOW_SIZE (64 * 1024)
+// no instruction is longer than this (EVM PUSH32 has 33 bytes), so this many
+// bytes must be in the window to decode an instruction, unless at the end of input
+#define STREAM_MAX_INSN_SIZE 64
+
+// size of the first block of details allocated by cs_disasm() with CS_OPT_ARENA.
+// each following block doubles the size of the previous one
+#define ARENA_MIN_BLOCK (64 * 1024)
+
+// max number of threads used by cs_disasm_parallel()
+#define PARALLEL_MAX_THREADS 64
+// do not bother splitting the input into chunks smaller than this
+#define PARALLEL_MIN_CHUNK 4096
+
 // default SKIPDATA mnemonic
 #ifndef CAPSTONE_DIET
 #define SKIPDATA_MNEM ".byte"
@@ -462,6 +485,12 @@ cs_err CAPSTONE_API cs_open(cs_arch arch, cs_mode mode, csh *handle)
 		// default skipdata setup
 		ud->skipdata_setup.mnemonic = SKIPDATA_MNEM;
 
+		// memory functions are thread-local, so keep those of this thread
+		// for the instructions returned by this handle
+		ud->mem_malloc = cs_mem_malloc;
+		ud->mem_realloc = cs_mem_realloc;
+		ud->mem_free = cs_mem_free;
+
 		err = arch_configs[ud->arch].arch_init(ud);
 		if (err) {
 			cs_mem_free(ud);
@@ -482,7 +511,7 @@ CAPSTONE_EXPORT
 cs_err CAPSTONE_API cs_close(csh *handle)
 {
 	struct cs_struct *ud;
-	struct insn_mnem *next, *tmp;
+	unsigned int i;
 
 	if (*handle == 0)
 		// invalid handle
@@ -493,15 +522,10 @@ cs_err CAPSTONE_API cs_close(csh *handle)
 	if (ud->printer_info)
 		cs_mem_free(ud->printer_info);
 
-	// free the linked list of customized mnemonic
-	tmp = ud->mnem_list;
-	while(tmp) {
-		next = tmp->next;
-		cs_mem_free(tmp);
-		tmp = next;
-	}
-
-	cs_mem_free(ud->insn_cache);
+	// free the table of customized mnemonic
+	for (i = 0; i < ud->mnem_size; i++)
+		cs_mem_free(ud->mnem_table[i]);
+	cs_mem_free(ud->mnem_table);
 
 	memset(ud, 0, sizeof(*ud));
 	cs_mem_free(ud);
@@ -513,21 +537,139 @@ cs_err CAPSTONE_API cs_close(csh *handle)
 	return CS_ERR_OK;
 }
 
-// replace str1 in target with str2; target starts with str1
-// output is put into result (which is array of char with size CS_MNEMONIC_SIZE)
-// return 0 on success, -1 on failure
-static int str_replace(char *result, char *target, const char *str1, char *str2)
+// create a new handle with the same arch, mode & options of @handle.
+// return NULL on failure, with the error code put into @err
+static struct cs_struct *clone_handle(struct cs_struct *handle, cs_err *err)
 {
-	// only perform replacement if the output fits into result
-	if (strlen(target) - strlen(str1) + strlen(str2) < CS_MNEMONIC_SIZE - 1)  {
-		// copy str2 to begining of result
-		strcpy(result, str2);
-		// skip str1 - already replaced by str2
-		strcat(result, target + strlen(str1));
+	struct cs_struct *ud;
+	struct insn_mnem *mnem;
+	unsigned int i;
+	csh h;
+
+	ud = cs_mem_calloc(1, sizeof(*ud));
+	if (!ud) {
+		// memory insufficient
+		*err = CS_ERR_MEM;
+		return NULL;
+	}
 
-		return 0;
-	} else
-		return -1;
+	ud->arch = handle->arch;
+	ud->mode = handle->mode;
+	ud->skipdata_setup.mnemonic = SKIPDATA_MNEM;
+
+	*err = arch_configs[ud->arch].arch_init(ud);
+	if (*err) {
+		cs_mem_free(ud);
+		return NULL;
+	}
+
+	// syntax is the only option with side effects on the arch module
+	// other than mode, which was already taken into account by arch_init()
+	if (handle->syntax && handle->syntax != ud->syntax) {
+		*err = arch_configs[ud->arch].arch_option(ud, CS_OPT_SYNTAX, handle->syntax);
+		if (*err)
+			goto fail;
+	}
+
+	ud->detail = handle->detail;
+	ud->imm_unsigned = handle->imm_unsigned;
+	ud->no_text = handle->no_text;
+	ud->compact_detail = handle->compact_detail;
+	ud->skipdata = handle->skipdata;
+	ud->skipdata_size = handle->skipdata_size;
+	ud->skipdata_setup = handle->skipdata_setup;
+	ud->mem_malloc = handle->mem_malloc;
+	ud->mem_realloc = handle->mem_realloc;
+	ud->mem_free = handle->mem_free;
+	ud->mem = handle->mem;
+	ud->arena = handle->arena;
+	ud->regs_bitset = handle->regs_bitset;
+
+	// copy the table of customized mnemonic
+	if (handle->mnem_size) {
+		ud->mnem_table = cs_mem_calloc(handle->mnem_size, sizeof(*ud->mnem_table));
+		if (!ud->mnem_table) {
+			*err = CS_ERR_MEM;
+			goto fail;
+		}
+		ud->mnem_size = handle->mnem_size;
+
+		for (i = 0; i < handle->mnem_size; i++) {
+			if (!handle->mnem_table[i])
+				continue;
+
+			mnem = cs_mem_malloc(sizeof(*mnem));
+			if (!mnem) {
+				*err = CS_ERR_MEM;
+				goto fail;
+			}
+
+			*mnem = *handle->mnem_table[i];
+			ud->mnem_table[i] = mnem;
+		}
+	}
+
+	*err = CS_ERR_OK;
+
+	return ud;
+
+fail:
+	h = (uintptr_t)ud;
+	cs_close(&h);
+
+	return NULL;
+}
+
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_clone(csh ud, csh *handle)
+{
+	struct cs_struct *new_handle;
+	cs_err err;
+
+	if (!ud)
+		// invalid handle
+		return CS_ERR_CSH;
+
+	if (!cs_mem_malloc || !cs_mem_calloc || !cs_mem_realloc || !cs_mem_free || !cs_vsnprintf)
+		// Error: dynamic memory management must be initialized
+		// with cs_option(CS_OPT_MEM)
+		return CS_ERR_MEMSETUP;
+
+	new_handle = clone_handle((struct cs_struct *)(uintptr_t)ud, &err);
+	if (!new_handle) {
+		*handle = 0;
+		return err;
+	}
+
+	*handle = (uintptr_t)new_handle;
+
+	return CS_ERR_OK;
+}
+
+// replace the default mnemonic at the beginning of @mnemonic, which has @len
+// characters, with the customized mnemonic @mnem
+static void mnem_replace(char *mnemonic, size_t len, const struct insn_mnem *mnem)
+{
+	// what follows the default mnemonic is kept
+	size_t rest = len > mnem->name_len ? len - mnem->name_len : 0;
+
+	// only perform replacement if the output fits into @mnemonic
+	if (rest + mnem->len >= CS_MNEMONIC_SIZE - 1)
+		return;
+
+	memmove(mnemonic + mnem->len, mnemonic + len - rest, rest);
+	memcpy(mnemonic, mnem->insn.mnemonic, mnem->len);
+	mnemonic[mnem->len + rest] = '\0';
+}
+
+// fill the bytes of @insn, whose size is set, from @code
+static void fill_bytes(cs_insn *insn, const uint8_t *code)
+{
+	uint16_t copy_size = MIN(sizeof(insn->bytes), insn->size);
+
+	// we might skip some redundant bytes in front in the case of X86
+	memcpy(insn->bytes, code + insn->size - copy_size, copy_size);
+	insn->size = copy_size;
 }
 
 // fill insn with mnemonic & operands info
@@ -537,13 +679,9 @@ static void fill_insn(struct cs_struct *handle, cs_insn *insn, char *buffer, MCI
 #ifndef CAPSTONE_DIET
 	char *sp, *mnem;
 #endif
-	uint16_t copy_size = MIN(sizeof(insn->bytes), insn->size);
 
-	// fill the instruction bytes.
-	// we might skip some redundant bytes in front in the case of X86
-	memcpy(insn->bytes, code + insn->size - copy_size, copy_size);
+	fill_bytes(insn, code);
 	insn->op_str[0] = '\0';
-	insn->size = copy_size;
 
 	// alias instruction might have ID saved in OpcodePub
 	if (MCInst_getOpcodePub(mci))
@@ -554,6 +692,12 @@ static void fill_insn(struct cs_struct *handle, cs_insn *insn, char *buffer, MCI
 		postprinter((csh)handle, insn, buffer, mci);
 
 #ifndef CAPSTONE_DIET
+	if (handle->no_text) {
+		// text is rendered on demand by cs_insn_text()
+		insn->mnemonic[0] = '\0';
+		return;
+	}
+
 	mnem = insn->mnemonic;
 	for (sp = buffer; *sp; sp++) {
 		if (*sp == ' '|| *sp == '\t')
@@ -568,23 +712,8 @@ static void fill_insn(struct cs_struct *handle, cs_insn *insn, char *buffer, MCI
 	*mnem = '\0';
 
 	// we might have customized mnemonic
-	if (handle->mnem_list) {
-		struct insn_mnem *tmp = handle->mnem_list;
-		while(tmp) {
-			if (tmp->insn.id == insn->id) {
-				char str[CS_MNEMONIC_SIZE];
-
-				if (!str_replace(str, insn->mnemonic, cs_insn_name((csh)handle, insn->id), tmp->insn.mnemonic)) {
-					// copy result to mnemonic
-					(void)strncpy(insn->mnemonic, str, sizeof(insn->mnemonic) - 1);
-					insn->mnemonic[sizeof(insn->mnemonic) - 1] = '\0';
-				}
-
-				break;
-			}
-			tmp = tmp->next;
-		}
-	}
+	if (insn->id < handle->mnem_size && handle->mnem_table[insn->id])
+		mnem_replace(insn->mnemonic, mnem - insn->mnemonic, handle->mnem_table[insn->id]);
 
 	// copy @op_str
 	if (*sp) {
@@ -695,6 +824,34 @@ cs_err CAPSTONE_API cs_option(csh ud, cs_opt_type type, size_t value)
 			handle->detail = (cs_opt_value)value;
 			return CS_ERR_OK;
 
+		case CS_OPT_NO_TEXT:
+			handle->no_text = (value == CS_OPT_ON);
+			return CS_ERR_OK;
+
+		case CS_OPT_COMPACT_DETAIL:
+			handle->compact_detail = (value == CS_OPT_ON);
+			return CS_ERR_OK;
+
+		case CS_OPT_MEM_CTX:
+			if (value) {
+				cs_opt_mem_ctx *mem = (cs_opt_mem_ctx *)value;
+
+				if (!mem->malloc || !mem->realloc || !mem->free)
+					return CS_ERR_MEMSETUP;
+
+				handle->mem = *mem;
+			} else
+				memset(&handle->mem, 0, sizeof(handle->mem));
+			return CS_ERR_OK;
+
+		case CS_OPT_ARENA:
+			handle->arena = (value == CS_OPT_ON);
+			return CS_ERR_OK;
+
+		case CS_OPT_REGS_BITSET:
+			handle->regs_bitset = (value == CS_OPT_ON);
+			return CS_ERR_OK;
+
 		case CS_OPT_SKIPDATA:
 			handle->skipdata = (value == CS_OPT_ON);
 			if (handle->skipdata) {
@@ -719,52 +876,66 @@ cs_err CAPSTONE_API cs_option(csh ud, cs_opt_type type, size_t value)
 			if (opt->id) {
 				if (opt->mnemonic) {
 					struct insn_mnem *tmp;
+					const char *name;
+
+					// only instructions of this arch can be customized,
+					// which also bounds the size of the table below
+					name = cs_insn_name(ud, opt->id);
+					if (!name) {
+						handle->errnum = CS_ERR_OPTION;
+						return CS_ERR_OPTION;
+					}
 
 					// add new instruction, or replace existing instruction
-					// 1. find if we already had this insn in the linked list
-					tmp = handle->mnem_list;
-					while(tmp) {
-						if (tmp->insn.id == opt->id) {
-							// found this instruction, so replace its mnemonic
-							(void)strncpy(tmp->insn.mnemonic, opt->mnemonic, sizeof(tmp->insn.mnemonic) - 1);
-							tmp->insn.mnemonic[sizeof(tmp->insn.mnemonic) - 1] = '\0';
-							break;
+					// 1. grow the table if this ID is not covered yet
+					if (opt->id >= handle->mnem_size) {
+						struct insn_mnem **table;
+						size_t size = handle->mnem_size ? handle->mnem_size : 64;
+
+						while (size <= opt->id)
+							size *= 2;
+
+						if (size > SIZE_MAX / sizeof(*table)) {
+							handle->errnum = CS_ERR_MEM;
+							return CS_ERR_MEM;
+						}
+
+						table = cs_mem_realloc(handle->mnem_table, size * sizeof(*table));
+						if (!table) {
+							handle->errnum = CS_ERR_MEM;
+							return CS_ERR_MEM;
 						}
-						tmp = tmp->next;
+
+						memset(table + handle->mnem_size, 0,
+								(size - handle->mnem_size) * sizeof(*table));
+						handle->mnem_table = table;
+						handle->mnem_size = (unsigned int)size;
 					}
 
 					// 2. add this instruction if we have not had it yet
+					tmp = handle->mnem_table[opt->id];
 					if (!tmp) {
 						tmp = cs_mem_malloc(sizeof(*tmp));
+						if (!tmp) {
+							handle->errnum = CS_ERR_MEM;
+							return CS_ERR_MEM;
+						}
 						tmp->insn.id = opt->id;
-						(void)strncpy(tmp->insn.mnemonic, opt->mnemonic, sizeof(tmp->insn.mnemonic) - 1);
-						tmp->insn.mnemonic[sizeof(tmp->insn.mnemonic) - 1] = '\0';
-						// this new instruction is heading the list
-						tmp->next = handle->mnem_list;
-						handle->mnem_list = tmp;
+						handle->mnem_table[opt->id] = tmp;
 					}
+
+					// 3. set its mnemonic, with the length of what it replaces
+					(void)strncpy(tmp->insn.mnemonic, opt->mnemonic, sizeof(tmp->insn.mnemonic) - 1);
+					tmp->insn.mnemonic[sizeof(tmp->insn.mnemonic) - 1] = '\0';
+					tmp->len = (uint8_t)strlen(tmp->insn.mnemonic);
+					tmp->name_len = (uint8_t)MIN(strlen(name), CS_MNEMONIC_SIZE - 1);
+
 					return CS_ERR_OK;
 				} else {
-					struct insn_mnem *prev, *tmp;
-
 					// we want to delete an existing instruction
-					// iterate the list to find the instruction to remove it
-					tmp = handle->mnem_list;
-					prev = tmp;
-					while(tmp) {
-						if (tmp->insn.id == opt->id) {
-							// delete this instruction
-							if (tmp == prev) {
-								// head of the list
-								handle->mnem_list = tmp->next;
-							} else {
-								prev->next = tmp->next;
-							}
-							cs_mem_free(tmp);
-							break;
-						}
-						prev = tmp;
-						tmp = tmp->next;
+					if (opt->id < handle->mnem_size) {
+						cs_mem_free(handle->mnem_table[opt->id]);
+						handle->mnem_table[opt->id] = NULL;
 					}
 				}
 			}
@@ -813,352 +984,1869 @@ static void skipdata_opstr(char *opstr, const uint8_t *buffer, size_t size)
 }
 #endif
 
-// dynamicly allocate memory to contain disasm insn
-// NOTE: caller must free() the allocated memory itself to avoid memory leaking
-CAPSTONE_EXPORT
-size_t CAPSTONE_API cs_disasm(csh ud, const uint8_t *buffer, size_t size, uint64_t offset, size_t count, cs_insn **insn)
+// register bitsets of CS_OPT_REGS_BITSET, stored right after the cs_detail
+// they belong to, in the same allocation, so cs_detail keeps its size
+struct detail_bitsets {
+	cs_regs_bitset read;
+	cs_regs_bitset write;
+};
+
+#define DETAIL_BITSETS(detail) ((struct detail_bitsets *)((detail) + 1))
+
+// number of bytes to allocate for a full detail, with room for the
+// register bitsets only with CS_OPT_REGS_BITSET
+static size_t detail_alloc_size(struct cs_struct *handle)
 {
-	struct cs_struct *handle;
-	MCInst mci;
-	uint16_t insn_size;
-	size_t c = 0, i;
-	unsigned int f = 0;	// index of the next instruction in the cache
-	cs_insn *insn_cache;	// cache contains disassembled instructions
-	void *total = NULL;
-	size_t total_size = 0;	// total size of output buffer containing all insns
-	bool r;
-	void *tmp;
-	size_t skipdata_bytes;
-	uint64_t offset_org; // save all the original info of the buffer
-	size_t size_org;
-	const uint8_t *buffer_org;
-	unsigned int cache_size = INSN_CACHE_SIZE;
-	size_t next_offset;
+	if (handle->regs_bitset)
+		return sizeof(cs_detail) + sizeof(struct detail_bitsets);
 
-	handle = (struct cs_struct *)(uintptr_t)ud;
-	if (!handle) {
-		// FIXME: how to handle this case:
-		// handle->errnum = CS_ERR_HANDLE;
-		return 0;
-	}
+	return sizeof(cs_detail);
+}
 
-	handle->errnum = CS_ERR_OK;
+// compute the register bitsets of @insn after its detail, for CS_OPT_REGS_BITSET.
+// NOTE: the detail must have been allocated with detail_alloc_size() bytes
+static void fill_regs_bitset(struct cs_struct *handle, cs_insn *insn)
+{
+#ifndef CAPSTONE_DIET
+	struct detail_bitsets *bits;
+	cs_regs read, write;
+	uint8_t read_count, write_count;
 
-	// reset IT block of ARM structure
-	if (handle->arch == CS_ARCH_ARM)
-		handle->ITBlock.size = 0;
+	if (!handle->regs_bitset || !handle->reg_access)
+		return;
 
-#ifdef CAPSTONE_USE_SYS_DYN_MEM
-	if (count > 0 && count <= INSN_CACHE_SIZE)
-		cache_size = (unsigned int) count;
+	bits = DETAIL_BITSETS(insn->detail);
+	handle->reg_access(insn, read, &read_count, write, &write_count);
+	regs_bitset_fill(bits->read, read, read_count);
+	regs_bitset_fill(bits->write, write, write_count);
+	insn->detail->regs_bitset = 1;
 #endif
+}
 
-	// save the original offset for SKIPDATA
-	buffer_org = buffer;
-	offset_org = offset;
-	size_org = size;
+// decode_insn() for archs with handle->disasm_insn: the instruction is decoded
+// straight into @insn, without MCInst, printer, nor parsing its text.
+// this is much of the time of bytecode archs, where decoding is trivial
+static size_t decode_insn_direct(struct cs_struct *handle, const uint8_t *code, size_t size,
+		uint64_t address, cs_insn *insn)
+{
+	uint16_t insn_size;
 
-	total_size = sizeof(cs_insn) * cache_size;
-	total = cs_mem_malloc(total_size);
-	if (total == NULL) {
-		// insufficient memory
-		handle->errnum = CS_ERR_MEM;
+	insn->address = address;
+	insn->mnemonic[0] = '\0';
+	insn->op_str[0] = '\0';
+
+	if (!handle->disasm_insn(handle, code, size, insn, &insn_size))
 		return 0;
-	}
 
-	insn_cache = total;
+	insn->size = insn_size;
+	fill_bytes(insn, code);
 
-	while (size > 0) {
-		MCInst_Init(&mci);
-		mci.csh = handle;
+#ifndef CAPSTONE_DIET
+	// we might have customized mnemonic
+	if (!handle->no_text && insn->id < handle->mnem_size && handle->mnem_table[insn->id])
+		mnem_replace(insn->mnemonic, strlen(insn->mnemonic), handle->mnem_table[insn->id]);
+#endif
 
-		// relative branches need to know the address & size of current insn
-		mci.address = offset;
+	// the callers with room for them fill register bitsets later
+	if (handle->detail && insn->detail)
+		insn->detail->regs_bitset = 0;
 
-		if (handle->detail) {
-			// allocate memory for @detail pointer
-			insn_cache->detail = cs_mem_malloc(sizeof(cs_detail));
-		} else {
-			insn_cache->detail = NULL;
-		}
+	return insn_size;
+}
 
-		// save all the information for non-detailed mode
-		mci.flat_insn = insn_cache;
-		mci.flat_insn->address = offset;
-#ifdef CAPSTONE_DIET
-		// zero out mnemonic & op_str
-		mci.flat_insn->mnemonic[0] = '\0';
-		mci.flat_insn->op_str[0] = '\0';
-#endif
+// disassemble a single instruction at @code into @insn, then fill in its text.
+// NOTE: if detail mode is ON, @insn->detail must already point to valid memory
+// return number of bytes consumed, or 0 on a broken instruction
+static size_t decode_insn(struct cs_struct *handle, const uint8_t *code, size_t size,
+		uint64_t address, cs_insn *insn)
+{
+	MCInst mci;
+	SStream ss;
+	uint16_t insn_size;
+	bool no_text;
 
-		r = handle->disasm(ud, buffer, size, &mci, &insn_size, offset, handle->getinsn_info);
-		if (r) {
-			SStream ss;
-			SStream_Init(&ss);
+	if (handle->disasm_insn)
+		return decode_insn_direct(handle, code, size, address, insn);
 
-			mci.flat_insn->size = insn_size;
+	MCInst_Init(&mci);
+	mci.csh = handle;
 
-			// map internal instruction opcode to public insn ID
+	// relative branches need to know the address & size of current insn
+	mci.address = address;
 
-			handle->insn_id(handle, insn_cache, mci.Opcode);
+	// save all the information for non-detailed mode
+	mci.flat_insn = insn;
+	mci.flat_insn->address = address;
+#ifdef CAPSTONE_DIET
+	// zero out mnemonic & op_str
+	mci.flat_insn->mnemonic[0] = '\0';
+	mci.flat_insn->op_str[0] = '\0';
+#endif
 
-			handle->printer(&mci, &ss, handle->printer_info);
-			fill_insn(handle, insn_cache, ss.buffer, &mci, handle->post_printer, buffer);
+	// an instruction inside an ARM IT block takes its condition from the IT
+	// state, which is gone when cs_insn_text() decodes it again later.
+	// so render its text now, even with CS_OPT_NO_TEXT
+	no_text = handle->no_text;
+	if (no_text && handle->arch == CS_ARCH_ARM && handle->ITBlock.size)
+		handle->no_text = false;
 
-			// adjust for pseudo opcode (X86)
-			if (handle->arch == CS_ARCH_X86)
-				insn_cache->id += mci.popcode_adjust;
+	if (!handle->disasm((csh)handle, code, size, &mci, &insn_size, address, handle->getinsn_info)) {
+		handle->no_text = no_text;
+		return 0;
+	}
 
-			next_offset = insn_size;
-		} else	{
-			// encounter a broken instruction
+	SStream_Init(&ss);
+	ss.quiet = handle->no_text;
 
-			// free memory of @detail pointer
-			if (handle->detail) {
-				cs_mem_free(insn_cache->detail);
-			}
+	mci.flat_insn->size = insn_size;
 
-			// if there is no request to skip data, or remaining data is too small,
-			// then bail out
-			if (!handle->skipdata || handle->skipdata_size > size)
-				break;
+	// map internal instruction opcode to public insn ID
+	handle->insn_id(handle, insn, mci.Opcode);
 
-			if (handle->skipdata_setup.callback) {
-				skipdata_bytes = handle->skipdata_setup.callback(buffer_org, size_org,
-						(size_t)(offset - offset_org), handle->skipdata_setup.user_data);
-				if (skipdata_bytes > size)
-					// remaining data is not enough
-					break;
+	handle->printer(&mci, &ss, handle->printer_info);
+	fill_insn(handle, insn, ss.buffer, &mci, handle->post_printer, code);
 
-				if (!skipdata_bytes)
-					// user requested not to skip data, so bail out
-					break;
-			} else
-				skipdata_bytes = handle->skipdata_size;
+	handle->no_text = no_text;
 
-			// we have to skip some amount of data, depending on arch & mode
-			insn_cache->id = 0;	// invalid ID for this "data" instruction
-			insn_cache->address = offset;
-			insn_cache->size = (uint16_t)skipdata_bytes;
-			memcpy(insn_cache->bytes, buffer, skipdata_bytes);
-#ifdef CAPSTONE_DIET
-			insn_cache->mnemonic[0] = '\0';
-			insn_cache->op_str[0] = '\0';
-#else
-			strncpy(insn_cache->mnemonic, handle->skipdata_setup.mnemonic,
-					sizeof(insn_cache->mnemonic) - 1);
-			skipdata_opstr(insn_cache->op_str, buffer, skipdata_bytes);
-#endif
-			insn_cache->detail = NULL;
+	// adjust for pseudo opcode (X86)
+	if (handle->arch == CS_ARCH_X86)
+		insn->id += mci.popcode_adjust;
 
-			next_offset = skipdata_bytes;
-		}
+	// the callers with room for them fill register bitsets later
+	if (handle->detail && insn->detail)
+		insn->detail->regs_bitset = 0;
 
-		// one more instruction entering the cache
-		f++;
+	return insn_size;
+}
 
-		// one more instruction disassembled
-		c++;
-		if (count > 0 && c == count)
-			// already got requested number of instructions
-			break;
+// return number of operands in @detail of architecture @arch, and put into
+// @size the number of bytes of @detail used by these operands.
+// most architectures have operands[] at the end of their structure, so
+// unused operands can be left out.
+static unsigned int detail_ops(cs_arch arch, const cs_detail *detail, size_t *size)
+{
+#define DETAIL_OPS(a) \
+	*size = offsetof(cs_detail, a.operands) + \
+		detail->a.op_count * sizeof(detail->a.operands[0]); \
+	return detail->a.op_count
 
-		if (f == cache_size) {
-			// full cache, so expand the cache to contain incoming insns
-			cache_size = cache_size * 8 / 5; // * 1.6 ~ golden ratio
-			total_size += (sizeof(cs_insn) * cache_size);
-			tmp = cs_mem_realloc(total, total_size);
-			if (tmp == NULL) {	// insufficient memory
-				if (handle->detail) {
-					insn_cache = (cs_insn *)total;
-					for (i = 0; i < c; i++, insn_cache++)
-						cs_mem_free(insn_cache->detail);
-				}
+	switch (arch) {
+		default:
+			*size = sizeof(*detail);
+			return 0;
+		case CS_ARCH_ARM:
+			DETAIL_OPS(arm);
+		case CS_ARCH_ARM64:
+			DETAIL_OPS(arm64);
+		case CS_ARCH_MIPS:
+			DETAIL_OPS(mips);
+		case CS_ARCH_PPC:
+			DETAIL_OPS(ppc);
+		case CS_ARCH_SPARC:
+			DETAIL_OPS(sparc);
+		case CS_ARCH_SYSZ:
+			DETAIL_OPS(sysz);
+		case CS_ARCH_XCORE:
+			DETAIL_OPS(xcore);
+		case CS_ARCH_M680X:
+			DETAIL_OPS(m680x);
+		case CS_ARCH_MOS65XX:
+			DETAIL_OPS(mos65xx);
+		case CS_ARCH_WASM:
+			DETAIL_OPS(wasm);
+		case CS_ARCH_BPF:
+			DETAIL_OPS(bpf);
+		case CS_ARCH_RISCV:
+			DETAIL_OPS(riscv);
+		// these have more fields after operands[]
+		case CS_ARCH_X86:
+			*size = offsetof(cs_detail, x86) + sizeof(cs_x86);
+			return detail->x86.op_count;
+		case CS_ARCH_M68K:
+			*size = offsetof(cs_detail, m68k) + sizeof(cs_m68k);
+			return detail->m68k.op_count;
+		case CS_ARCH_TMS320C64X:
+			*size = offsetof(cs_detail, tms320c64x) + sizeof(cs_tms320c64x);
+			return detail->tms320c64x.op_count;
+		case CS_ARCH_EVM:
+			*size = offsetof(cs_detail, evm) + sizeof(cs_evm);
+			return 0;
+	}
 
-				cs_mem_free(total);
-				*insn = NULL;
-				handle->errnum = CS_ERR_MEM;
-				return 0;
-			}
+#undef DETAIL_OPS
+}
 
-			total = tmp;
-			// continue to fill in the cache after the last instruction
-			insn_cache = (cs_insn *)((char *)total + sizeof(cs_insn) * c);
+// a block of memory holding details of instructions returned by one call
+// to cs_disasm(), for CS_OPT_ARENA
+struct arena_block {
+	struct arena_block *next;	// previous block of the same cs_disasm() call
+	size_t size;	// number of bytes in @data
+	size_t used;	// number of bytes of @data already allocated
+	union {
+		uint64_t u;
+		double d;
+		void *p;
+	} data[1];	// aligned like anything malloc() returns
+};
 
-			// reset f back to 0, so we fill in the cache from begining
-			f = 0;
-		} else
-			insn_cache++;
+// header in front of each array of instructions returned to the user, so
+// cs_free(), which has no handle, knows how to release it
+struct insn_header {
+	cs_free_t mem_free;	// free() of CS_OPT_MEM, if @free is not set
+	cs_free_ctx_t free;	// free() of CS_OPT_MEM_CTX
+	void *ctx;	// user context of @free
+	struct arena_block *arena;	// blocks of all details (CS_OPT_ARENA), or NULL
+	bool regs_bitset;	// details have room for register bitsets (CS_OPT_REGS_BITSET)
+};
 
-		buffer += next_offset;
-		size -= next_offset;
-		offset += next_offset;
-	}
+static void *handle_malloc(struct cs_struct *handle, size_t size)
+{
+	if (handle->mem.malloc)
+		return handle->mem.malloc(handle->mem.ctx, size);
 
-	if (!c) {
-		// we did not disassemble any instruction
-		cs_mem_free(total);
-		total = NULL;
-	} else if (f != cache_size) {
-		// total did not fully use the last cache, so downsize it
-		tmp = cs_mem_realloc(total, total_size - (cache_size - f) * sizeof(*insn_cache));
-		if (tmp == NULL) {	// insufficient memory
-			// free all detail pointers
-			if (handle->detail) {
-				insn_cache = (cs_insn *)total;
-				for (i = 0; i < c; i++, insn_cache++)
-					cs_mem_free(insn_cache->detail);
-			}
+	return handle->mem_malloc(size);
+}
 
-			cs_mem_free(total);
-			*insn = NULL;
+static void *handle_realloc(struct cs_struct *handle, void *ptr, size_t size)
+{
+	if (handle->mem.malloc)
+		return handle->mem.realloc(handle->mem.ctx, ptr, size);
 
-			handle->errnum = CS_ERR_MEM;
-			return 0;
-		}
+	return handle->mem_realloc(ptr, size);
+}
+
+static void handle_free(struct cs_struct *handle, void *ptr)
+{
+	if (handle->mem.malloc)
+		handle->mem.free(handle->mem.ctx, ptr);
+	else
+		handle->mem_free(ptr);
+}
+
+static void header_free(struct insn_header *header, void *ptr)
+{
+	if (header->free)
+		header->free(header->ctx, ptr);
+	else
+		header->mem_free(ptr);
+}
+
+// allocate an array of @count instructions to return to the user, or resize
+// @insn, if it is not NULL, to @count instructions.
+// return NULL if there is not enough memory, with @insn left untouched
+static cs_insn *insn_array(struct cs_struct *handle, cs_insn *insn, size_t count)
+{
+	struct insn_header *header;
+	size_t size = sizeof(*header) + count * sizeof(cs_insn);
+
+	if (insn) {
+		header = handle_realloc(handle, (struct insn_header *)insn - 1, size);
+		return header ? (cs_insn *)(header + 1) : NULL;
+	}
+
+	header = handle_malloc(handle, size);
+	if (!header)
+		return NULL;
+
+	header->mem_free = handle->mem_free;
+	header->free = handle->mem.malloc ? handle->mem.free : NULL;
+	header->ctx = handle->mem.ctx;
+	header->arena = NULL;
+	header->regs_bitset = false;
+
+	return (cs_insn *)(header + 1);
+}
+
+// allocate @size bytes for a detail, taken from the blocks in @arena with
+// CS_OPT_ARENA, or allocated alone if @arena is NULL
+static void *detail_alloc(struct cs_struct *handle, struct arena_block **arena, size_t size)
+{
+	struct arena_block *block;
+	size_t block_size;
+	void *detail;
+
+	if (!arena)
+		return handle_malloc(handle, size);
+
+	size = (size + sizeof(block->data[0]) - 1) & ~(sizeof(block->data[0]) - 1);
+
+	block = *arena;
+	if (!block || block->size - block->used < size) {
+		// current block is full, so start a new one twice as big
+		block_size = block ? block->size * 2 : ARENA_MIN_BLOCK;
+		if (block_size < size)
+			block_size = size;
+
+		block = handle_malloc(handle, offsetof(struct arena_block, data) + block_size);
+		if (!block)
+			return NULL;
+
+		block->next = *arena;
+		block->size = block_size;
+		block->used = 0;
+		*arena = block;
+	}
+
+	detail = (char *)block->data + block->used;
+	block->used += size;
+
+	return detail;
+}
+
+// release @detail, which must be the last one returned by detail_alloc()
+static void detail_free(struct cs_struct *handle, struct arena_block **arena, void *detail)
+{
+	if (!arena)
+		handle_free(handle, detail);
+	else
+		(*arena)->used = (size_t)((char *)detail - (char *)(*arena)->data);
+}
+
+// replace @detail of @insn, decoded into a full cs_detail, with a copy of
+// only its used part, for CS_OPT_COMPACT_DETAIL.
+// return false if there is not enough memory
+static bool compact_detail(struct cs_struct *handle, struct arena_block **arena, cs_insn *insn)
+{
+	cs_detail *detail;
+	size_t size;
+
+	detail_ops(handle->arch, insn->detail, &size);
+
+	detail = detail_alloc(handle, arena, size);
+	if (!detail) {
+		handle->errnum = CS_ERR_MEM;
+		return false;
+	}
+
+	memcpy(detail, insn->detail, size);
+	insn->detail = detail;
+
+	return true;
+}
+
+// fill @insn with a "data" instruction of SKIPDATA mode, for the data found at
+// position @offset of the input buffer @code, which has @code_size bytes.
+// return number of bytes skipped, or 0 if we must stop disassembling
+static size_t skipdata_insn(struct cs_struct *handle, const uint8_t *code, size_t code_size,
+		size_t offset, uint64_t address, cs_insn *insn)
+{
+	size_t skipdata_bytes;
+	size_t size = code_size - offset;
+
+	// if there is no request to skip data, or remaining data is too small,
+	// then bail out
+	if (!handle->skipdata || handle->skipdata_size > size)
+		return 0;
+
+	if (handle->skipdata_setup.callback) {
+		skipdata_bytes = handle->skipdata_setup.callback(code, code_size,
+				offset, handle->skipdata_setup.user_data);
+		if (skipdata_bytes > size)
+			// remaining data is not enough
+			return 0;
+
+		if (!skipdata_bytes)
+			// user requested not to skip data, so bail out
+			return 0;
+	} else
+		skipdata_bytes = handle->skipdata_size;
+
+	// we have to skip some amount of data, depending on arch & mode
+	insn->id = 0;	// invalid ID for this "data" instruction
+	insn->address = address;
+	insn->size = (uint16_t)skipdata_bytes;
+	memcpy(insn->bytes, code + offset, MIN(sizeof(insn->bytes), skipdata_bytes));
+#ifdef CAPSTONE_DIET
+	insn->mnemonic[0] = '\0';
+	insn->op_str[0] = '\0';
+#else
+	strncpy(insn->mnemonic, handle->skipdata_setup.mnemonic,
+			sizeof(insn->mnemonic) - 1);
+	insn->mnemonic[sizeof(insn->mnemonic) - 1] = '\0';
+	skipdata_opstr(insn->op_str, code + offset, skipdata_bytes);
+#endif
+
+	return skipdata_bytes;
+}
+
+// dynamicly allocate memory to contain disasm insn
+// NOTE: caller must free() the allocated memory itself to avoid memory leaking
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm(csh ud, const uint8_t *buffer, size_t size, uint64_t offset, size_t count, cs_insn **insn)
+{
+	struct cs_struct *handle;
+	size_t c = 0;
+	unsigned int f = 0;	// index of the next instruction in the cache
+	cs_insn *insn_cache;	// cache contains disassembled instructions
+	cs_insn *total = NULL;
+	size_t total_count = 0;	// number of insns the output buffer can contain
+	cs_insn *tmp;
+	uint64_t offset_org; // save all the original info of the buffer
+	size_t size_org;
+	const uint8_t *buffer_org;
+	unsigned int cache_size = INSN_CACHE_SIZE;
+	size_t next_offset;
+	cs_detail detail;	// decoding buffer for CS_OPT_COMPACT_DETAIL
+	struct arena_block *blocks = NULL;	// blocks of details, for CS_OPT_ARENA
+	struct arena_block **arena;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+	if (!handle) {
+		// FIXME: how to handle this case:
+		// handle->errnum = CS_ERR_HANDLE;
+		return 0;
+	}
+
+	handle->errnum = CS_ERR_OK;
+
+	// reset IT block of ARM structure
+	if (handle->arch == CS_ARCH_ARM)
+		handle->ITBlock.size = 0;
+
+#ifdef CAPSTONE_USE_SYS_DYN_MEM
+	if (count > 0 && count <= INSN_CACHE_SIZE)
+		cache_size = (unsigned int) count;
+#endif
+
+	// save the original offset for SKIPDATA
+	buffer_org = buffer;
+	offset_org = offset;
+	size_org = size;
+
+	arena = handle->arena ? &blocks : NULL;
+
+	total_count = cache_size;
+	total = insn_array(handle, NULL, total_count);
+	if (total == NULL) {
+		// insufficient memory
+		handle->errnum = CS_ERR_MEM;
+		return 0;
+	}
+
+	insn_cache = total;
+
+	while (size > 0) {
+		if (handle->detail) {
+			// allocate memory for @detail pointer, unless it is to be
+			// compacted after decoding
+			if (handle->compact_detail)
+				insn_cache->detail = &detail;
+			else {
+				insn_cache->detail = detail_alloc(handle, arena, detail_alloc_size(handle));
+				if (insn_cache->detail == NULL) {
+					handle->errnum = CS_ERR_MEM;
+					break;
+				}
+			}
+		} else {
+			insn_cache->detail = NULL;
+		}
+
+		next_offset = decode_insn(handle, buffer, size, offset, insn_cache);
+		if (!next_offset) {
+			// encounter a broken instruction
+
+			// free memory of @detail pointer
+			if (handle->detail && !handle->compact_detail) {
+				detail_free(handle, arena, insn_cache->detail);
+			}
+
+			next_offset = skipdata_insn(handle, buffer_org, size_org,
+					(size_t)(offset - offset_org), offset, insn_cache);
+			if (!next_offset)
+				break;
+
+			insn_cache->detail = NULL;
+		} else if (handle->detail && handle->compact_detail) {
+			if (!compact_detail(handle, arena, insn_cache))
+				break;
+		} else if (handle->detail)
+			fill_regs_bitset(handle, insn_cache);
+
+		// one more instruction entering the cache
+		f++;
+
+		// one more instruction disassembled
+		c++;
+		if (count > 0 && c == count)
+			// already got requested number of instructions
+			break;
+
+		if (f == cache_size) {
+			// full cache, so expand the cache to contain incoming insns
+			cache_size = cache_size * 8 / 5; // * 1.6 ~ golden ratio
+			total_count += cache_size;
+			tmp = insn_array(handle, total, total_count);
+			if (tmp == NULL)	// insufficient memory
+				goto fail;
+
+			total = tmp;
+			// continue to fill in the cache after the last instruction
+			insn_cache = total + c;
+
+			// reset f back to 0, so we fill in the cache from begining
+			f = 0;
+		} else
+			insn_cache++;
+
+		buffer += next_offset;
+		size -= next_offset;
+		offset += next_offset;
+	}
+
+	if (!c) {
+		// we did not disassemble any instruction
+		((struct insn_header *)total - 1)->arena = blocks;
+		cs_free(total, 0);
+		total = NULL;
+	} else if (f != cache_size) {
+		// total did not fully use the last cache, so downsize it
+		tmp = insn_array(handle, total, total_count - (cache_size - f));
+		if (tmp == NULL)	// insufficient memory
+			goto fail;
 
 		total = tmp;
 	}
 
-	*insn = total;
+	if (total)
+		// cs_free() releases all the blocks of details at once
+		((struct insn_header *)total - 1)->arena = blocks;
+
+	*insn = total;
+
+	return c;
+
+fail:
+	// free all detail pointers, then the instructions
+	((struct insn_header *)total - 1)->arena = blocks;
+	cs_free(total, c);
+	*insn = NULL;
+	handle->errnum = CS_ERR_MEM;
+
+	return 0;
+}
+
+CAPSTONE_EXPORT
+void CAPSTONE_API cs_free(cs_insn *insn, size_t count)
+{
+	struct insn_header *header;
+	struct arena_block *block, *next;
+	size_t i;
+
+	if (!insn)
+		return;
+
+	header = (struct insn_header *)insn - 1;
+
+	if (header->arena) {
+		// all details are in these blocks
+		for (block = header->arena; block; block = next) {
+			next = block->next;
+			header_free(header, block);
+		}
+	} else {
+		// free all detail pointers
+		for (i = 0; i < count; i++) {
+			if (insn[i].detail)
+				header_free(header, insn[i].detail);
+		}
+	}
+
+	// then free pointer to cs_insn array
+	header_free(header, header);
+}
+
+CAPSTONE_EXPORT
+cs_insn * CAPSTONE_API cs_malloc(csh ud)
+{
+	cs_insn *insn;
+	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
+
+	insn = insn_array(handle, NULL, 1);
+	if (!insn) {
+		// insufficient memory
+		handle->errnum = CS_ERR_MEM;
+		return NULL;
+	} else {
+		insn->detail = NULL;
+
+		if (handle->detail) {
+			// allocate memory for @detail pointer
+			insn->detail = handle_malloc(handle, detail_alloc_size(handle));
+			if (insn->detail == NULL) {	// insufficient memory
+				cs_free(insn, 1);
+				handle->errnum = CS_ERR_MEM;
+				return NULL;
+			}
+
+			((struct insn_header *)insn - 1)->regs_bitset = handle->regs_bitset;
+		}
+	}
+
+	return insn;
+}
+
+// iterator for instruction "single-stepping"
+CAPSTONE_EXPORT
+bool CAPSTONE_API cs_disasm_iter(csh ud, const uint8_t **code, size_t *size,
+		uint64_t *address, cs_insn *insn)
+{
+	struct cs_struct *handle;
+	size_t insn_size;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+	if (!handle) {
+		return false;
+	}
+
+	handle->errnum = CS_ERR_OK;
+
+	insn_size = decode_insn(handle, *code, *size, *address, insn);
+	if (!insn_size) {
+		// encounter a broken instruction
+		insn_size = skipdata_insn(handle, *code, *size, 0, *address, insn);
+		if (!insn_size)
+			return false;
+	} else if (handle->detail && insn->detail &&
+			((struct insn_header *)insn - 1)->regs_bitset)
+		// cs_malloc() left room for the register bitsets
+		fill_regs_bitset(handle, insn);
+
+	*code += insn_size;
+	*size -= insn_size;
+	*address += insn_size;
+
+	return true;
+}
+
+// disassemble into a caller-owned array of instructions, without any dynamic
+// memory allocation. this can be resumed after updating @code, @size & @address
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_into(csh ud, const uint8_t **code, size_t *size,
+		uint64_t *address, cs_insn *insn, cs_detail *detail, size_t count)
+{
+	struct cs_struct *handle;
+	const uint8_t *code_org;
+	size_t size_org, consumed = 0, next_offset, c;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+	if (!handle) {
+		return 0;
+	}
+
+	handle->errnum = CS_ERR_OK;
+
+	if (handle->detail && detail == NULL) {
+		// detail mode needs a slab to put cs_detail into
+		handle->errnum = CS_ERR_DETAIL;
+		return 0;
+	}
+
+	code_org = *code;
+	size_org = *size;
+
+	for (c = 0; c < count && consumed < size_org; c++) {
+		insn[c].detail = handle->detail ? &detail[c] : NULL;
+
+		next_offset = decode_insn(handle, code_org + consumed, size_org - consumed,
+				*address, &insn[c]);
+		if (!next_offset) {
+			// encounter a broken instruction
+			next_offset = skipdata_insn(handle, code_org, size_org, consumed,
+					*address, &insn[c]);
+			if (!next_offset)
+				break;
+
+			insn[c].detail = NULL;
+		}
+
+		consumed += next_offset;
+		*address += next_offset;
+	}
+
+	*code += consumed;
+	*size -= consumed;
+
+	return c;
+}
+
+// disassemble @code, passing each instruction to @callback, reusing @insn
+// & @detail for all instructions.
+// if @more is true, more code follows @code, so instructions that might cross
+// the end of @code are left for the next call.
+// return number of instructions passed to @callback, with the number of bytes
+// disassembled put into @consumed, and @stop set when we must not continue.
+static size_t disasm_visit(struct cs_struct *handle, const uint8_t *code, size_t size,
+		uint64_t address, bool more, cs_insn *insn, cs_detail *detail,
+		cs_insn_cb_t callback, void *user_data, size_t *consumed, bool *stop)
+{
+	size_t offset = 0, next_offset, c = 0;
+
+	while (offset < size) {
+		if (more && size - offset < STREAM_MAX_INSN_SIZE)
+			// wait for more code
+			break;
+
+		insn->detail = handle->detail ? detail : NULL;
+
+		next_offset = decode_insn(handle, code + offset, size - offset,
+				address + offset, insn);
+		if (!next_offset) {
+			// encounter a broken instruction
+			next_offset = skipdata_insn(handle, code, size, offset,
+					address + offset, insn);
+			if (!next_offset) {
+				*stop = true;
+				break;
+			}
+
+			insn->detail = NULL;
+		}
+
+		offset += next_offset;
+		c++;
+
+		if (!callback((csh)handle, insn, user_data)) {
+			*stop = true;
+			break;
+		}
+	}
+
+	*consumed = offset;
+
+	return c;
+}
+
+// disassemble @code, passing each instruction to @callback
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_cb(csh ud, const uint8_t *code, size_t code_size,
+		uint64_t address, cs_insn_cb_t callback, void *user_data)
+{
+	struct cs_struct *handle;
+	size_t consumed;
+	bool stop = false;
+	cs_insn insn;
+	cs_detail detail;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+	if (!handle) {
+		return 0;
+	}
+
+	handle->errnum = CS_ERR_OK;
+
+	// reset IT block of ARM structure
+	if (handle->arch == CS_ARCH_ARM)
+		handle->ITBlock.size = 0;
+
+	return disasm_visit(handle, code, code_size, address, false, &insn, &detail,
+			callback, user_data, &consumed, &stop);
+}
+
+// disassemble code provided by @read callback, in windows of fixed size
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_stream(csh ud, cs_read_cb_t read, void *read_data,
+		uint64_t address, cs_insn_cb_t callback, void *user_data)
+{
+	struct cs_struct *handle;
+	uint8_t *window;
+	size_t len = 0, n, c = 0, consumed;
+	bool eof = false, stop = false;
+	cs_insn insn;
+	cs_detail detail;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+	if (!handle) {
+		return 0;
+	}
+
+	handle->errnum = CS_ERR_OK;
+
+	// reset IT block of ARM structure
+	if (handle->arch == CS_ARCH_ARM)
+		handle->ITBlock.size = 0;
+
+	window = handle_malloc(handle, STREAM_WINDOW_SIZE);
+	if (!window) {
+		// insufficient memory
+		handle->errnum = CS_ERR_MEM;
+		return 0;
+	}
+
+	while (!stop) {
+		// fill up the window
+		while (!eof && len < STREAM_WINDOW_SIZE) {
+			n = read(window + len, STREAM_WINDOW_SIZE - len, read_data);
+			if (!n)
+				eof = true;
+			else
+				len += n;
+		}
+
+		if (!len)
+			break;
+
+		c += disasm_visit(handle, window, len, address, !eof, &insn, &detail,
+				callback, user_data, &consumed, &stop);
+		if (eof)
+			break;
+
+		// keep the code not disassembled yet for the next window
+		memmove(window, window + consumed, len - consumed);
+		len -= consumed;
+		address += consumed;
+	}
+
+	handle_free(handle, window);
+
+	return c;
+}
+
+#ifdef CAPSTONE_HAS_THREADS
+// disassemble one instruction at position @offset of the input buffer @code,
+// which has @code_size bytes & starts at @address, allocating its @detail.
+// return number of bytes consumed, or 0 if we must stop disassembling
+static size_t disasm_at(struct cs_struct *handle, const uint8_t *code, size_t code_size,
+		size_t offset, uint64_t address, cs_insn *insn)
+{
+	size_t next_offset;
+	cs_detail detail;	// decoding buffer for CS_OPT_COMPACT_DETAIL
+
+	if (handle->detail) {
+		if (handle->compact_detail)
+			insn->detail = &detail;
+		else {
+			insn->detail = handle_malloc(handle, detail_alloc_size(handle));
+			if (!insn->detail) {
+				handle->errnum = CS_ERR_MEM;
+				return 0;
+			}
+		}
+	} else
+		insn->detail = NULL;
+
+	next_offset = decode_insn(handle, code + offset, code_size - offset,
+			address + offset, insn);
+	if (!next_offset) {
+		// encounter a broken instruction
+		if (handle->detail && !handle->compact_detail)
+			handle_free(handle, insn->detail);
+
+		insn->detail = NULL;
+		next_offset = skipdata_insn(handle, code, code_size, offset,
+				address + offset, insn);
+	} else if (handle->detail && handle->compact_detail) {
+		if (!compact_detail(handle, NULL, insn))
+			return 0;
+	} else if (handle->detail)
+		fill_regs_bitset(handle, insn);
+
+	return next_offset;
+}
+
+// free @detail of @count instructions in @insn, allocated by disasm_at()
+static void free_details(struct cs_struct *handle, cs_insn *insn, size_t count)
+{
+	size_t i;
+
+	for (i = 0; i < count; i++) {
+		if (insn[i].detail)
+			handle_free(handle, insn[i].detail);
+	}
+}
+
+// a chunk of the input of cs_disasm_parallel(), decoded by one thread
+struct disasm_chunk {
+	struct cs_struct *handle;	// private copy of user's handle
+	const uint8_t *code;	// the whole input buffer
+	size_t code_size;
+	uint64_t address;	// address of @code
+	size_t start, end;	// this chunk is [start, end) of the input
+	// dynamic memory functions of the caller, which are thread-local
+	cs_malloc_t mem_malloc;
+	cs_calloc_t mem_calloc;
+	cs_realloc_t mem_realloc;
+	cs_free_t mem_free;
+	cs_vsnprintf_t mem_vsnprintf;
+
+	// output
+	cs_insn *insn;	// instructions decoded from @start
+	bool *clean;	// decoder has no pending state (ARM IT block) before insn[i]
+	size_t count;	// number of instructions in @insn
+	size_t next;	// offset where decoding stopped
+	bool broken;	// stopped at an instruction that cannot be decoded
+	cs_err err;
+};
+
+// decode instructions from @start of @chunk, until the first instruction
+// boundary past @end where the decoder carries no state to the next one.
+// this can be the entry point of a new thread.
+static void disasm_chunk(struct disasm_chunk *chunk)
+{
+	struct cs_struct *handle = chunk->handle;
+	size_t offset = chunk->start, next_offset, cap = 0;
+	void *tmp;
+
+	cs_mem_malloc = chunk->mem_malloc;
+	cs_mem_calloc = chunk->mem_calloc;
+	cs_mem_realloc = chunk->mem_realloc;
+	cs_mem_free = chunk->mem_free;
+	cs_vsnprintf = chunk->mem_vsnprintf;
+
+	while (offset < chunk->code_size) {
+		if (offset >= chunk->end && !handle->ITBlock.size)
+			break;
+
+		if (chunk->count == cap) {
+			cap = cap ? cap * 2 : 256;
+			tmp = cs_mem_realloc(chunk->insn, cap * sizeof(cs_insn));
+			if (!tmp) {
+				chunk->err = CS_ERR_MEM;
+				break;
+			}
+			chunk->insn = tmp;
+
+			tmp = cs_mem_realloc(chunk->clean, cap * sizeof(bool));
+			if (!tmp) {
+				chunk->err = CS_ERR_MEM;
+				break;
+			}
+			chunk->clean = tmp;
+		}
+
+		chunk->clean[chunk->count] = !handle->ITBlock.size;
+
+		next_offset = disasm_at(handle, chunk->code, chunk->code_size, offset,
+				chunk->address, &chunk->insn[chunk->count]);
+		if (!next_offset) {
+			if (handle->errnum == CS_ERR_MEM)
+				chunk->err = CS_ERR_MEM;
+			chunk->broken = true;
+			break;
+		}
+
+		chunk->count++;
+		offset += next_offset;
+	}
+
+	chunk->next = offset;
+}
+
+#if defined (WIN32) || defined (WIN64) || defined (_WIN32) || defined (_WIN64)
+typedef HANDLE cs_thread_t;
+
+static DWORD WINAPI disasm_thread(LPVOID chunk)
+{
+	disasm_chunk((struct disasm_chunk *)chunk);
+
+	return 0;
+}
+
+static bool thread_start(cs_thread_t *thread, struct disasm_chunk *chunk)
+{
+	*thread = CreateThread(NULL, 0, disasm_thread, chunk, 0, NULL);
+
+	return *thread != NULL;
+}
+
+static void thread_join(cs_thread_t thread)
+{
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+}
+#else
+typedef pthread_t cs_thread_t;
+
+static void *disasm_thread(void *chunk)
+{
+	disasm_chunk((struct disasm_chunk *)chunk);
+
+	return NULL;
+}
+
+static bool thread_start(cs_thread_t *thread, struct disasm_chunk *chunk)
+{
+	return pthread_create(thread, NULL, disasm_thread, chunk) == 0;
+}
+
+static void thread_join(cs_thread_t thread)
+{
+	pthread_join(thread, NULL);
+}
+#endif
+
+// append @count instructions to the output of cs_disasm_parallel()
+static bool append_insns(struct cs_struct *handle, cs_insn **total,
+		size_t *total_count, size_t *cap, const cs_insn *insn, size_t count)
+{
+	cs_insn *tmp;
+
+	if (*total_count + count > *cap) {
+		*cap = (*total_count + count) * 8 / 5 + 16;
+		tmp = insn_array(handle, *total, *cap);
+		if (!tmp)
+			return false;
+		*total = tmp;
+	}
+
+	memcpy(*total + *total_count, insn, count * sizeof(cs_insn));
+	*total_count += count;
+
+	return true;
+}
+
+// join the instructions decoded by all the chunks, in address order.
+// where the stream of instructions runs past the end of a chunk, the
+// following chunk is resynchronized at the first of its instructions found
+// in the stream. if there is none, the stream is decoded again sequentially
+// with @handle until it reaches the end of that chunk.
+// return the number of instructions put into @total
+static size_t stitch_chunks(struct cs_struct *handle, struct disasm_chunk *chunks,
+		size_t nchunks, cs_insn **total)
+{
+	struct disasm_chunk *chunk;
+	size_t k, i, count = 0, cap = 0, pos = 0, next_offset;
+	cs_insn insn;
+	bool done = false;
+
+	*total = NULL;
+	handle->ITBlock.size = 0;
+
+	for (k = 0; k < nchunks; k++) {
+		chunk = &chunks[k];
+		i = 0;
+
+		while (!done) {
+			// drop instructions of this chunk that are behind the stream
+			while (i < chunk->count && chunk->insn[i].address - chunk->address < pos) {
+				free_details(handle, chunk->insn + i, 1);
+				i++;
+			}
+
+			if (i < chunk->count && chunk->insn[i].address - chunk->address == pos &&
+					chunk->clean[i] && !handle->ITBlock.size) {
+				// in sync with the stream: take the rest of this chunk
+				if (!append_insns(handle, total, &count, &cap, chunk->insn + i, chunk->count - i))
+					goto fail;
+
+				i = chunk->count;
+				pos = chunk->next;
+				// this chunk stopped where the decoder has no pending state
+				handle->ITBlock.size = 0;
+				done = chunk->broken;
+				break;
+			}
+
+			if (pos >= chunk->end)
+				break;
+
+			// no chunk decoded this part of the stream, so do it now
+			next_offset = disasm_at(handle, chunk->code, chunk->code_size, pos,
+					chunk->address, &insn);
+			if (!next_offset) {
+				if (handle->errnum == CS_ERR_MEM)
+					goto fail;
+				done = true;
+				break;
+			}
+
+			if (!append_insns(handle, total, &count, &cap, &insn, 1)) {
+				free_details(handle, &insn, 1);
+				goto fail;
+			}
+
+			pos += next_offset;
+		}
+
+		// free what is left of this chunk
+		free_details(handle, chunk->insn + i, chunk->count - i);
+		chunk->count = 0;
+	}
+
+	return count;
+
+fail:
+	free_details(handle, chunk->insn + i, chunk->count - i);
+	chunk->count = 0;
+	cs_free(*total, count);
+	*total = NULL;
+	handle->errnum = CS_ERR_MEM;
+
+	return 0;
+}
+#endif
+
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_parallel(csh ud, const uint8_t *code, size_t code_size,
+		uint64_t address, size_t nthreads, cs_insn **insn)
+{
+#ifdef CAPSTONE_HAS_THREADS
+	struct cs_struct *handle;
+	struct disasm_chunk chunks[PARALLEL_MAX_THREADS];
+	cs_thread_t threads[PARALLEL_MAX_THREADS];
+	bool started[PARALLEL_MAX_THREADS];
+	size_t k, chunk_size, count = 0;
+	unsigned int align;
+	cs_err err = CS_ERR_OK;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+	if (!handle)
+		return 0;
+
+	if (nthreads > PARALLEL_MAX_THREADS)
+		nthreads = PARALLEL_MAX_THREADS;
+
+	if (nthreads > code_size / PARALLEL_MIN_CHUNK)
+		nthreads = code_size / PARALLEL_MIN_CHUNK;
+
+	if (nthreads < 2)
+		// not worth it
+		return cs_disasm(ud, code, code_size, address, 0, insn);
+
+	handle->errnum = CS_ERR_OK;
+
+	// chunks start at instruction alignment, so fixed-width instructions
+	// are always in sync
+	align = skipdata_size(handle);
+	chunk_size = code_size / nthreads;
+	chunk_size -= chunk_size % align;
+
+	memset(chunks, 0, sizeof(chunks));
+	memset(started, 0, sizeof(started));
+
+	for (k = 0; k < nthreads; k++) {
+		chunks[k].handle = clone_handle(handle, &err);
+		if (!chunks[k].handle)
+			goto cleanup;
+
+		chunks[k].code = code;
+		chunks[k].code_size = code_size;
+		chunks[k].address = address;
+		chunks[k].start = k * chunk_size;
+		chunks[k].end = (k == nthreads - 1) ? code_size : (k + 1) * chunk_size;
+		chunks[k].mem_malloc = cs_mem_malloc;
+		chunks[k].mem_calloc = cs_mem_calloc;
+		chunks[k].mem_realloc = cs_mem_realloc;
+		chunks[k].mem_free = cs_mem_free;
+		chunks[k].mem_vsnprintf = cs_vsnprintf;
+	}
+
+	// the first chunk is decoded by this thread
+	for (k = 1; k < nthreads; k++)
+		started[k] = thread_start(&threads[k], &chunks[k]);
+
+	disasm_chunk(&chunks[0]);
+
+	for (k = 1; k < nthreads; k++) {
+		if (started[k])
+			thread_join(threads[k]);
+		else
+			// failed to create this thread, so do its job here
+			disasm_chunk(&chunks[k]);
+	}
+
+	for (k = 0; k < nthreads; k++) {
+		if (chunks[k].err)
+			err = chunks[k].err;
+	}
+
+	if (!err) {
+		count = stitch_chunks(handle, chunks, nthreads, insn);
+		err = handle->errnum;
+	}
+
+cleanup:
+	for (k = 0; k < nthreads; k++) {
+		if (chunks[k].insn) {
+			free_details(handle, chunks[k].insn, chunks[k].count);
+			cs_mem_free(chunks[k].insn);
+			cs_mem_free(chunks[k].clean);
+		}
+
+		if (chunks[k].handle) {
+			csh h = (uintptr_t)chunks[k].handle;
+			cs_close(&h);
+		}
+	}
+
+	if (err) {
+		*insn = NULL;
+		handle->errnum = err;
+		return 0;
+	}
+
+	return count;
+#else
+	// no thread support, so just disassemble sequentially
+	(void)nthreads;
+
+	return cs_disasm(ud, code, code_size, address, 0, insn);
+#endif
+}
+
+// return length of the instruction at @code, or 0 if it is invalid
+static uint16_t insn_length(struct cs_struct *handle, const uint8_t *code, size_t size,
+		uint64_t address)
+{
+	MCInst mci;
+	cs_insn insn;
+	uint16_t insn_size;
+	cs_opt_value detail;
+	bool ok;
+
+	if (handle->insn_length)
+		return handle->insn_length((csh)handle, code, size, address);
+
+	// decode without detail, and do not go any further.
+	// some decoders write to the detail when this option is on, so turn it
+	// off meanwhile
+	detail = handle->detail;
+	handle->detail = CS_OPT_OFF;
+
+	MCInst_Init(&mci);
+	mci.csh = handle;
+	mci.address = address;
+	mci.flat_insn = &insn;
+	insn.address = address;
+	insn.detail = NULL;
+
+	ok = handle->disasm((csh)handle, code, size, &mci, &insn_size, address, handle->getinsn_info);
+
+	handle->detail = detail;
+
+	return ok ? insn_size : 0;
+}
+
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_insn_length(csh ud, const uint8_t *code, size_t code_size,
+		uint64_t address)
+{
+	struct cs_struct *handle;
+	ARM_ITStatus it_block;
+	uint16_t size;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+	if (!handle) {
+		return 0;
+	}
+
+	handle->errnum = CS_ERR_OK;
+
+	// the decoder of ARM updates the IT block, so restore it afterwards
+	it_block = handle->ITBlock;
+	size = insn_length(handle, code, code_size, address);
+	handle->ITBlock = it_block;
+
+	return size;
+}
+
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_insn_lengths(csh ud, const uint8_t *code, size_t code_size,
+		uint64_t address, uint16_t *lengths, size_t count)
+{
+	struct cs_struct *handle;
+	size_t offset = 0, c;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+	if (!handle) {
+		return 0;
+	}
+
+	handle->errnum = CS_ERR_OK;
+
+	// reset IT block of ARM structure
+	if (handle->arch == CS_ARCH_ARM)
+		handle->ITBlock.size = 0;
+
+	for (c = 0; c < count && offset < code_size; c++) {
+		lengths[c] = insn_length(handle, code + offset, code_size - offset,
+				address + offset);
+		if (!lengths[c])
+			break;
+
+		offset += lengths[c];
+	}
+
+	return c;
+}
+
+// columns being filled in by cs_disasm_columns(): each array is allocated
+// alone & grows, until all are packed into one allocation by pack_columns()
+struct column_buf {
+	cs_columns cols;
+	size_t insn_max;	// number of instructions the arrays have room for
+	size_t op_max;	// number of operands the operand arrays have room for
+	size_t text_max;	// number of bytes @cols.text has room for
+	bool groups;	// fill in @cols.groups (detail mode)
+	bool text;	// fill in the text columns (text is rendered)
+};
+
+// minimum number of elements of a growing column
+#define COLUMN_MIN 256
+
+// round @n up so the next column is aligned for any of its elements
+#define COLUMN_ALIGN(n) (((n) + 7) & ~(size_t)7)
+
+static bool column_grow(struct cs_struct *handle, void **array, size_t size)
+{
+	void *tmp = handle_realloc(handle, *array, size);
+
+	if (!tmp)
+		return false;
+
+	*array = tmp;
+
+	return true;
+}
+
+// give the instruction columns of @buf room for at least one more instruction
+static bool column_grow_insns(struct cs_struct *handle, struct column_buf *buf)
+{
+	cs_columns *cols = &buf->cols;
+	size_t n = buf->insn_max ? buf->insn_max * 2 : COLUMN_MIN;
+
+	if (!column_grow(handle, (void **)&cols->address, n * sizeof(cols->address[0])) ||
+			!column_grow(handle, (void **)&cols->size, n * sizeof(cols->size[0])) ||
+			!column_grow(handle, (void **)&cols->id, n * sizeof(cols->id[0])) ||
+			!column_grow(handle, (void **)&cols->op_count, n * sizeof(cols->op_count[0])) ||
+			// one more to mark the end of the operands of the last instruction
+			!column_grow(handle, (void **)&cols->op_first, (n + 1) * sizeof(cols->op_first[0])))
+		return false;
+
+	if (buf->groups && !column_grow(handle, (void **)&cols->groups,
+				n * CS_COLUMN_GROUP_WORDS * sizeof(cols->groups[0])))
+		return false;
+
+	if (buf->text && (!column_grow(handle, (void **)&cols->mnemonic, n * sizeof(cols->mnemonic[0])) ||
+				!column_grow(handle, (void **)&cols->op_str, n * sizeof(cols->op_str[0]))))
+		return false;
+
+	buf->insn_max = n;
+
+	return true;
+}
+
+// give the operand columns of @buf room for at least @count more operands
+static bool column_grow_ops(struct cs_struct *handle, struct column_buf *buf, size_t count)
+{
+	cs_columns *cols = &buf->cols;
+	size_t n = buf->op_max ? buf->op_max : COLUMN_MIN;
+
+	while (n < cols->op_total + count)
+		n *= 2;
+
+	if (n == buf->op_max)
+		return true;
+
+	// operand indexes must fit into op_first[]
+	if (n > (uint32_t)-1)
+		return false;
+
+	if (!column_grow(handle, (void **)&cols->op_type, n * sizeof(cols->op_type[0])) ||
+			!column_grow(handle, (void **)&cols->op_access, n * sizeof(cols->op_access[0])) ||
+			!column_grow(handle, (void **)&cols->op_reg, n * sizeof(cols->op_reg[0])) ||
+			!column_grow(handle, (void **)&cols->op_mem_index, n * sizeof(cols->op_mem_index[0])) ||
+			!column_grow(handle, (void **)&cols->op_imm, n * sizeof(cols->op_imm[0])))
+		return false;
+
+	buf->op_max = n;
+
+	return true;
+}
+
+// append @str & its terminating 0 to the text column of @buf.
+// return the offset of @str in the text column, or (size_t)-1 if there is
+// not enough memory
+static size_t column_text(struct cs_struct *handle, struct column_buf *buf, const char *str)
+{
+	cs_columns *cols = &buf->cols;
+	size_t len = strlen(str) + 1, n, offset;
+
+	if (cols->text_size + len > buf->text_max) {
+		n = buf->text_max ? buf->text_max * 2 : COLUMN_MIN * 16;
+		while (n < cols->text_size + len)
+			n *= 2;
+
+		if (!column_grow(handle, (void **)&cols->text, n))
+			return (size_t)-1;
+
+		buf->text_max = n;
+	}
+
+	offset = cols->text_size;
+	memcpy(cols->text + offset, str, len);
+	cols->text_size += len;
 
-	return c;
+	return offset;
 }
 
-CAPSTONE_EXPORT
-void CAPSTONE_API cs_free(cs_insn *insn, size_t count)
+static void column_free(struct cs_struct *handle, cs_columns *cols)
 {
-	size_t i;
+	handle_free(handle, cols->address);
+	handle_free(handle, cols->size);
+	handle_free(handle, cols->id);
+	handle_free(handle, cols->groups);
+	handle_free(handle, cols->text);
+	handle_free(handle, cols->mnemonic);
+	handle_free(handle, cols->op_str);
+	handle_free(handle, cols->op_count);
+	handle_free(handle, cols->op_first);
+	handle_free(handle, cols->op_type);
+	handle_free(handle, cols->op_access);
+	handle_free(handle, cols->op_reg);
+	handle_free(handle, cols->op_mem_index);
+	handle_free(handle, cols->op_imm);
+}
 
-	// free all detail pointers
-	for (i = 0; i < count; i++)
-		cs_mem_free(insn[i].detail);
+// append one operand to the operand columns of @cols
+static void column_op(cs_columns *cols, uint8_t type, uint8_t access,
+		unsigned int reg, unsigned int index, int64_t imm)
+{
+	size_t i = cols->op_total++;
 
-	// then free pointer to cs_insn array
-	cs_mem_free(insn);
+	cols->op_type[i] = type;
+	cols->op_access[i] = access;
+	cols->op_reg[i] = (uint16_t)reg;
+	cols->op_mem_index[i] = (uint16_t)index;
+	cols->op_imm[i] = imm;
 }
 
-CAPSTONE_EXPORT
-cs_insn * CAPSTONE_API cs_malloc(csh ud)
+// raw bits of a floating point operand, for op_imm[]
+static int64_t column_fp(double fp)
 {
-	cs_insn *insn;
-	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
+	int64_t bits;
 
-	insn = cs_mem_malloc(sizeof(cs_insn));
-	if (!insn) {
-		// insufficient memory
-		handle->errnum = CS_ERR_MEM;
-		return NULL;
-	} else {
-		if (handle->detail) {
-			// allocate memory for @detail pointer
-			insn->detail = cs_mem_malloc(sizeof(cs_detail));
-			if (insn->detail == NULL) {	// insufficient memory
-				cs_mem_free(insn);
-				handle->errnum = CS_ERR_MEM;
-				return NULL;
+	memcpy(&bits, &fp, sizeof(bits));
+
+	return bits;
+}
+
+// append the operands in @detail to the operand columns of @cols, which must
+// have room for all of them
+static void column_ops(cs_arch arch, const cs_detail *detail, cs_columns *cols)
+{
+	unsigned int i;
+
+	switch (arch) {
+		default:
+			break;
+#ifdef CAPSTONE_HAS_X86
+		case CS_ARCH_X86:
+			for (i = 0; i < detail->x86.op_count; i++) {
+				const cs_x86_op *op = &detail->x86.operands[i];
+
+				switch ((int)op->type) {
+					default:
+						column_op(cols, op->type, op->access, 0, 0, 0);
+						break;
+					case X86_OP_REG:
+						column_op(cols, op->type, op->access, op->reg, 0, 0);
+						break;
+					case X86_OP_IMM:
+						column_op(cols, op->type, op->access, 0, 0, op->imm);
+						break;
+					case X86_OP_MEM:
+						column_op(cols, op->type, op->access, op->mem.base, op->mem.index, op->mem.disp);
+						break;
+				}
 			}
-		} else
-			insn->detail = NULL;
+			break;
+#endif
+#ifdef CAPSTONE_HAS_ARM
+		case CS_ARCH_ARM:
+			for (i = 0; i < detail->arm.op_count; i++) {
+				const cs_arm_op *op = &detail->arm.operands[i];
+
+				switch ((int)op->type) {
+					default:
+						column_op(cols, op->type, op->access, 0, 0, 0);
+						break;
+					case ARM_OP_REG:
+					case ARM_OP_SYSREG:
+						column_op(cols, op->type, op->access, op->reg, 0, 0);
+						break;
+					case ARM_OP_IMM:
+					case ARM_OP_CIMM:
+					case ARM_OP_PIMM:
+						column_op(cols, op->type, op->access, 0, 0, op->imm);
+						break;
+					case ARM_OP_MEM:
+						column_op(cols, op->type, op->access, op->mem.base, op->mem.index, op->mem.disp);
+						break;
+					case ARM_OP_FP:
+						column_op(cols, op->type, op->access, 0, 0, column_fp(op->fp));
+						break;
+					case ARM_OP_SETEND:
+						column_op(cols, op->type, op->access, 0, 0, op->setend);
+						break;
+				}
+			}
+			break;
+#endif
+#ifdef CAPSTONE_HAS_ARM64
+		case CS_ARCH_ARM64:
+			for (i = 0; i < detail->arm64.op_count; i++) {
+				const cs_arm64_op *op = &detail->arm64.operands[i];
+
+				switch ((int)op->type) {
+					default:
+						column_op(cols, op->type, op->access, 0, 0, 0);
+						break;
+					case ARM64_OP_REG:
+					case ARM64_OP_REG_MRS:
+					case ARM64_OP_REG_MSR:
+						column_op(cols, op->type, op->access, op->reg, 0, 0);
+						break;
+					case ARM64_OP_IMM:
+					case ARM64_OP_CIMM:
+						column_op(cols, op->type, op->access, 0, 0, op->imm);
+						break;
+					case ARM64_OP_MEM:
+						column_op(cols, op->type, op->access, op->mem.base, op->mem.index, op->mem.disp);
+						break;
+					case ARM64_OP_FP:
+						column_op(cols, op->type, op->access, 0, 0, column_fp(op->fp));
+						break;
+					case ARM64_OP_PSTATE:
+						column_op(cols, op->type, op->access, 0, 0, op->pstate);
+						break;
+					case ARM64_OP_SYS:
+						column_op(cols, op->type, op->access, 0, 0, op->sys);
+						break;
+					case ARM64_OP_PREFETCH:
+						column_op(cols, op->type, op->access, 0, 0, op->prefetch);
+						break;
+					case ARM64_OP_BARRIER:
+						column_op(cols, op->type, op->access, 0, 0, op->barrier);
+						break;
+				}
+			}
+			break;
+#endif
+#ifdef CAPSTONE_HAS_RISCV
+		case CS_ARCH_RISCV:
+			for (i = 0; i < detail->riscv.op_count; i++) {
+				const cs_riscv_op *op = &detail->riscv.operands[i];
+
+				switch ((int)op->type) {
+					default:
+						column_op(cols, op->type, 0, 0, 0, 0);
+						break;
+					case RISCV_OP_REG:
+						column_op(cols, op->type, 0, op->reg, 0, 0);
+						break;
+					case RISCV_OP_IMM:
+						column_op(cols, op->type, 0, 0, 0, op->imm);
+						break;
+					case RISCV_OP_MEM:
+						column_op(cols, op->type, 0, op->mem.base, 0, op->mem.disp);
+						break;
+				}
+			}
+			break;
+#endif
 	}
+}
 
-	return insn;
+// copy the @count elements of @size bytes of column @array to @p, then
+// point @array there.
+// return the position following the column
+static uint8_t *column_pack(uint8_t *p, void **array, size_t count, size_t size)
+{
+	if (!*array)
+		// column not filled in
+		return p;
+
+	if (count)
+		memcpy(p, *array, count * size);
+
+	*array = p;
+
+	return p + count * size;
+}
+
+// pack all the columns of @cols into one allocation, which can be released
+// with cs_free_columns(). the columns of @cols are left untouched.
+// return NULL if there is not enough memory
+static cs_columns *pack_columns(struct cs_struct *handle, const cs_columns *cols)
+{
+	struct insn_header *header;
+	cs_columns *packed;
+	uint8_t *p;
+	size_t n = cols->count, ops = cols->op_total;
+	size_t groups = cols->groups ? n * CS_COLUMN_GROUP_WORDS : 0;
+	size_t text = cols->text ? n : 0;
+	size_t size = COLUMN_ALIGN(sizeof(*header) + sizeof(*packed));
+
+	// biggest elements first, so all columns are aligned
+	size += n * sizeof(cols->address[0]) + groups * sizeof(cols->groups[0]) +
+		text * sizeof(cols->mnemonic[0]) + text * sizeof(cols->op_str[0]) +
+		ops * sizeof(cols->op_imm[0]) +
+		n * sizeof(cols->id[0]) + (n + 1) * sizeof(cols->op_first[0]) +
+		n * sizeof(cols->size[0]) + ops * sizeof(cols->op_reg[0]) +
+		ops * sizeof(cols->op_mem_index[0]) +
+		n * sizeof(cols->op_count[0]) + ops * sizeof(cols->op_type[0]) +
+		ops * sizeof(cols->op_access[0]) + cols->text_size;
+
+	header = handle_malloc(handle, size);
+	if (!header)
+		return NULL;
+
+	header->mem_free = handle->mem_free;
+	header->free = handle->mem.malloc ? handle->mem.free : NULL;
+	header->ctx = handle->mem.ctx;
+	header->arena = NULL;
+
+	packed = (cs_columns *)(header + 1);
+	*packed = *cols;
+
+	p = (uint8_t *)header + COLUMN_ALIGN(sizeof(*header) + sizeof(*packed));
+	p = column_pack(p, (void **)&packed->address, n, sizeof(cols->address[0]));
+	p = column_pack(p, (void **)&packed->groups, groups, sizeof(cols->groups[0]));
+	p = column_pack(p, (void **)&packed->mnemonic, text, sizeof(cols->mnemonic[0]));
+	p = column_pack(p, (void **)&packed->op_str, text, sizeof(cols->op_str[0]));
+	p = column_pack(p, (void **)&packed->op_imm, ops, sizeof(cols->op_imm[0]));
+	p = column_pack(p, (void **)&packed->id, n, sizeof(cols->id[0]));
+	p = column_pack(p, (void **)&packed->op_first, n + 1, sizeof(cols->op_first[0]));
+	p = column_pack(p, (void **)&packed->size, n, sizeof(cols->size[0]));
+	p = column_pack(p, (void **)&packed->op_reg, ops, sizeof(cols->op_reg[0]));
+	p = column_pack(p, (void **)&packed->op_mem_index, ops, sizeof(cols->op_mem_index[0]));
+	p = column_pack(p, (void **)&packed->op_count, n, sizeof(cols->op_count[0]));
+	p = column_pack(p, (void **)&packed->op_type, ops, sizeof(cols->op_type[0]));
+	p = column_pack(p, (void **)&packed->op_access, ops, sizeof(cols->op_access[0]));
+	column_pack(p, (void **)&packed->text, cols->text_size, 1);
+
+	return packed;
 }
 
-// iterator for instruction "single-stepping"
 CAPSTONE_EXPORT
-bool CAPSTONE_API cs_disasm_iter(csh ud, const uint8_t **code, size_t *size,
-		uint64_t *address, cs_insn *insn)
+size_t CAPSTONE_API cs_disasm_columns(csh ud, const uint8_t *code, size_t code_size,
+		uint64_t address, size_t count, cs_columns **columns)
 {
 	struct cs_struct *handle;
-	uint16_t insn_size;
-	MCInst mci;
-	bool r;
+	struct column_buf buf;
+	cs_columns *cols = &buf.cols;
+	size_t offset = 0, next_offset, n, detail_size, c = 0;
+	cs_insn insn;
+	cs_detail detail;
 
 	handle = (struct cs_struct *)(uintptr_t)ud;
 	if (!handle) {
-		return false;
+		return 0;
 	}
 
 	handle->errnum = CS_ERR_OK;
+	*columns = NULL;
 
-	MCInst_Init(&mci);
-	mci.csh = handle;
-
-	// relative branches need to know the address & size of current insn
-	mci.address = *address;
+	// reset IT block of ARM structure
+	if (handle->arch == CS_ARCH_ARM)
+		handle->ITBlock.size = 0;
 
-	// save all the information for non-detailed mode
-	mci.flat_insn = insn;
-	mci.flat_insn->address = *address;
-#ifdef CAPSTONE_DIET
-	// zero out mnemonic & op_str
-	mci.flat_insn->mnemonic[0] = '\0';
-	mci.flat_insn->op_str[0] = '\0';
+	memset(&buf, 0, sizeof(buf));
+	buf.groups = handle->detail != CS_OPT_OFF;
+#ifndef CAPSTONE_DIET
+	buf.text = !handle->no_text;
 #endif
 
-	r = handle->disasm(ud, *code, *size, &mci, &insn_size, *address, handle->getinsn_info);
-	if (r) {
-		SStream ss;
-		SStream_Init(&ss);
+	while (offset < code_size && (!count || c < count)) {
+		if (c == buf.insn_max && !column_grow_insns(handle, &buf))
+			goto fail;
 
-		mci.flat_insn->size = insn_size;
+		insn.detail = handle->detail ? &detail : NULL;
 
-		// map internal instruction opcode to public insn ID
-		handle->insn_id(handle, insn, mci.Opcode);
+		next_offset = decode_insn(handle, code + offset, code_size - offset,
+				address + offset, &insn);
+		if (!next_offset) {
+			// encounter a broken instruction
+			next_offset = skipdata_insn(handle, code, code_size, offset,
+					address + offset, &insn);
+			if (!next_offset)
+				break;
 
-		handle->printer(&mci, &ss, handle->printer_info);
+			insn.detail = NULL;
+		}
 
-		fill_insn(handle, insn, ss.buffer, &mci, handle->post_printer, *code);
+		cols->address[c] = insn.address;
+		cols->size[c] = insn.size;
+		cols->id[c] = insn.id;
+		cols->op_first[c] = (uint32_t)cols->op_total;
 
-		// adjust for pseudo opcode (X86)
-		if (handle->arch == CS_ARCH_X86)
-			insn->id += mci.popcode_adjust;
+		if (buf.groups) {
+			uint64_t *groups = cols->groups + c * CS_COLUMN_GROUP_WORDS;
 
-		*code += insn_size;
-		*size -= insn_size;
-		*address += insn_size;
-	} else { 	// encounter a broken instruction
-		size_t skipdata_bytes;
+			memset(groups, 0, CS_COLUMN_GROUP_WORDS * sizeof(groups[0]));
+			for (n = 0; insn.detail && n < insn.detail->groups_count; n++)
+				groups[insn.detail->groups[n] / 64] |=
+					(uint64_t)1 << (insn.detail->groups[n] % 64);
+		}
 
-		// if there is no request to skip data, or remaining data is too small,
-		// then bail out
-		if (!handle->skipdata || handle->skipdata_size > *size)
-			return false;
+		if (buf.text) {
+			cols->mnemonic[c] = column_text(handle, &buf, insn.mnemonic);
+			cols->op_str[c] = column_text(handle, &buf, insn.op_str);
+			if (cols->mnemonic[c] == (size_t)-1 || cols->op_str[c] == (size_t)-1)
+				goto fail;
+		}
 
-		if (handle->skipdata_setup.callback) {
-			skipdata_bytes = handle->skipdata_setup.callback(*code, *size,
-					0, handle->skipdata_setup.user_data);
-			if (skipdata_bytes > *size)
-				// remaining data is not enough
-				return false;
+		if (insn.detail) {
+			n = detail_ops(handle->arch, insn.detail, &detail_size);
+			if (!column_grow_ops(handle, &buf, n))
+				goto fail;
 
-			if (!skipdata_bytes)
-				// user requested not to skip data, so bail out
-				return false;
-		} else
-			skipdata_bytes = handle->skipdata_size;
+			column_ops(handle->arch, insn.detail, cols);
+		}
+
+		cols->op_count[c] = (uint8_t)(cols->op_total - cols->op_first[c]);
+
+		offset += next_offset;
+		c++;
+	}
+
+	if (c) {
+		cols->count = c;
+		cols->op_first[c] = (uint32_t)cols->op_total;
+
+		*columns = pack_columns(handle, cols);
+		if (!*columns)
+			goto fail;
+	}
+
+	column_free(handle, cols);
+
+	return c;
+
+fail:
+	column_free(handle, cols);
+	handle->errnum = CS_ERR_MEM;
+
+	return 0;
+}
+
+CAPSTONE_EXPORT
+void CAPSTONE_API cs_free_columns(cs_columns *columns)
+{
+	struct insn_header *header;
+
+	if (!columns)
+		return;
+
+	header = (struct insn_header *)columns - 1;
+	header_free(header, header);
+}
+
+#ifndef CAPSTONE_DIET
+// render text of @insn into @mnemonic & @op_str of @out, by decoding the
+// instruction bytes kept in @insn again.
+// the handle state must be left untouched for the ongoing disassembling,
+// and @insn->detail must not be overwritten.
+// detail mode is kept as it is, since some printers render more with it
+// (like the functional unit of TMS320C64x), so decode into a scratch detail
+static cs_err render_text(struct cs_struct *handle, const cs_insn *insn, cs_insn *out)
+{
+	cs_detail detail;
+	bool no_text;
+	ARM_ITStatus it_block;
+	size_t size;
+
+	no_text = handle->no_text;
+	it_block = handle->ITBlock;
+	handle->no_text = false;
+
+	out->detail = handle->detail ? &detail : NULL;
+	size = decode_insn(handle, insn->bytes, insn->size, insn->address, out);
+
+	handle->no_text = no_text;
+	handle->ITBlock = it_block;
+
+	if (!size) {
+		// these bytes cannot be decoded with the current mode of this handle
+		handle->errnum = CS_ERR_MODE;
+		return CS_ERR_MODE;
+	}
+
+	return CS_ERR_OK;
+}
+#endif
+
+// render text of an instruction disassembled with CS_OPT_NO_TEXT
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_insn_text(csh ud, cs_insn *insn)
+{
+	struct cs_struct *handle;
+#ifndef CAPSTONE_DIET
+	cs_insn tmp;
+	cs_err err;
+#endif
+
+	if (!ud)
+		return CS_ERR_CSH;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
 
-		// we have to skip some amount of data, depending on arch & mode
-		insn->id = 0;	// invalid ID for this "data" instruction
-		insn->address = *address;
-		insn->size = (uint16_t)skipdata_bytes;
 #ifdef CAPSTONE_DIET
-		insn->mnemonic[0] = '\0';
-		insn->op_str[0] = '\0';
+	// This API does not work in DIET mode
+	handle->errnum = CS_ERR_DIET;
+	return CS_ERR_DIET;
 #else
-		memcpy(insn->bytes, *code, skipdata_bytes);
-		strncpy(insn->mnemonic, handle->skipdata_setup.mnemonic,
-				sizeof(insn->mnemonic) - 1);
-		skipdata_opstr(insn->op_str, *code, skipdata_bytes);
+	if (!insn->id || insn->mnemonic[0])
+		// "data" instruction of SKIPDATA mode always has its text,
+		// so do instructions of an ARM IT block
+		return CS_ERR_OK;
+
+	err = render_text(handle, insn, &tmp);
+	if (err)
+		return err;
+
+	memcpy(insn->mnemonic, tmp.mnemonic, sizeof(insn->mnemonic));
+	memcpy(insn->op_str, tmp.op_str, sizeof(insn->op_str));
+
+	return CS_ERR_OK;
+#endif
+}
+
+// render full text of an instruction into a user-provided buffer
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_format_insn(csh ud, const cs_insn *insn, char *buf, size_t len)
+{
+	struct cs_struct *handle;
+#ifndef CAPSTONE_DIET
+	cs_insn tmp;
+	cs_err err;
 #endif
 
-		*code += skipdata_bytes;
-		*size -= skipdata_bytes;
-		*address += skipdata_bytes;
+	if (!ud)
+		return CS_ERR_CSH;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+
+#ifdef CAPSTONE_DIET
+	// This API does not work in DIET mode
+	handle->errnum = CS_ERR_DIET;
+	return CS_ERR_DIET;
+#else
+	if (!insn || !buf || !len) {
+		handle->errnum = CS_ERR_OPTION;
+		return CS_ERR_OPTION;
+	}
+
+	// only decode again if the text was not rendered at disassembling time
+	if (!insn->mnemonic[0] && insn->id) {
+		err = render_text(handle, insn, &tmp);
+		if (err)
+			return err;
+
+		insn = &tmp;
 	}
 
-	return true;
+	if (insn->op_str[0])
+		cs_snprintf(buf, len, "%s %s", insn->mnemonic, insn->op_str);
+	else
+		cs_snprintf(buf, len, "%s", insn->mnemonic);
+
+	// _vsnprintf() of Windows does not terminate a truncated string
+	buf[len - 1] = '\0';
+
+	return CS_ERR_OK;
+#endif
 }
 
 // return friendly name of regiser in a string
@@ -1249,6 +2937,10 @@ bool CAPSTONE_API cs_reg_read(csh ud, const cs_insn *insn, unsigned int reg_id)
 		return false;
 	}
 
+	// the implicit registers are among all the registers accessed
+	if (insn->detail->regs_bitset && !CS_REGS_BITSET_HAS(DETAIL_BITSETS(insn->detail)->read, reg_id))
+		return false;
+
 	return arr_exist(insn->detail->regs_read, insn->detail->regs_read_count, reg_id);
 }
 
@@ -1276,6 +2968,10 @@ bool CAPSTONE_API cs_reg_write(csh ud, const cs_insn *insn, unsigned int reg_id)
 		return false;
 	}
 
+	// the implicit registers are among all the registers accessed
+	if (insn->detail->regs_bitset && !CS_REGS_BITSET_HAS(DETAIL_BITSETS(insn->detail)->write, reg_id))
+		return false;
+
 	return arr_exist(insn->detail->regs_write, insn->detail->regs_write_count, reg_id);
 }
 
@@ -1570,6 +3266,74 @@ int CAPSTONE_API cs_op_index(csh ud, const cs_insn *insn, unsigned int op_type,
 	return -1;
 }
 
+CAPSTONE_EXPORT
+int CAPSTONE_API cs_detail_op_count(csh ud, const cs_insn *insn)
+{
+	struct cs_struct *handle;
+	size_t size;
+
+	if (!ud)
+		return -1;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+
+	if (!handle->detail) {
+		handle->errnum = CS_ERR_DETAIL;
+		return -1;
+	}
+
+	if (!insn->id) {
+		handle->errnum = CS_ERR_SKIPDATA;
+		return -1;
+	}
+
+	if (!insn->detail) {
+		handle->errnum = CS_ERR_DETAIL;
+		return -1;
+	}
+
+	handle->errnum = CS_ERR_OK;
+
+	return (int)detail_ops(handle->arch, insn->detail, &size);
+}
+
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_detail_size(csh ud, const cs_insn *insn)
+{
+	struct cs_struct *handle;
+	size_t size;
+
+	if (!ud)
+		return 0;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+
+	if (!handle->detail) {
+		handle->errnum = CS_ERR_DETAIL;
+		return 0;
+	}
+
+	if (!insn->id) {
+		handle->errnum = CS_ERR_SKIPDATA;
+		return 0;
+	}
+
+	if (!insn->detail) {
+		handle->errnum = CS_ERR_DETAIL;
+		return 0;
+	}
+
+	handle->errnum = CS_ERR_OK;
+
+	detail_ops(handle->arch, insn->detail, &size);
+
+	// register bitsets of CS_OPT_REGS_BITSET follow the full cs_detail
+	if (insn->detail->regs_bitset)
+		size = sizeof(cs_detail) + sizeof(struct detail_bitsets);
+
+	return size;
+}
+
 CAPSTONE_EXPORT
 cs_err CAPSTONE_API cs_regs_access(csh ud, const cs_insn *insn,
 		cs_regs regs_read, uint8_t *regs_read_count,
@@ -1613,3 +3377,31 @@ cs_err CAPSTONE_API cs_regs_access(csh ud, const cs_insn *insn,
 	return CS_ERR_OK;
 #endif
 }
+
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_regs_access_bitset(csh ud, const cs_insn *insn,
+		cs_regs_bitset regs_read, cs_regs_bitset regs_write)
+{
+	cs_regs read, write;
+	uint8_t read_count, write_count;
+	cs_err err;
+
+#ifndef CAPSTONE_DIET
+	// already computed while decoding, with CS_OPT_REGS_BITSET
+	if (ud && insn->id && insn->detail && insn->detail->regs_bitset) {
+		memcpy(regs_read, DETAIL_BITSETS(insn->detail)->read, sizeof(cs_regs_bitset));
+		memcpy(regs_write, DETAIL_BITSETS(insn->detail)->write, sizeof(cs_regs_bitset));
+		((struct cs_struct *)(uintptr_t)ud)->errnum = CS_ERR_OK;
+		return CS_ERR_OK;
+	}
+#endif
+
+	err = cs_regs_access(ud, insn, read, &read_count, write, &write_count);
+	if (err != CS_ERR_OK)
+		return err;
+
+	regs_bitset_fill(regs_read, read, read_count);
+	regs_bitset_fill(regs_write, write, write_count);
+
+	return CS_ERR_OK;
+}
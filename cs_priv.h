@@ -20,6 +20,17 @@ typedef void (*PostPrinter_t)(csh handle, cs_insn *, char *mnem, MCInst *mci);
 
 typedef bool (*Disasm_t)(csh handle, const uint8_t *code, size_t code_len, MCInst *instr, uint16_t *size, uint64_t address, void *info);
 
+// return length of the instruction at @code, or 0 if it is invalid.
+// unlike Disasm_t, this does not need to build the MCInst
+typedef uint16_t (*InsnLength_t)(csh handle, const uint8_t *code, size_t code_len, uint64_t address);
+
+// decode the instruction at @code straight into @insn: its id, its detail if
+// @insn->detail is not NULL, and its mnemonic & op_str unless handle->no_text.
+// @insn->address is already set, and the core fills in bytes & size.
+// put the length of the instruction into @size, and return false if it is invalid.
+// unlike Disasm_t, this skips the MCInst, the printer & the parsing of its text
+typedef bool (*DisasmInsn_t)(cs_struct *handle, const uint8_t *code, size_t code_len, cs_insn *insn, uint16_t *size);
+
 typedef const char *(*GetName_t)(csh handle, unsigned int id);
 
 typedef void (*GetID_t)(cs_struct *h, cs_insn *insn, unsigned int id);
@@ -48,7 +59,8 @@ struct customized_mnem {
 
 struct insn_mnem {
 	struct customized_mnem insn;
-	struct insn_mnem *next;	// linked list of customized mnemonics
+	uint8_t name_len;	// length of the default mnemonic, replaced by @insn.mnemonic
+	uint8_t len;	// length of @insn.mnemonic
 };
 
 struct cs_struct {
@@ -57,6 +69,8 @@ struct cs_struct {
 	Printer_t printer;	// asm printer
 	void *printer_info; // aux info for printer
 	Disasm_t disasm;	// disassembler
+	InsnLength_t insn_length;	// fast path of cs_insn_length(), or NULL to use @disasm
+	DisasmInsn_t disasm_insn;	// fast path of all disassembling APIs, or NULL to use @disasm & @printer
 	void *getinsn_info; // auxiliary info for printer
 	GetName_t reg_name;
 	GetName_t insn_name;
@@ -68,14 +82,23 @@ struct cs_struct {
 	cs_opt_value detail, imm_unsigned;
 	int syntax;	// asm syntax for simple printer such as ARM, Mips & PPC
 	bool doing_mem;	// handling memory operand in InstPrinter code
-	unsigned short *insn_cache;	// index caching for mapping.c
 	GetRegisterName_t get_regname;
 	bool skipdata;	// set this to True if we skip data when disassembling
 	uint8_t skipdata_size;	// how many bytes to skip
 	cs_opt_skipdata skipdata_setup;	// user-defined skipdata setup
 	const uint8_t *regsize_map;	// map to register size (x86-only for now)
 	GetRegisterAccess_t reg_access;
-	struct insn_mnem *mnem_list;	// linked list of customized instruction mnemonic
+	struct insn_mnem **mnem_table;	// customized instruction mnemonic, indexed by instruction ID
+	unsigned int mnem_size;	// number of entries in @mnem_table
+	bool no_text;	// do not render mnemonic & op_str (CS_OPT_NO_TEXT)
+	bool compact_detail;	// allocate only the used part of cs_detail (CS_OPT_COMPACT_DETAIL)
+	// dynamic memory functions of the thread calling cs_open(), see CS_OPT_MEM
+	cs_malloc_t mem_malloc;
+	cs_realloc_t mem_realloc;
+	cs_free_t mem_free;
+	cs_opt_mem_ctx mem;	// user-defined memory functions, if mem.malloc is set (CS_OPT_MEM_CTX)
+	bool arena;	// allocate details of cs_disasm() in blocks (CS_OPT_ARENA)
+	bool regs_bitset;	// fill register bitsets of details while decoding (CS_OPT_REGS_BITSET)
 };
 
 #define MAX_ARCH CS_ARCH_MAX
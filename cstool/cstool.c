@@ -1,11 +1,19 @@
 /* Tang Yuhang <tyh000011112222@gmail.com> 2016 */
 /* pancake <pancake@nopcode.org> 2017 */
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 #include <errno.h>
+#include <time.h>
 #include "getopt.h"
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include <capstone/capstone.h>
 
 void print_string_hex(const char *comment, unsigned char *str, size_t len);
@@ -173,6 +181,7 @@ static void usage(char *prog)
 {
 	printf("Cstool for Capstone Disassembler Engine v%u.%u.%u\n\n", CS_VERSION_MAJOR, CS_VERSION_MINOR, CS_VERSION_EXTRA);
 	printf("Syntax: %s [-d|-s|-u|-v] <arch+mode> <assembly-hexstring> [start-address-in-hex-format]\n", prog);
+	printf("        %s [-d|-s|-u|-b] [-F format] -f <file> [-o offset] [-l length] [-m] <arch+mode> [start-address-in-hex-format]\n", prog);
 	printf("\nThe following <arch+mode> options are supported:\n");
 
 	if (cs_support(CS_ARCH_X86)) {
@@ -290,7 +299,13 @@ static void usage(char *prog)
 	printf("        -d show detailed information of the instructions\n");
 	printf("        -s decode in SKIPDATA mode\n");
 	printf("        -u show immediates as unsigned\n");
-	printf("        -v show version & Capstone core build info\n\n");
+	printf("        -v show version & Capstone core build info\n");
+	printf("        -f <file> disassemble raw bytes of <file> instead of a hexstring\n");
+	printf("        -o <offset> start at <offset> in <file> (decimal or 0x hex)\n");
+	printf("        -l <length> disassemble at most <length> bytes of <file> (decimal or 0x hex)\n");
+	printf("        -m map <file> into memory instead of reading it\n");
+	printf("        -F <format> output format: text (default), json (one object per line) or csv\n");
+	printf("        -b, --bench report instructions/sec, bytes/sec & time without text, with text and with detail\n\n");
 }
 
 static void print_details(csh handle, cs_arch arch, cs_mode md, cs_insn *ins)
@@ -362,14 +377,412 @@ static void print_details(csh handle, cs_arch arch, cs_mode md, cs_insn *ins)
 	printf("\n");
 }
 
+// size of the stdout buffer, so that output goes out in large writes
+#define OUTPUT_BUFFER_SIZE (1 << 20)
+
+// minimal CPU time of each phase with --bench, in seconds
+#define BENCH_MIN_TIME 0.5
+
+enum {
+	FORMAT_TEXT,
+	FORMAT_JSON,
+	FORMAT_CSV,
+};
+
+// code to disassemble
+typedef struct input {
+	uint8_t *code;
+	size_t size;
+	void *map;	// mmap()'ed file holding @code, or NULL if @code was malloc()'ed
+	size_t map_size;
+} input;
+
+static void free_input(input *in)
+{
+#ifndef _WIN32
+	if (in->map) {
+		munmap(in->map, in->map_size);
+		return;
+	}
+#endif
+	free(in->code);
+}
+
+#ifndef _WIN32
+static bool map_file(input *in, const char *filename, uint64_t offset, uint64_t length)
+{
+	struct stat st;
+	void *map;
+	FILE *f;
+
+	// <unistd.h> would clash with getopt.h, so stay with stdio to open the file
+	f = fopen(filename, "rb");
+	if (!f || fstat(fileno(f), &st) != 0) {
+		printf("ERROR: cannot open file %s, quit!\n", filename);
+		if (f)
+			fclose(f);
+		return false;
+	}
+
+	if (offset >= (uint64_t)st.st_size) {
+		printf("ERROR: offset is beyond the end of file %s, quit!\n", filename);
+		fclose(f);
+		return false;
+	}
+
+	if (length == 0 || length > (uint64_t)st.st_size - offset)
+		length = (uint64_t)st.st_size - offset;
+
+	// map from the start of file, as the offset of mmap() must be page aligned
+	map = mmap(NULL, (size_t)(offset + length), PROT_READ, MAP_PRIVATE, fileno(f), 0);
+	fclose(f);
+	if (map == MAP_FAILED) {
+		printf("ERROR: cannot map file %s, quit!\n", filename);
+		return false;
+	}
+
+#ifdef MADV_SEQUENTIAL
+	madvise(map, (size_t)(offset + length), MADV_SEQUENTIAL);
+#endif
+
+	in->map = map;
+	in->map_size = (size_t)(offset + length);
+	in->code = (uint8_t *)map + offset;
+	in->size = (size_t)length;
+
+	return true;
+}
+#endif
+
+// load @length bytes (0 = up to the end) at @offset of @filename.
+// @use_mmap maps the file where mmap() is available, or reads it otherwise.
+static bool load_file(input *in, const char *filename, uint64_t offset, uint64_t length, bool use_mmap)
+{
+	FILE *f;
+	long file_size;
+
+	in->map = NULL;
+
+#ifndef _WIN32
+	if (use_mmap)
+		return map_file(in, filename, offset, length);
+#endif
+
+	f = fopen(filename, "rb");
+	if (!f) {
+		printf("ERROR: cannot open file %s, quit!\n", filename);
+		return false;
+	}
+
+	if (fseek(f, 0, SEEK_END) != 0 || (file_size = ftell(f)) < 0) {
+		printf("ERROR: cannot read file %s, quit!\n", filename);
+		fclose(f);
+		return false;
+	}
+
+	if (offset >= (uint64_t)file_size) {
+		printf("ERROR: offset is beyond the end of file %s, quit!\n", filename);
+		fclose(f);
+		return false;
+	}
+
+	if (length == 0 || length > (uint64_t)file_size - offset)
+		length = (uint64_t)file_size - offset;
+
+	in->code = (uint8_t *)malloc((size_t)length);
+	in->size = (size_t)length;
+	if (!in->code || fseek(f, (long)offset, SEEK_SET) != 0 ||
+			fread(in->code, 1, in->size, f) != in->size) {
+		printf("ERROR: cannot read file %s, quit!\n", filename);
+		free(in->code);
+		fclose(f);
+		return false;
+	}
+
+	fclose(f);
+
+	return true;
+}
+
+// parse an offset or length in decimal or 0x hex
+static bool parse_size(const char *src, uint64_t *value)
+{
+	char *end;
+
+	errno = 0;
+	*value = strtoull(src, &end, 0);
+
+	return end != src && *end == '\0' && errno != ERANGE;
+}
+
+static const char hex_digits[] = "0123456789abcdef";
+
+// opcode of @ins as hex digits, separated with @sep if it is not '\0'.
+// return the length of the string written to @buf
+static size_t format_bytes(char *buf, const cs_insn *ins, char sep)
+{
+	char *p = buf;
+	int j;
+
+	for (j = 0; j < ins->size; j++) {
+		if (j > 0 && sep)
+			*p++ = sep;
+		*p++ = hex_digits[ins->bytes[j] >> 4];
+		*p++ = hex_digits[ins->bytes[j] & 0xf];
+	}
+	*p = '\0';
+
+	return p - buf;
+}
+
+// print @str as a JSON string, or null if there is none, like names of
+// unknown IDs or of a diet build
+static void print_json_string(const char *str)
+{
+	if (!str) {
+		fputs("null", stdout);
+		return;
+	}
+
+	putchar('"');
+	for (; *str; str++) {
+		switch (*str) {
+			case '"':
+			case '\\':
+				putchar('\\');
+				putchar(*str);
+				break;
+			case '\t':
+				fputs("\\t", stdout);
+				break;
+			default:
+				if ((unsigned char)*str < 0x20)
+					printf("\\u%04x", (unsigned char)*str);
+				else
+					putchar(*str);
+				break;
+		}
+	}
+	putchar('"');
+}
+
+static void print_json_regs(csh handle, const char *key, const uint16_t *regs, uint8_t count)
+{
+	uint8_t i;
+
+	printf(",\"%s\":[", key);
+	for (i = 0; i < count; i++) {
+		if (i > 0)
+			putchar(',');
+		print_json_string(cs_reg_name(handle, regs[i]));
+	}
+	putchar(']');
+}
+
+// one JSON object per instruction, on its own line
+static void print_insn_json(csh handle, const cs_insn *ins, bool detail)
+{
+	char bytes[2 * sizeof(ins->bytes) + 1];
+
+	format_bytes(bytes, ins, '\0');
+	printf("{\"address\":%" PRIu64 ",\"size\":%u,\"bytes\":\"%s\",\"id\":%u,\"mnemonic\":",
+			ins->address, ins->size, bytes, ins->id);
+	print_json_string(ins->mnemonic);
+	fputs(",\"op_str\":", stdout);
+	print_json_string(ins->op_str);
+
+	if (detail && ins->detail) {
+		cs_regs regs_read, regs_write;
+		uint8_t read_count, write_count;
+		uint8_t j;
+
+		fputs(",\"groups\":[", stdout);
+		for (j = 0; j < ins->detail->groups_count; j++) {
+			if (j > 0)
+				putchar(',');
+			print_json_string(cs_group_name(handle, ins->detail->groups[j]));
+		}
+		putchar(']');
+
+		if (!cs_regs_access(handle, ins, regs_read, &read_count, regs_write, &write_count)) {
+			print_json_regs(handle, "regs_read", regs_read, read_count);
+			print_json_regs(handle, "regs_write", regs_write, write_count);
+		}
+	}
+
+	fputs("}\n", stdout);
+}
+
+// quote a CSV field, doubling the quotes inside
+static void print_csv_string(const char *str)
+{
+	putchar('"');
+	for (; *str; str++) {
+		if (*str == '"')
+			putchar('"');
+		putchar(*str);
+	}
+	putchar('"');
+}
+
+static void print_insn_csv(const cs_insn *ins)
+{
+	char bytes[2 * sizeof(ins->bytes) + 1];
+
+	format_bytes(bytes, ins, '\0');
+	printf("0x%" PRIx64 ",%u,%s,%u,", ins->address, ins->size, bytes, ins->id);
+	print_csv_string(ins->mnemonic);
+	putchar(',');
+	print_csv_string(ins->op_str);
+	putchar('\n');
+}
+
+static void print_insn_text(const cs_insn *ins, cs_arch arch)
+{
+	char bytes[3 * sizeof(ins->bytes) + 1];
+	size_t len;
+	int pad = 0;
+
+	len = format_bytes(bytes, ins, ' ');
+
+	// X86 and s390 instruction sizes are variable.
+	// align assembly instruction after the opcode
+	if (arch == CS_ARCH_X86) {
+		pad = 16;
+	} else if (arch == CS_ARCH_SYSZ) {
+		pad = 6;
+	}
+
+	for (; pad > ins->size; pad--) {
+		memcpy(bytes + len, "   ", 4);
+		len += 3;
+	}
+
+	printf("%2"PRIx64"  %s  %s\t%s\n", ins->address, bytes, ins->mnemonic, ins->op_str);
+}
+
+// disassemble @size bytes of @code once, and return the number of instructions
+static size_t disasm_pass(csh handle, cs_insn *insn, const uint8_t *code, size_t size, uint64_t address)
+{
+	size_t count = 0;
+
+	while (cs_disasm_iter(handle, &code, &size, &address, insn))
+		count++;
+
+	return count;
+}
+
+typedef struct bench_phase {
+	const char *name;
+	bool text;	// render mnemonic & operands?
+	bool detail;
+	uint64_t passes;
+	uint64_t count;	// instructions of all passes
+	double seconds;
+} bench_phase;
+
+static void print_bench(const char *mode, const bench_phase *phase, size_t size, int format)
+{
+	double ns = phase->count ? phase->seconds * 1e9 / phase->count : 0;
+	double insns = phase->seconds > 0 ? phase->count / phase->seconds : 0;
+	double bytes = phase->seconds > 0 ? (double)phase->passes * size / phase->seconds : 0;
+	uint64_t count = phase->count / phase->passes;
+
+	switch (format) {
+		default:
+			printf("%-8s %8" PRIu64 " passes  %8.3f s  %8.2f ns/insn  %12.0f insns/s  %8.2f MB/s\n",
+					phase->name, phase->passes, phase->seconds, ns, insns, bytes / (1024 * 1024));
+			break;
+		case FORMAT_JSON:
+			printf("{\"arch\":\"%s\",\"phase\":\"%s\",\"bytes\":%" PRIu64 ",\"insns\":%" PRIu64 ",\"passes\":%" PRIu64 ","
+					"\"seconds\":%.6f,\"ns_per_insn\":%.3f,\"insns_per_sec\":%.0f,\"bytes_per_sec\":%.0f}\n",
+					mode, phase->name, (uint64_t)size, count, phase->passes,
+					phase->seconds, ns, insns, bytes);
+			break;
+		case FORMAT_CSV:
+			printf("%s,%s,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%.6f,%.3f,%.0f,%.0f\n",
+					mode, phase->name, (uint64_t)size, count, phase->passes,
+					phase->seconds, ns, insns, bytes);
+			break;
+	}
+}
+
+// disassemble the input repeatedly: without text, with text, then with text &
+// detail, and report the time of each. the difference between the last two
+// phases is the time spent on detail.
+// NOTE: CS_OPT_NO_TEXT still runs the printer of most archs, only without
+// formatting, so the "decode" phase includes part of the printing, and the
+// difference between it & the "print" phase is not the cost of the printer.
+static int bench(csh handle, const char *mode, const uint8_t *code, size_t size, uint64_t address, int format)
+{
+	bench_phase phases[] = {
+		{ "decode", false, false, 0, 0, 0 },
+		{ "print", true, false, 0, 0, 0 },
+		{ "detail", true, true, 0, 0, 0 },
+	};
+	cs_insn *insn;
+	size_t i;
+
+	insn = cs_malloc(handle);
+
+	for (i = 0; i < sizeof(phases) / sizeof(phases[0]); i++) {
+		bench_phase *phase = &phases[i];
+		clock_t start;
+
+		cs_option(handle, CS_OPT_NO_TEXT, phase->text ? CS_OPT_OFF : CS_OPT_ON);
+		cs_option(handle, CS_OPT_DETAIL, phase->detail ? CS_OPT_ON : CS_OPT_OFF);
+
+		// cs_malloc() sized the detail for the options of that time
+		cs_free(insn, 1);
+		insn = cs_malloc(handle);
+
+		start = clock();
+		do {
+			phase->count += disasm_pass(handle, insn, code, size, address);
+			phase->passes++;
+			phase->seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+		} while (phase->seconds < BENCH_MIN_TIME);
+
+		if (phase->count == 0) {
+			printf("ERROR: invalid assembly code\n");
+			cs_free(insn, 1);
+			return -4;
+		}
+	}
+
+	cs_free(insn, 1);
+
+	if (format == FORMAT_CSV)
+		printf("arch,phase,bytes,insns,passes,seconds,ns_per_insn,insns_per_sec,bytes_per_sec\n");
+	else if (format == FORMAT_TEXT)
+		printf("%s: %" PRIu64 " bytes, %" PRIu64 " instructions\n", mode, (uint64_t)size,
+				phases[0].count / phases[0].passes);
+
+	for (i = 0; i < sizeof(phases) / sizeof(phases[0]); i++)
+		print_bench(mode, &phases[i], size, format);
+
+	if (format == FORMAT_TEXT) {
+		double decode = phases[0].seconds * 1e9 / phases[0].count;
+		double print = phases[1].seconds * 1e9 / phases[1].count;
+		double detail = phases[2].seconds * 1e9 / phases[2].count;
+
+		printf("per instruction: decode %.2f ns (with quiet printing), detail %.2f ns\n",
+				decode, detail - print);
+	}
+
+	return 0;
+}
+
 int main(int argc, char **argv)
 {
 	int i, c;
 	csh handle;
 	char *mode;
-	uint8_t *assembly;
+	input in;
+	const uint8_t *code;
 	size_t count, size;
 	uint64_t address = 0LL;
+	uint64_t offset = 0, length = 0;
 	cs_insn *insn;
 	cs_err err;
 	cs_mode md;
@@ -377,10 +790,53 @@ int main(int argc, char **argv)
 	bool detail_flag = false;
 	bool unsigned_flag = false;
 	bool skipdata = false;
-	int args_left;
+	bool bench_flag = false;
+	bool mmap_flag = false;
+	const char *filename = NULL;
+	int format = FORMAT_TEXT;
+	int args_left, ret = 0;
+
+	// getopt() has no long options
+	for (i = 1; i < argc && strcmp(argv[i], "--"); i++) {
+		if (!strcmp(argv[i], "--bench"))
+			argv[i] = "-b";
+	}
 
-	while ((c = getopt (argc, argv, "sudhv")) != -1) {
+	while ((c = getopt (argc, argv, "sudhvbmf:o:l:F:")) != -1) {
 		switch (c) {
+			case 'b':
+				bench_flag = true;
+				break;
+			case 'm':
+				mmap_flag = true;
+				break;
+			case 'f':
+				filename = optarg;
+				break;
+			case 'o':
+				if (!parse_size(optarg, &offset)) {
+					printf("ERROR: invalid offset argument, quit!\n");
+					return -2;
+				}
+				break;
+			case 'l':
+				if (!parse_size(optarg, &length)) {
+					printf("ERROR: invalid length argument, quit!\n");
+					return -2;
+				}
+				break;
+			case 'F':
+				if (!strcmp(optarg, "text")) {
+					format = FORMAT_TEXT;
+				} else if (!strcmp(optarg, "json")) {
+					format = FORMAT_JSON;
+				} else if (!strcmp(optarg, "csv")) {
+					format = FORMAT_CSV;
+				} else {
+					printf("ERROR: invalid format \"%s\", quit!\n", optarg);
+					return -2;
+				}
+				break;
 			case 's':
 				skipdata = true;
 				break;
@@ -481,20 +937,31 @@ int main(int argc, char **argv)
 	}
 
 	args_left = argc - optind;
+	if (filename) {
+		// the code comes from the file, not from a hexstring
+		args_left++;
+	}
+
 	if (args_left < 2 || args_left > 3) {
 		usage(argv[0]);
 		return -1;
 	}
 
 	mode = argv[optind];
-	assembly = preprocess(argv[optind + 1], &size);
-	if (!assembly) {
-		usage(argv[0]);
-		return -1;
+	if (filename) {
+		if (!load_file(&in, filename, offset, length, mmap_flag))
+			return -1;
+	} else {
+		in.map = NULL;
+		in.code = preprocess(argv[optind + 1], &in.size);
+		if (!in.code) {
+			usage(argv[0]);
+			return -1;
+		}
 	}
 
 	if (args_left == 3) {
-		char *temp, *src = argv[optind + 2];
+		char *temp, *src = argv[argc - 1];
 		address = strtoull(src, &temp, 16);
 		if (temp == src || *temp != '\0' || errno == ERANGE) {
 			printf("ERROR: invalid address argument, quit!\n");
@@ -540,46 +1007,49 @@ int main(int argc, char **argv)
 		cs_option(handle, CS_OPT_UNSIGNED, CS_OPT_ON);
 	}
 
-	count = cs_disasm(handle, assembly, size, address, 0, &insn);
-	if (count > 0) {
-		size_t i;
+	setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
 
-		for (i = 0; i < count; i++) {
-			int j;
-
-			printf("%2"PRIx64"  ", insn[i].address);
-			for (j = 0; j < insn[i].size; j++) {
-				if (j > 0)
-					putchar(' ');
-				printf("%02x", insn[i].bytes[j]);
-			}
-			// X86 and s390 instruction sizes are variable.
-			// align assembly instruction after the opcode
-			if (arch == CS_ARCH_X86) {
-				for (; j < 16; j++) {
-					printf("   ");
-				}
-			} else if (arch == CS_ARCH_SYSZ) {
-				for (; j < 6; j++) {
-					printf("   ");
-				}
-			}
+	if (bench_flag) {
+		ret = bench(handle, mode, in.code, in.size, address, format);
+		cs_close(&handle);
+		free_input(&in);
+		return ret;
+	}
 
-			printf("  %s\t%s\n", insn[i].mnemonic, insn[i].op_str);
+	if (format == FORMAT_CSV)
+		printf("address,size,bytes,id,mnemonic,op_str\n");
 
-			if (detail_flag) {
-				print_details(handle, arch, md, &insn[i]);
-			}
+	// one instruction at a time, so that big files need no array of all their instructions
+	insn = cs_malloc(handle);
+	code = in.code;
+	size = in.size;
+	count = 0;
+	while (cs_disasm_iter(handle, &code, &size, &address, insn)) {
+		switch (format) {
+			default:
+				print_insn_text(insn, arch);
+				if (detail_flag) {
+					print_details(handle, arch, md, insn);
+				}
+				break;
+			case FORMAT_JSON:
+				print_insn_json(handle, insn, detail_flag);
+				break;
+			case FORMAT_CSV:
+				print_insn_csv(insn);
+				break;
 		}
+		count++;
+	}
 
-		cs_free(insn, count);
-	} else {
+	if (count == 0) {
 		printf("ERROR: invalid assembly code\n");
-		return(-4);
+		ret = -4;
 	}
 
+	cs_free(insn, 1);
 	cs_close(&handle);
-	free(assembly);
+	free_input(&in);
 
-	return 0;
+	return ret;
 }
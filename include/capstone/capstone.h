@@ -172,12 +172,27 @@ typedef struct cs_opt_mem {
 	cs_vsnprintf_t vsnprintf;
 } cs_opt_mem;
 
+typedef void* (CAPSTONE_API *cs_malloc_ctx_t)(void *ctx, size_t size);
+typedef void* (CAPSTONE_API *cs_realloc_ctx_t)(void *ctx, void *ptr, size_t size);
+typedef void (CAPSTONE_API *cs_free_ctx_t)(void *ctx, void *ptr);
+
+/// User-defined dynamic memory functions of one handle: malloc/realloc/free(),
+/// each called with the user context pointer @ctx (see CS_OPT_MEM_CTX).
+/// @realloc must behave like realloc(), and accept a NULL @ptr.
+typedef struct cs_opt_mem_ctx {
+	cs_malloc_ctx_t malloc;
+	cs_realloc_ctx_t realloc;
+	cs_free_ctx_t free;
+	void *ctx;	///< user context pointer, passed to all the functions above
+} cs_opt_mem_ctx;
+
 /// Customize mnemonic for instructions with alternative name.
 /// To reset existing customized instruction to its default mnemonic,
 /// call cs_option(CS_OPT_MNEMONIC) again with the same @id and NULL value
 /// for @mnemonic.
 typedef struct cs_opt_mnem {
-	/// ID of instruction to be customized.
+	/// ID of instruction to be customized, which must be an instruction of
+	/// the arch of the handle. Otherwise cs_option() fails with CS_ERR_OPTION.
 	unsigned int id;
 	/// Customized instruction mnemonic.
 	const char *mnemonic;
@@ -194,12 +209,17 @@ typedef enum cs_opt_type {
 	CS_OPT_SKIPDATA_SETUP, ///< Setup user-defined function for SKIPDATA option
 	CS_OPT_MNEMONIC, ///< Customize instruction mnemonic
 	CS_OPT_UNSIGNED, ///< print immediate operands in unsigned form
+	CS_OPT_NO_TEXT, ///< Do not render mnemonic & operand text: see cs_insn_text()
+	CS_OPT_COMPACT_DETAIL, ///< Size cs_detail of each instruction to its arch & operands: see cs_detail_size()
+	CS_OPT_MEM_CTX, ///< User-defined dynamic memory functions of this handle, for the instructions it returns
+	CS_OPT_ARENA, ///< Allocate all details of one cs_disasm() call in a few blocks, released at once by cs_free()
+	CS_OPT_REGS_BITSET, ///< Compute register bitsets of each instruction while decoding it: see cs_regs_access_bitset()
 } cs_opt_type;
 
 /// Runtime option value (associated with option type above)
 typedef enum cs_opt_value {
-	CS_OPT_OFF = 0,  ///< Turn OFF an option - default for CS_OPT_DETAIL, CS_OPT_SKIPDATA, CS_OPT_UNSIGNED.
-	CS_OPT_ON = 3, ///< Turn ON an option (CS_OPT_DETAIL, CS_OPT_SKIPDATA).
+	CS_OPT_OFF = 0,  ///< Turn OFF an option - default for CS_OPT_DETAIL, CS_OPT_SKIPDATA, CS_OPT_UNSIGNED, CS_OPT_NO_TEXT, CS_OPT_COMPACT_DETAIL, CS_OPT_ARENA, CS_OPT_REGS_BITSET.
+	CS_OPT_ON = 3, ///< Turn ON an option (CS_OPT_DETAIL, CS_OPT_SKIPDATA, CS_OPT_NO_TEXT, CS_OPT_COMPACT_DETAIL, CS_OPT_ARENA, CS_OPT_REGS_BITSET).
 	CS_OPT_SYNTAX_DEFAULT = 0, ///< Default asm syntax (CS_OPT_SYNTAX).
 	CS_OPT_SYNTAX_INTEL, ///< X86 Intel asm syntax - default on X86 (CS_OPT_SYNTAX).
 	CS_OPT_SYNTAX_ATT,   ///< X86 ATT asm syntax (CS_OPT_SYNTAX).
@@ -321,6 +341,10 @@ typedef struct cs_detail {
 	uint8_t groups[8]; ///< list of group this instruction belong to
 	uint8_t groups_count; ///< number of groups this insn belongs to
 
+	/// 1 if the register bitsets of CS_OPT_REGS_BITSET follow this cs_detail
+	/// in memory, 0 otherwise. see cs_regs_access_bitset()
+	uint8_t regs_bitset;
+
 	/// Architecture-specific instruction info
 	union {
 		cs_x86 x86;     ///< X86 architecture, including 16-bit, 32-bit & 64-bit mode
@@ -477,6 +501,27 @@ cs_err CAPSTONE_API cs_open(cs_arch arch, cs_mode mode, csh *handle);
 CAPSTONE_EXPORT
 cs_err CAPSTONE_API cs_close(csh *handle);
 
+/**
+ Create a new handle, which is an independent copy of an existing handle:
+ it has the same arch & mode, plus all the options set with cs_option(),
+ including syntax, detail, SKIPDATA setup & customized mnemonics.
+
+ This is a convenience to set up a handle like an existing one, for example
+ to give each thread its own handle. It costs about the same as cs_open()
+ followed by cs_option() for each option: the arch module is initialized
+ again, and the customized mnemonics are copied. The new handle does not share
+ any mutable state with the original one, so both can be used at the same
+ time by different threads. Either handle can be closed first.
+
+ @handle: handle returned by cs_open() or cs_clone()
+ @new_handle: pointer to the new handle, which must be closed with cs_close()
+
+ @return CS_ERR_OK on success, or other value on failure (refer to cs_err enum
+ for detailed error).
+*/
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_clone(csh handle, csh *new_handle);
+
 /**
  Set option for disassembling engine at runtime
 
@@ -490,6 +535,19 @@ cs_err CAPSTONE_API cs_close(csh *handle);
  NOTE: in the case of CS_OPT_MEM, handle's value can be anything,
  so that cs_option(handle, CS_OPT_MEM, value) can (i.e must) be called
  even before cs_open()
+
+ NOTE 2: functions set with CS_OPT_MEM are thread-local, so the instructions
+ returned by a handle are allocated by those of the thread calling cs_open(),
+ whichever thread calls cs_disasm().
+ With CS_OPT_MEM_CTX, @value points to a cs_opt_mem_ctx structure: then the
+ instructions & details returned by this handle (cs_disasm(), cs_malloc(),
+ cs_disasm_parallel()) are allocated by these functions, and cs_free() calls
+ its @free function, even after the handle is closed. Set @value to 0 to go
+ back to the functions of CS_OPT_MEM.
+
+ NOTE 3: with CS_OPT_ARENA on, cs_disasm() allocates the details of all its
+ instructions in a few large blocks rather than one by one, and cs_free()
+ releases these blocks at once, whatever the number of instructions.
 */
 CAPSTONE_EXPORT
 cs_err CAPSTONE_API cs_option(csh handle, cs_opt_type type, size_t value);
@@ -560,6 +618,9 @@ size_t CAPSTONE_API cs_disasm(csh handle,
 /**
  Free memory allocated by cs_malloc() or cs_disasm() (argument @insn)
 
+ The memory is released with the functions it was allocated with, see
+ CS_OPT_MEM & CS_OPT_MEM_CTX.
+
  @insn: pointer returned by @insn argument in cs_disasm() or cs_malloc()
  @count: number of cs_insn structures returned by cs_disasm(), or 1
      to free memory allocated by cs_malloc().
@@ -619,6 +680,350 @@ bool CAPSTONE_API cs_disasm_iter(csh handle,
 	const uint8_t **code, size_t *size,
 	uint64_t *address, cs_insn *insn);
 
+/**
+ Batch API to disassemble binary code into an array of instructions provided
+ by the caller. Unlike cs_disasm(), this API never allocates memory, so the
+ same arrays can be reused for the whole input buffer.
+ See tests/test_disasm_into.c for sample code demonstrating this API.
+
+ NOTE 1: like cs_disasm_iter(), this API updates @code, @size & @address to
+ point to the first byte that was not disassembled. Therefore, when all the
+ @count slots are filled, simply call it again to continue disassembling.
+ If the returned value is less than @count while @size is still positive,
+ the engine met an invalid instruction (and SKIPDATA mode is OFF).
+
+ NOTE 2: when detail option is ON, @detail must point to an array of at
+ least @count cs_detail. The @detail pointer of each instruction is set to
+ its slot in this array, so there is no need to call cs_free() afterwards.
+ When detail option is OFF, @detail can be NULL.
+
+ @handle: handle returned by cs_open()
+ @code: buffer containing raw binary code to be disassembled
+ @size: size of above code
+ @address: address of the first insn in given raw code buffer
+ @insn: array of at least @count instructions to be filled in by this API.
+ @detail: array of at least @count cs_detail, or NULL if detail option is OFF.
+ @count: maximum number of instructions to be disassembled.
+
+ @return: the number of instructions put into @insn, or 0 on failure.
+
+ On failure, call cs_errno() for error code.
+*/
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_into(csh handle,
+	const uint8_t **code, size_t *size,
+	uint64_t *address, cs_insn *insn,
+	cs_detail *detail, size_t count);
+
+/**
+ User-defined callback function receiving instructions of cs_disasm_cb() &
+ cs_disasm_stream().
+
+ @handle: handle disassembling the instruction
+ @insn: the disassembled instruction. This structure, including its @detail,
+	is reused for the next instruction, so it must be copied to be kept.
+ @user_data: user-data passed to cs_disasm_cb() or cs_disasm_stream()
+
+ @return: true to continue disassembling, or false to stop.
+*/
+typedef bool (CAPSTONE_API *cs_insn_cb_t)(csh handle, const cs_insn *insn, void *user_data);
+
+/**
+ Disassemble binary code, passing each instruction to a callback.
+
+ This works like cs_disasm(), including for SKIPDATA, but never builds an
+ array of instructions: only one cs_insn is used for all the instructions,
+ and it is passed to @callback as soon as it is disassembled. This is as
+ fast as cs_disasm_iter() and needs no dynamic memory.
+
+ @handle: handle returned by cs_open()
+ @code: buffer containing raw binary code to be disassembled.
+ @code_size: size of the above code buffer.
+ @address: address of the first instruction in given raw code buffer.
+ @callback: callback receiving each instruction. If it returns false,
+	disassembling stops immediately.
+ @user_data: user-data passed to @callback.
+
+ @return: the number of instructions passed to @callback.
+
+ On failure, call cs_errno() for error code.
+*/
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_cb(csh handle,
+		const uint8_t *code, size_t code_size,
+		uint64_t address,
+		cs_insn_cb_t callback, void *user_data);
+
+/**
+ User-defined callback function providing code to cs_disasm_stream().
+
+ @buf: buffer to be filled with the next bytes of code.
+ @size: max number of bytes to put into @buf.
+ @user_data: user-data passed to cs_disasm_stream()
+
+ @return: number of bytes put into @buf, or 0 at the end of the code.
+*/
+typedef size_t (CAPSTONE_API *cs_read_cb_t)(uint8_t *buf, size_t size, void *user_data);
+
+/**
+ Disassemble binary code provided by a callback, such as reading from a file,
+ and pass each instruction to another callback.
+
+ The code is read into a window of fixed size, which is refilled as the
+ instructions are disassembled, keeping any instruction crossing the end of
+ the window for the next round. Only one cs_insn is used for all the
+ instructions, so memory usage does not depend on the size of the code.
+
+ Like cs_disasm(), this stops at the first broken instruction, unless
+ SKIPDATA option is ON. Then the SKIPDATA callback receives the current window
+ as its @code buffer.
+
+ @handle: handle returned by cs_open()
+ @read: callback providing the code, until it returns 0.
+ @read_data: user-data passed to @read.
+ @address: address of the first instruction in the code.
+ @callback: callback receiving each instruction. If it returns false,
+	disassembling stops immediately.
+ @user_data: user-data passed to @callback.
+
+ @return: the number of instructions passed to @callback.
+
+ On failure, call cs_errno() for error code.
+*/
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_stream(csh handle,
+		cs_read_cb_t read, void *read_data,
+		uint64_t address,
+		cs_insn_cb_t callback, void *user_data);
+
+/**
+ Disassemble a large binary code buffer with multiple threads, producing the
+ same instructions as cs_disasm() with @count = 0.
+
+ The buffer is split into up to @nthreads chunks, each decoded by its own
+ thread with a private copy of @handle, then the results are joined back in
+ address order. For fixed-width instructions the chunks are always split at
+ instruction boundaries. For variable-length instructions (such as X86 or
+ ARM Thumb), an instruction crossing the end of a chunk is kept, and the
+ next chunk resumes at the first of its instructions found right after it.
+
+ NOTE 1: multithreading is only available when Capstone is built with
+ CAPSTONE_USE_THREADS, which is the default of both CMake & make builds.
+ Otherwise, or when the buffer is too small to be worth
+ splitting, this API simply does the same job as cs_disasm().
+
+ NOTE 2: user-defined memory functions (see CS_OPT_MEM) and SKIPDATA callback
+ (see CS_OPT_SKIPDATA_SETUP) are called from all the threads, so they must be
+ thread-safe.
+
+ @handle: handle returned by cs_open()
+ @code: buffer containing raw binary code to be disassembled.
+ @code_size: size of the above code buffer.
+ @address: address of the first instruction in given raw code buffer.
+ @nthreads: max number of threads to be used, including the calling thread.
+ @insn: array of instructions filled in by this API.
+	   NOTE: @insn will be allocated by this function, and should be freed
+	   with cs_free() API.
+
+ @return: the number of successfully disassembled instructions,
+ or 0 if this function failed to disassemble the given code
+
+ On failure, call cs_errno() for error code.
+*/
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_parallel(csh handle,
+		const uint8_t *code, size_t code_size,
+		uint64_t address, size_t nthreads,
+		cs_insn **insn);
+
+/**
+ Return the length of the instruction at @code, without building its cs_insn.
+ This is much faster than cs_disasm_iter() when only instruction boundaries
+ matter, e.g for scanning basic blocks or gadgets: the mnemonic, operands &
+ detail are never computed. On X86, the decoder even stops once it knows the
+ size of the operands.
+
+ NOTE: this does not change the state of the handle, so it can be called
+ between calls to cs_disasm_iter() on ARM Thumb code with IT blocks.
+
+ @handle: handle returned by cs_open()
+ @code: buffer containing raw binary code.
+ @code_size: size of the above code buffer.
+ @address: address of the instruction in given raw code buffer.
+
+ @return: the length of the instruction in bytes, or 0 if it is invalid.
+*/
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_insn_length(csh handle,
+		const uint8_t *code, size_t code_size,
+		uint64_t address);
+
+/**
+ Bulk version of cs_insn_length(): put the lengths of up to @count consecutive
+ instructions from @code into @lengths, stopping at the end of @code or at
+ the first invalid instruction. SKIPDATA option is ignored.
+
+ @handle: handle returned by cs_open()
+ @code: buffer containing raw binary code.
+ @code_size: size of the above code buffer.
+ @address: address of the first instruction in given raw code buffer.
+ @lengths: array of at least @count elements, filled in by this API.
+ @count: maximum number of instructions to be scanned.
+
+ @return: the number of lengths put into @lengths.
+*/
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_insn_lengths(csh handle,
+		const uint8_t *code, size_t code_size,
+		uint64_t address, uint16_t *lengths, size_t count);
+
+/// Number of 64-bit words of the group bitset of each instruction in cs_columns:
+/// group IDs are 8-bit, so 256 bits hold all the groups of any architecture.
+#define CS_COLUMN_GROUP_WORDS 4
+
+/**
+ Instructions disassembled by cs_disasm_columns(), laid out in columns (one
+ array per field, indexed by instruction) rather than as an array of cs_insn.
+ Scanning one field of many instructions then only touches the memory of that
+ field, and each column can be used directly as a typed array, e.g by NumPy.
+
+ Columns which are not available are NULL. All the columns are in a single
+ allocation, released with cs_free_columns().
+*/
+typedef struct cs_columns {
+	size_t count;	///< number of instructions in each instruction column
+	uint64_t *address;	///< address of each instruction
+	uint16_t *size;	///< size of each instruction
+	unsigned int *id;	///< instruction ID (see cs_insn.id)
+
+	/// Group bitsets, with CS_COLUMN_GROUP_WORDS words per instruction:
+	/// instruction i belongs to group g when bit (g % 64) of
+	/// groups[i * CS_COLUMN_GROUP_WORDS + g / 64] is set.
+	/// NOTE: only available when CS_OPT_DETAIL = CS_OPT_ON
+	uint64_t *groups;
+
+	/// Text of instructions: @mnemonic[i] & @op_str[i] are offsets of the
+	/// null-terminated strings of instruction i in @text, which has
+	/// @text_size bytes.
+	/// NOTE: only available when CS_OPT_NO_TEXT = CS_OPT_OFF (the default),
+	/// in a non-diet engine.
+	char *text;
+	size_t text_size;
+	size_t *mnemonic;
+	size_t *op_str;
+
+	/// Operands of all instructions, packed one after another: the
+	/// @op_count[i] operands of instruction i are at indexes op_first[i] to
+	/// op_first[i + 1] - 1 of the operand columns, so op_first has @count + 1
+	/// elements.
+	/// NOTE: operands are only available when CS_OPT_DETAIL = CS_OPT_ON, on X86,
+	/// ARM, ARM64 & RISCV. Otherwise all @op_count are 0.
+	uint8_t *op_count;
+	uint32_t *op_first;
+	size_t op_total;	///< number of elements in each operand column
+	uint8_t *op_type;	///< operand type of the arch, e.g X86_OP_REG or ARM64_OP_SYS
+	uint8_t *op_access;	///< how the operand is accessed (cs_ac_type), or 0 if unknown
+	uint16_t *op_reg;	///< register of REG operand, or base register of MEM operand
+	uint16_t *op_mem_index;	///< index register of MEM operand
+	/// value of IMM & other operands, displacement of MEM operand, or raw bits
+	/// of the double value of FP operand
+	int64_t *op_imm;
+} cs_columns;
+
+/**
+ Disassemble binary code into columns, with one call & one allocation for any
+ number of instructions: like cs_disasm(), but without building a cs_insn for
+ each instruction. See cs_columns for the fields available.
+
+ NOTE: when the text of instructions is not needed, turning ON CS_OPT_NO_TEXT
+ option makes this API faster, and leaves out the text columns.
+
+ @handle: handle returned by cs_open()
+ @code: buffer containing raw binary code to be disassembled.
+ @code_size: size of the above code buffer.
+ @address: address of the first instruction in given raw code buffer.
+ @count: number of instructions to be disassembled, or 0 to get all of them
+ @columns: columns of instructions filled in by this API, or NULL when no
+	   instruction is disassembled.
+	   NOTE: @columns will be allocated by this function, and should be freed
+	   with cs_free_columns() API.
+
+ @return: the number of successfully disassembled instructions,
+ or 0 if this function failed to disassemble the given code
+
+ On failure, call cs_errno() for error code.
+*/
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_columns(csh handle,
+		const uint8_t *code, size_t code_size,
+		uint64_t address, size_t count,
+		cs_columns **columns);
+
+/**
+ Free memory allocated by cs_disasm_columns().
+
+ @columns: pointer returned by @columns argument in cs_disasm_columns()
+*/
+CAPSTONE_EXPORT
+void CAPSTONE_API cs_free_columns(cs_columns *columns);
+
+/**
+ Render the text of an instruction disassembled while CS_OPT_NO_TEXT option
+ is ON, by filling in its @mnemonic & @op_str fields.
+
+ With CS_OPT_NO_TEXT, the engine still fills in all the other fields of
+ cs_insn (including cs_detail), but skips formatting the assembly text, which
+ is a large part of the disassembling cost. This API re-decodes the machine
+ bytes kept in @insn to produce the text on demand, so it is only worth it
+ for the few instructions whose text is actually needed.
+
+ NOTE 1: this API must be called with the same handle (and the same mode &
+ syntax) that disassembled @insn. The @detail of @insn is not modified.
+
+ NOTE 2: on ARM, Thumb instructions inside an IT block take their condition
+ code from the IT instruction before them, which decoding them again alone
+ cannot know. So their text is rendered at disassembling time even with
+ CS_OPT_NO_TEXT, and this API leaves it as is.
+
+ WARN: when in 'diet' mode, this API is irrelevant because the engine does not
+ render any text.
+
+ @handle: handle returned by cs_open()
+ @insn: instruction received from cs_disasm(), cs_disasm_iter() or cs_disasm_into()
+
+ @return CS_ERR_OK on success, or other value on failure (refer to cs_err enum
+ for detailed error).
+*/
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_insn_text(csh handle, cs_insn *insn);
+
+/**
+ Render the full assembly text of an instruction ("mnemonic op_str") into a
+ buffer provided by user, without modifying the instruction.
+
+ If @insn was disassembled while CS_OPT_NO_TEXT option is ON, its machine bytes
+ are decoded again to produce the text (see cs_insn_text()), so the common path
+ can skip formatting entirely and only the instructions actually printed pay
+ for it. Otherwise, the text already in @insn is used, as for ARM Thumb
+ instructions inside an IT block, which always get their text.
+
+ NOTE: this API must be called with the same handle (and the same mode &
+ syntax) that disassembled @insn.
+
+ WARN: when in 'diet' mode, this API is irrelevant because the engine does not
+ render any text.
+
+ @handle: handle returned by cs_open()
+ @insn: instruction received from cs_disasm(), cs_disasm_iter() or cs_disasm_into()
+ @buf: buffer to receive the text, which is always NULL-terminated.
+ @len: size of @buf in bytes. Longer text is truncated to fit in @buf.
+
+ @return CS_ERR_OK on success, or other value on failure (refer to cs_err enum
+ for detailed error).
+*/
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_format_insn(csh handle, const cs_insn *insn, char *buf, size_t len);
+
 /**
  Return friendly name of register in a string.
  Find the instruction id from header file of corresponding architecture (arm.h for ARM,
@@ -688,6 +1093,8 @@ bool CAPSTONE_API cs_insn_group(csh handle, const cs_insn *insn, unsigned int gr
  Check if a disassembled instruction IMPLICITLY used a particular register.
  Find the register id from header file of corresponding architecture (arm.h for ARM, x86.h for X86, ...)
  Internally, this simply verifies if @reg_id matches any member of insn->regs_read array.
+ With CS_OPT_REGS_BITSET on, a register the instruction does not access at all
+ is rejected in constant time, with the bitset computed while decoding.
 
  NOTE: this API is only valid when detail option is ON (which is OFF by default)
 
@@ -706,6 +1113,8 @@ bool CAPSTONE_API cs_reg_read(csh handle, const cs_insn *insn, unsigned int reg_
  Check if a disassembled instruction IMPLICITLY modified a particular register.
  Find the register id from header file of corresponding architecture (arm.h for ARM, x86.h for X86, ...)
  Internally, this simply verifies if @reg_id matches any member of insn->regs_write array.
+ With CS_OPT_REGS_BITSET on, a register the instruction does not access at all
+ is rejected in constant time, with the bitset computed while decoding.
 
  NOTE: this API is only valid when detail option is ON (which is OFF by default)
 
@@ -756,6 +1165,46 @@ CAPSTONE_EXPORT
 int CAPSTONE_API cs_op_index(csh handle, const cs_insn *insn, unsigned int op_type,
 		unsigned int position);
 
+/**
+ Retrieve the number of operands of an instruction, whatever their type.
+ This is <arch>.op_count, without having to know the architecture.
+
+ NOTE: this API is only valid when detail option is ON (which is OFF by default)
+
+ @handle: handle returned by cs_open()
+ @insn: disassembled instruction structure received from cs_disasm() or cs_disasm_iter()
+
+ @return: number of operands in instruction @insn, or -1 on failure.
+*/
+CAPSTONE_EXPORT
+int CAPSTONE_API cs_detail_op_count(csh handle, const cs_insn *insn);
+
+/**
+ Retrieve the number of bytes of @detail actually used by an instruction:
+ only the fields for its architecture, with only the operands it has.
+
+ When CS_OPT_COMPACT_DETAIL option is ON, cs_disasm() & cs_disasm_parallel()
+ allocate only this many bytes for @detail of each instruction, rather than
+ sizeof(cs_detail), which is sized for the largest architecture. Such a
+ compact @detail has the same layout as cs_detail, but fields past its size,
+ such as <arch>.operands[] past <arch>.op_count, must not be accessed.
+
+ This is also the number of bytes to copy to keep @detail of an instruction,
+ for example when packing details of many instructions into a single buffer.
+
+ With CS_OPT_REGS_BITSET, the register bitsets are stored right after
+ cs_detail, and counted here for instructions that have them.
+
+ NOTE: this API is only valid when detail option is ON (which is OFF by default)
+
+ @handle: handle returned by cs_open()
+ @insn: disassembled instruction structure received from cs_disasm() or cs_disasm_iter()
+
+ @return: size of @detail of instruction @insn in bytes, or 0 on failure.
+*/
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_detail_size(csh handle, const cs_insn *insn);
+
 /// Type of array to keep the list of registers
 typedef uint16_t cs_regs[64];
 
@@ -781,6 +1230,48 @@ cs_err CAPSTONE_API cs_regs_access(csh handle, const cs_insn *insn,
 		cs_regs regs_read, uint8_t *regs_read_count,
 		cs_regs regs_write, uint8_t *regs_write_count);
 
+/// Number of 64-bit words in a register bitset, enough for the registers
+/// of all architectures
+#define CS_REGS_BITSET_WORDS 6
+
+/// Type of bitset to keep a set of registers: register @reg is in the set
+/// if bit (reg % 64) of word (reg / 64) is set
+typedef uint64_t cs_regs_bitset[CS_REGS_BITSET_WORDS];
+
+/// Check if register @reg is in bitset @bits, in constant time
+#define CS_REGS_BITSET_HAS(bits, reg) \
+	((reg) < 64 * CS_REGS_BITSET_WORDS && (((bits)[(reg) / 64] >> ((reg) % 64)) & 1))
+
+/**
+ Retrieve all the registers accessed by an instruction, either explicitly or
+ implicitly, as bitsets.
+
+ This gives the same registers as cs_regs_access(), but each set is computed
+ once, then any register can be checked with CS_REGS_BITSET_HAS() in constant
+ time, and sets of several instructions can be combined with bitwise
+ operations. This is handy for dataflow analysis over many instructions.
+
+ NOTE: with CS_OPT_REGS_BITSET on, the bitsets of each instruction are computed
+ while decoding it, and stored after its detail, so this API only copies them.
+ cs_detail keeps its size: the room for the bitsets is only allocated with
+ this option, by cs_disasm(), cs_disasm_parallel() and cs_malloc(). This is
+ not done with CS_OPT_COMPACT_DETAIL, nor on archs without cs_regs_access().
+
+ WARN: when in 'diet' mode, this API is irrelevant because engine does not
+ store registers.
+
+ @handle: handle returned by cs_open()
+ @insn: disassembled instruction structure returned from cs_disasm() or cs_disasm_iter()
+ @regs_read: on return, this bitset contains all registers read by instruction.
+ @regs_write: on return, this bitset contains all registers written by instruction.
+
+ @return CS_ERR_OK on success, or other value on failure (refer to cs_err enum
+ for detailed error).
+*/
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_regs_access_bitset(csh handle, const cs_insn *insn,
+		cs_regs_bitset regs_read, cs_regs_bitset regs_write);
+
 #ifdef __cplusplus
 }
 #endif
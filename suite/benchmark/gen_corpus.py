@@ -0,0 +1,131 @@
+#!/usr/bin/python
+# generate corpus.inc for test_corpus_benchmark.c: the encodings of suite/MC
+# test files, grouped by arch & mode, plus the sample code of tests/ for the
+# archs without suite/MC test files.
+# $ python gen_corpus.py ../MC ../../tests > corpus.inc
+# by Nguyen Anh Quynh, 2019
+
+import os
+import re
+import sys
+
+if len(sys.argv) != 3:
+    print("Syntax: %s <suite/MC> <tests>" %sys.argv[0])
+    sys.exit(1)
+
+mc_dir, tests_dir = sys.argv[1:3]
+
+# archs of suite/MC: name printed by the benchmark
+arch_names = {
+    'CS_ARCH_ARM': 'arm',
+    'CS_ARCH_ARM64': 'arm64',
+    'CS_ARCH_MIPS': 'mips',
+    'CS_ARCH_X86': 'x86',
+    'CS_ARCH_PPC': 'ppc',
+    'CS_ARCH_SPARC': 'sparc',
+    'CS_ARCH_SYSZ': 'sysz',
+    'CS_ARCH_BPF': 'bpf',
+    'CS_ARCH_RISCV': 'riscv',
+}
+
+# archs without suite/MC test files: (arch, mode, mode name, file of tests/, code)
+samples = [
+    ('CS_ARCH_M68K', 'CS_MODE_BIG_ENDIAN | CS_MODE_M68K_040', 'm68k_040', 'test_m68k.c', 'M68K_CODE'),
+    ('CS_ARCH_XCORE', 'CS_MODE_BIG_ENDIAN', 'big_endian', 'test_xcore.c', 'XCORE_CODE'),
+    ('CS_ARCH_TMS320C64X', 'CS_MODE_BIG_ENDIAN', 'big_endian', 'test_tms320c64x.c', 'TMS320C64X_CODE'),
+    ('CS_ARCH_M680X', 'CS_MODE_M680X_6809', 'm680x_6809', 'test_m680x.c', 'M6809_CODE'),
+    ('CS_ARCH_EVM', '0', 'default', 'test_evm.c', 'EVM_CODE'),
+    ('CS_ARCH_WASM', '0', 'default', 'test_wasm.c', 'WASM_CODE'),
+    ('CS_ARCH_MOS65XX', 'CS_MODE_MOS65XX_6502', 'mos65xx_6502', 'test_mos65xx.c', 'M6502_CODE'),
+]
+
+# "CS_MODE_THUMB+CS_MODE_V8" -> sorted list of modes, so the same mode
+# written in another order goes to the same corpus
+def parse_mode(mode):
+    modes = [m.strip() for m in mode.split('+')]
+    return sorted(m for m in modes if m not in ('', '0'))
+
+# instructions of all suite/MC files, by (arch, modes)
+def read_mc(mc_dir):
+    corpora = {}
+    for arch_dir in sorted(os.listdir(mc_dir)):
+        path = os.path.join(mc_dir, arch_dir)
+        if not os.path.isdir(path):
+            continue
+        for name in sorted(os.listdir(path)):
+            if not name.endswith('.cs'):
+                continue
+            lines = open(os.path.join(path, name)).readlines()
+            header = re.match(r'#\s*(CS_ARCH_\w+)\s*,\s*([^,]*),', lines[0])
+            if header is None or header.group(1) not in arch_names:
+                continue
+            key = (header.group(1), tuple(parse_mode(header.group(2))))
+            insns = corpora.setdefault(key, [])
+            for line in lines[1:]:
+                # commented out lines are encodings Capstone gets wrong
+                m = re.match(r'\s*(0x[0-9a-fA-F]{1,2}(\s*,\s*0x[0-9a-fA-F]{1,2})*)\s*=', line)
+                if m:
+                    insns.append([int(b, 16) for b in m.group(1).split(',')])
+    return corpora
+
+# bytes of a C string literal, given by "#define @name" of @filename
+def read_sample(filename, name):
+    text = open(filename).read()
+    m = re.search(r'#define\s+%s\s+((\s*\\\n|\s*"(\\.|[^"\\])*")+)' %name, text)
+    code = []
+    for literal in re.findall(r'"((?:\\.|[^"\\])*)"', m.group(1)):
+        code.extend(int(b, 16) for b in re.findall(r'\\x([0-9a-fA-F]{2})', literal))
+    return code
+
+def print_bytes(code, indent='\t'):
+    for i in range(0, len(code), 16):
+        print(indent + ' '.join('0x%02x,' %b for b in code[i:i + 16]))
+
+print("/* Capstone Disassembly Engine, http://www.capstone-engine.org */")
+print("/* This is auto-gen data for Capstone disassembly engine (www.capstone-engine.org) */")
+print("/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */")
+print("")
+print("// generated by gen_corpus.py from suite/MC and tests/. do not edit.")
+print("")
+
+corpora = read_mc(mc_dir)
+entries = []
+
+for (arch, modes) in sorted(corpora):
+    insns = corpora[(arch, modes)]
+    mode_name = '+'.join(m[len('CS_MODE_'):].lower() for m in modes) or 'default'
+    var = 'corpus_%s%s' %(arch_names[arch], ''.join('_' + m[len('CS_MODE_'):].lower() for m in modes))
+
+    print("// %s: %u instructions of suite/MC" %(var, len(insns)))
+    print("static const uint8_t %s[] = {" %var)
+    for insn in insns:
+        print('\t' + ' '.join('0x%02x,' %b for b in insn))
+    print("};")
+    print("")
+
+    # lengths of instructions, so the benchmark can drop those that do not decode
+    print("static const uint8_t %s_len[] = {" %var)
+    lengths = [len(insn) for insn in insns]
+    print_bytes(lengths)
+    print("};")
+    print("")
+
+    entries.append((arch, ' | '.join(modes) if modes else '0', arch_names[arch], mode_name, var, var + '_len'))
+
+for (arch, mode, mode_name, filename, name) in samples:
+    code = read_sample(os.path.join(tests_dir, filename), name)
+    var = 'corpus_%s' %arch[len('CS_ARCH_'):].lower()
+
+    print("// %s: %s of tests/%s" %(var, name, filename))
+    print("static const uint8_t %s[] = {" %var)
+    print_bytes(code)
+    print("};")
+    print("")
+
+    entries.append((arch, mode, arch[len('CS_ARCH_'):].lower(), mode_name, var, 'NULL'))
+
+print("static const struct corpus corpora[] = {")
+for (arch, mode, arch_name, mode_name, var, lengths) in entries:
+    print('\t{ %s, (cs_mode)(%s), "%s", "%s", %s, sizeof(%s), %s },' %(arch, mode,
+        arch_name, mode_name, var, var, lengths))
+print("};")
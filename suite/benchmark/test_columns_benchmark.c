@@ -0,0 +1,116 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// Compare cs_disasm() & cs_disasm_columns() on X86-64 code with detail: time
+// to disassemble, then time to scan all instructions for branches & memory
+// operands, like an analysis pass over a large binary.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+// typical compiler output: prologue, moves, arithmetic, SSE, calls & branches
+#define X86_CODE64 \
+	"\x55\x48\x89\xe5\x41\x57\x41\x56\x53\x48\x83\xec\x28\x48\x89\x7d\xc8\x89\x75\xc4" \
+	"\x48\x8b\x05\xb8\x13\x00\x00\x48\x8b\x00\x48\x89\x45\xe0\x31\xc0\x8b\x45\xc4\x48" \
+	"\x63\xd0\x48\x8d\x0c\x95\x00\x00\x00\x00\x48\x8b\x45\xc8\x48\x01\xc8\x8b\x00\x85" \
+	"\xc0\x74\x12\x0f\xb6\x45\xbf\x0f\xbe\xc0\x89\xc7\xe8\xdf\xbe\xad\xde\x66\x90\xf2" \
+	"\x0f\x10\x45\xd8\xf2\x0f\x59\xc1\xf2\x0f\x11\x45\xd0\x66\x0f\xef\xc0\x0f\x28\xc8" \
+	"\x48\x39\xd8\x0f\x8c\x70\xff\xff\xff\x4c\x8d\x3c\x24\x49\x8b\x3f\xff\x15\x23\x01" \
+	"\x00\x00\x48\x85\xc0\x0f\x95\xc0\x0f\xb6\xc0\x48\x83\xc4\x28\x5b\x41\x5e\x41\x5f" \
+	"\x5d\xc3\x0f\x1f\x44\x00\x00\xf3\xa4\x48\xc1\xe8\x03\x48\x0f\xaf\xc2\x0f\x44\xc1"
+
+#define DEFAULT_SIZE (4 * 1024 * 1024)
+
+#define SCAN_LOOPS 20
+
+static double seconds(clock_t start)
+{
+	return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+	csh handle;
+	cs_insn *insn;
+	cs_columns *cols;
+	uint8_t *code;
+	size_t size = DEFAULT_SIZE, count, i, j, branches, mems;
+	int loop;
+	clock_t start;
+	double disasm_time, scan_time;
+	cs_err err;
+
+	if (argc > 1)
+		size = (size_t)strtoul(argv[1], NULL, 0);
+
+	code = malloc(size);
+	for (i = 0; i < size; i++)
+		code[i] = X86_CODE64[i % (sizeof(X86_CODE64) - 1)];
+
+	err = cs_open(CS_ARCH_X86, CS_MODE_64, &handle);
+	if (err) {
+		printf("Failed on cs_open() with error returned: %u\n", err);
+		return 1;
+	}
+
+	cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+	cs_option(handle, CS_OPT_NO_TEXT, CS_OPT_ON);
+
+	start = clock();
+	count = cs_disasm(handle, code, size, 0x1000, 0, &insn);
+	disasm_time = seconds(start);
+
+	start = clock();
+	for (loop = 0, branches = 0, mems = 0; loop < SCAN_LOOPS; loop++) {
+		for (i = 0; i < count; i++) {
+			const cs_detail *detail = insn[i].detail;
+
+			for (j = 0; j < detail->groups_count; j++) {
+				if (detail->groups[j] == X86_GRP_JUMP)
+					branches++;
+			}
+
+			for (j = 0; j < detail->x86.op_count; j++) {
+				if (detail->x86.operands[j].type == X86_OP_MEM)
+					mems++;
+			}
+		}
+	}
+	scan_time = seconds(start);
+
+	printf("cs_disasm:         %u insns, disasm %.3f s, scan %.1f ns/insn (%u branches, %u memory operands)\n",
+			(unsigned int)count, disasm_time, scan_time * 1e9 / SCAN_LOOPS / count,
+			(unsigned int)(branches / SCAN_LOOPS), (unsigned int)(mems / SCAN_LOOPS));
+
+	cs_free(insn, count);
+
+	start = clock();
+	count = cs_disasm_columns(handle, code, size, 0x1000, 0, &cols);
+	disasm_time = seconds(start);
+
+	start = clock();
+	for (loop = 0, branches = 0, mems = 0; loop < SCAN_LOOPS; loop++) {
+		for (i = 0; i < count; i++)
+			branches += (cols->groups[i * CS_COLUMN_GROUP_WORDS + X86_GRP_JUMP / 64] >>
+					(X86_GRP_JUMP % 64)) & 1;
+
+		for (i = 0; i < cols->op_total; i++)
+			mems += cols->op_type[i] == X86_OP_MEM;
+	}
+	scan_time = seconds(start);
+
+	printf("cs_disasm_columns: %u insns, disasm %.3f s, scan %.1f ns/insn (%u branches, %u memory operands)\n",
+			(unsigned int)count, disasm_time, scan_time * 1e9 / SCAN_LOOPS / count,
+			(unsigned int)(branches / SCAN_LOOPS), (unsigned int)(mems / SCAN_LOOPS));
+
+	cs_free_columns(cols);
+	cs_close(&handle);
+	free(code);
+
+	return 0;
+}
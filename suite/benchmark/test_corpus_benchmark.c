@@ -0,0 +1,388 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// Disassemble the corpus of every supported arch & mode, derived from the
+// suite/MC test files (see gen_corpus.py), with cs_disasm() & cs_disasm_iter(),
+// detail off & on, in each syntax of the arch. Report the time & the number of
+// memory allocations per instruction of each, as CSV on stdout.
+// With a baseline CSV of an earlier run, also report the rows that got slower
+// by more than the tolerance, or that allocate more, and exit with 1 if any.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+struct corpus {
+	cs_arch arch;
+	cs_mode mode;
+	const char *arch_name;
+	const char *mode_name;
+	const uint8_t *code;
+	size_t size;
+	const uint8_t *lengths;	// length of each instruction, or NULL if unknown
+};
+
+#include "corpus.inc"
+
+#define DEFAULT_INSN_COUNT 100000
+
+// measurements of each row, to keep the fastest
+#define ROUNDS 5
+
+// default tolerance on the time per instruction, in percent
+#define DEFAULT_TOLERANCE 10
+
+#define ADDRESS 0x1000
+
+static struct {
+	cs_arch arch;
+	cs_opt_value syntax;
+	const char *name;
+} syntaxes[] = {
+	{ CS_ARCH_X86, CS_OPT_SYNTAX_ATT, "att" },
+	{ CS_ARCH_X86, CS_OPT_SYNTAX_MASM, "masm" },
+	{ CS_ARCH_ARM, CS_OPT_SYNTAX_NOREGNAME, "noregname" },
+	{ CS_ARCH_PPC, CS_OPT_SYNTAX_NOREGNAME, "noregname" },
+	{ CS_ARCH_MOS65XX, CS_OPT_SYNTAX_MOTOROLA, "motorola" },
+};
+
+// one measurement
+struct result {
+	char key[128];	// arch,mode,syntax,detail,api
+	double ns;	// time per instruction
+	double allocs;	// memory allocations per instruction
+};
+
+static size_t allocs;
+
+static void *count_malloc(size_t size)
+{
+	allocs++;
+	return malloc(size);
+}
+
+static void *count_calloc(size_t nmemb, size_t size)
+{
+	allocs++;
+	return calloc(nmemb, size);
+}
+
+static void *count_realloc(void *ptr, size_t size)
+{
+	allocs++;
+	return realloc(ptr, size);
+}
+
+// drop the instructions of @c that Capstone does not decode as a whole, so that
+// cs_disasm() goes through all of the corpus. return the code to disassemble,
+// to be freed by the caller, or NULL if nothing decodes.
+static uint8_t *prepare(csh handle, const struct corpus *c, size_t *size)
+{
+	uint8_t *code = malloc(c->size);
+	cs_insn *insn;
+	size_t offset = 0, i = 0;
+
+	*size = 0;
+	if (!code)
+		return NULL;
+
+	if (!c->lengths) {
+		// sample code: keep all of it
+		memcpy(code, c->code, c->size);
+		*size = c->size;
+		return code;
+	}
+
+	while (offset < c->size) {
+		size_t len = c->lengths[i++];
+
+		if (cs_disasm(handle, c->code + offset, len, ADDRESS + offset, 1, &insn) == 1) {
+			if (insn->size == len) {
+				memcpy(code + *size, c->code + offset, len);
+				*size += len;
+			}
+			cs_free(insn, 1);
+		}
+
+		offset += len;
+	}
+
+	if (*size == 0) {
+		free(code);
+		return NULL;
+	}
+
+	return code;
+}
+
+// disassemble @code in ROUNDS rounds, together at least @insn_count instructions.
+// the time is the one of the fastest round, which is the least disturbed by
+// the rest of the system. return the number of instructions of @code, or 0 on error
+static size_t measure(csh handle, const uint8_t *code, size_t size, bool iter,
+		size_t insn_count, double *ns, double *allocs_per_insn)
+{
+	size_t count = 0, total = 0, round_total, n;
+	cs_insn *insn = NULL;
+	clock_t start;
+	double round_ns;
+	int round;
+
+	if (iter) {
+		// allocated once for all instructions, like any cs_disasm_iter() user
+		insn = cs_malloc(handle);
+		if (!insn)
+			return 0;
+	}
+
+	allocs = 0;
+	*ns = 0;
+
+	for (round = 0; round < ROUNDS; round++) {
+		round_total = 0;
+		start = clock();
+
+		while (round_total < insn_count / ROUNDS + 1) {
+			if (iter) {
+				const uint8_t *c = code;
+				size_t s = size;
+				uint64_t address = ADDRESS;
+
+				n = 0;
+				while (cs_disasm_iter(handle, &c, &s, &address, insn))
+					n++;
+			} else {
+				n = cs_disasm(handle, code, size, ADDRESS, 0, &insn);
+				cs_free(insn, n);
+			}
+
+			if (n == 0)
+				break;
+
+			count = n;
+			round_total += n;
+		}
+
+		if (round_total == 0)
+			break;
+
+		round_ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / round_total;
+		if (round == 0 || round_ns < *ns)
+			*ns = round_ns;
+
+		total += round_total;
+	}
+
+	*allocs_per_insn = (double)allocs / (total ? total : 1);
+
+	if (iter)
+		cs_free(insn, 1);
+
+	return count;
+}
+
+// load the rows of a CSV file of an earlier run. return their number, or -1
+static int load_baseline(const char *filename, struct result **rows)
+{
+	char line[256];
+	FILE *f;
+	int count = 0, max = 0;
+
+	f = fopen(filename, "r");
+	if (!f)
+		return -1;
+
+	*rows = NULL;
+	while (fgets(line, sizeof(line), f)) {
+		struct result *r;
+		char *field = line;
+		int i;
+
+		// key is the first 5 fields, then insns, bytes, ns_per_insn & allocs_per_insn
+		for (i = 0; i < 5 && field; i++)
+			field = strchr(field + (i > 0), ',');
+		if (!field || !strncmp(line, "arch,", 5))
+			continue;
+
+		if (count == max) {
+			max = max ? max * 2 : 256;
+			r = realloc(*rows, max * sizeof(**rows));
+			if (!r)
+				break;
+			*rows = r;
+		}
+
+		r = &(*rows)[count];
+		if ((size_t)(field - line) >= sizeof(r->key))
+			continue;
+		memcpy(r->key, line, field - line);
+		r->key[field - line] = '\0';
+
+		if (sscanf(field, ",%*u,%*u,%lf,%lf", &r->ns, &r->allocs) == 2)
+			count++;
+	}
+
+	fclose(f);
+
+	return count;
+}
+
+static const struct result *find_row(const struct result *rows, int count, const char *key)
+{
+	int i;
+
+	for (i = 0; i < count; i++) {
+		if (!strcmp(rows[i].key, key))
+			return &rows[i];
+	}
+
+	return NULL;
+}
+
+// compare a measurement with its baseline. return true if it regressed
+static bool regressed(const struct result *base, const struct result *r, double tolerance)
+{
+	bool slower = r->ns > base->ns * (1 + tolerance / 100);
+	// allocations do not vary between runs: any more is a regression
+	bool allocs_more = r->allocs > base->allocs + 0.0005;
+
+	if (slower)
+		fprintf(stderr, "REGRESSION: %s: %.2f ns/insn, baseline %.2f ns/insn\n",
+				r->key, r->ns, base->ns);
+
+	if (allocs_more)
+		fprintf(stderr, "REGRESSION: %s: %.3f allocs/insn, baseline %.3f allocs/insn\n",
+				r->key, r->allocs, base->allocs);
+
+	return slower || allocs_more;
+}
+
+static void usage(const char *prog)
+{
+	printf("Syntax: %s [-n insn-count] [-b baseline.csv] [-t tolerance-percent] [arch]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+	size_t insn_count = DEFAULT_INSN_COUNT;
+	double tolerance = DEFAULT_TOLERANCE;
+	const char *baseline = NULL, *only_arch = NULL;
+	struct result *base_rows = NULL;
+	int base_count = 0, regressions = 0;
+	cs_opt_mem mem;
+	size_t i, s;
+	int j;
+
+	for (j = 1; j < argc; j++) {
+		if (!strcmp(argv[j], "-n") && j + 1 < argc) {
+			insn_count = (size_t)strtoull(argv[++j], NULL, 0);
+		} else if (!strcmp(argv[j], "-b") && j + 1 < argc) {
+			baseline = argv[++j];
+		} else if (!strcmp(argv[j], "-t") && j + 1 < argc) {
+			tolerance = atof(argv[++j]);
+		} else if (argv[j][0] != '-' && !only_arch) {
+			only_arch = argv[j];
+		} else {
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (baseline) {
+		base_count = load_baseline(baseline, &base_rows);
+		if (base_count < 0) {
+			fprintf(stderr, "ERROR: cannot read baseline %s\n", baseline);
+			return 1;
+		}
+	}
+
+	// count allocations of all handles
+	mem.malloc = count_malloc;
+	mem.calloc = count_calloc;
+	mem.realloc = count_realloc;
+	mem.free = free;
+	mem.vsnprintf = vsnprintf;
+	cs_option(0, CS_OPT_MEM, (size_t)&mem);
+
+	printf("arch,mode,syntax,detail,api,insns,bytes,ns_per_insn,allocs_per_insn\n");
+
+	for (i = 0; i < sizeof(corpora) / sizeof(corpora[0]); i++) {
+		const struct corpus *c = &corpora[i];
+		uint8_t *code;
+		size_t size;
+		csh handle;
+
+		if (!cs_support(c->arch) || (only_arch && strcmp(only_arch, c->arch_name)))
+			continue;
+
+		if (cs_open(c->arch, c->mode, &handle)) {
+			fprintf(stderr, "ERROR: cs_open() failed for %s %s\n", c->arch_name, c->mode_name);
+			return 1;
+		}
+
+		code = prepare(handle, c, &size);
+		if (!code) {
+			fprintf(stderr, "WARNING: nothing decodes in corpus of %s %s\n", c->arch_name, c->mode_name);
+			cs_close(&handle);
+			continue;
+		}
+
+		// default syntax first, then the other syntaxes of the arch
+		for (s = 0; s <= sizeof(syntaxes) / sizeof(syntaxes[0]); s++) {
+			const char *syntax = "default";
+			int detail;
+
+			if (s > 0) {
+				if (syntaxes[s - 1].arch != c->arch)
+					continue;
+				// not available in this build, like AT&T with CAPSTONE_X86_ATT_DISABLE
+				if (cs_option(handle, CS_OPT_SYNTAX, syntaxes[s - 1].syntax))
+					continue;
+				syntax = syntaxes[s - 1].name;
+			}
+
+			for (detail = 0; detail < 2; detail++) {
+				int iter;
+
+				cs_option(handle, CS_OPT_DETAIL, detail ? CS_OPT_ON : CS_OPT_OFF);
+
+				for (iter = 0; iter < 2; iter++) {
+					struct result r;
+					size_t count;
+
+					count = measure(handle, code, size, iter, insn_count, &r.ns, &r.allocs);
+					if (count == 0)
+						continue;
+
+					snprintf(r.key, sizeof(r.key), "%s,%s,%s,%d,%s", c->arch_name, c->mode_name,
+							syntax, detail, iter ? "iter" : "disasm");
+					printf("%s,%" PRIu64 ",%" PRIu64 ",%.2f,%.3f\n", r.key, (uint64_t)count,
+							(uint64_t)size, r.ns, r.allocs);
+					fflush(stdout);
+
+					if (base_rows) {
+						const struct result *base = find_row(base_rows, base_count, r.key);
+						if (base && regressed(base, &r, tolerance))
+							regressions++;
+					}
+				}
+			}
+		}
+
+		free(code);
+		cs_close(&handle);
+	}
+
+	free(base_rows);
+
+	if (regressions) {
+		fprintf(stderr, "%d regressions against %s\n", regressions, baseline);
+		return 1;
+	}
+
+	return 0;
+}
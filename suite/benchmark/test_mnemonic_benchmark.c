@@ -0,0 +1,97 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// Measure the cost of customized mnemonics (CS_OPT_MNEMONIC): X86-64 code is
+// disassembled without any override, then with an override for every X86
+// instruction, like a tool renaming all mnemonics for its own IR.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+#define X86_CODE64 \
+	"\x55\x48\x89\xe5\x41\x57\x41\x56\x53\x48\x83\xec\x28\x48\x89\x7d\xc8\x89\x75\xc4" \
+	"\x48\x8b\x05\xb8\x13\x00\x00\x48\x8b\x00\x48\x89\x45\xe0\x31\xc0\x8b\x45\xc4\x48" \
+	"\x63\xd0\x48\x8d\x0c\x95\x00\x00\x00\x00\x48\x8b\x45\xc8\x48\x01\xc8\x8b\x00\x85" \
+	"\xc0\x74\x12\x0f\xb6\x45\xbf\x0f\xbe\xc0\x89\xc7\xe8\xdf\xbe\xad\xde\x66\x90\xf2" \
+	"\x0f\x10\x45\xd8\xf2\x0f\x59\xc1\xf2\x0f\x11\x45\xd0\x66\x0f\xef\xc0\x0f\x28\xc8" \
+	"\x48\x39\xd8\x0f\x8c\x70\xff\xff\xff\x4c\x8d\x3c\x24\x49\x8b\x3f\xff\x15\x23\x01" \
+	"\x00\x00\x48\x85\xc0\x0f\x95\xc0\x0f\xb6\xc0\x48\x83\xc4\x28\x5b\x41\x5e\x41\x5f" \
+	"\x5d\xc3\x0f\x1f\x44\x00\x00\xf3\xa4\x48\xc1\xe8\x03\x48\x0f\xaf\xc2\x0f\x44\xc1"
+
+#define DEFAULT_COUNT 5000000
+
+// return nanoseconds per instruction
+static double run(csh handle, size_t max_count)
+{
+	cs_insn *insn;
+	const uint8_t *code;
+	size_t size, count = 0;
+	uint64_t address;
+	clock_t start, end;
+
+	insn = cs_malloc(handle);
+
+	start = clock();
+	while (count < max_count) {
+		code = (const uint8_t *)X86_CODE64;
+		size = sizeof(X86_CODE64) - 1;
+		address = 0x1000;
+		while (cs_disasm_iter(handle, &code, &size, &address, insn))
+			count++;
+	}
+	end = clock();
+
+	cs_free(insn, 1);
+
+	return (double)(end - start) / CLOCKS_PER_SEC * 1e9 / count;
+}
+
+int main(int argc, char **argv)
+{
+	csh handle;
+	cs_opt_mnem opt;
+	char mnemonic[32];
+	size_t max_count = DEFAULT_COUNT;
+	double plain, customized;
+	unsigned int id, n = 0;
+	cs_err err;
+
+	if (argc > 1)
+		max_count = (size_t)strtoul(argv[1], NULL, 0);
+
+	err = cs_open(CS_ARCH_X86, CS_MODE_64, &handle);
+	if (err) {
+		printf("Failed on cs_open() with error returned: %u\n", err);
+		return 1;
+	}
+
+	plain = run(handle, max_count);
+
+	// rename every instruction, e.g "mov" -> "ir.mov"
+	for (id = 1; id < X86_INS_ENDING; id++) {
+		const char *name = cs_insn_name(handle, id);
+
+		if (!name)
+			continue;
+
+		snprintf(mnemonic, sizeof(mnemonic), "ir.%s", name);
+		opt.id = id;
+		opt.mnemonic = mnemonic;
+		if (cs_option(handle, CS_OPT_MNEMONIC, (size_t)&opt) == CS_ERR_OK)
+			n++;
+	}
+
+	customized = run(handle, max_count);
+
+	printf("no customized mnemonic: %.1f ns/insn, %u customized mnemonics: %.1f ns/insn\n",
+			plain, n, customized);
+
+	cs_close(&handle);
+
+	return 0;
+}
@@ -0,0 +1,230 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// Measure the cost of printing the text of an instruction: the code is decoded
+// once into MCInsts, then only the instruction printer of the arch is timed,
+// printing these MCInsts again & again.
+// this uses the internal printer API, so link with the static library.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <capstone/platform.h>
+
+#include "../../cs_priv.h"
+#include "../../MCInst.h"
+#include "../../SStream.h"
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	unsigned char *code;
+	size_t size;
+	const char *comment;
+	cs_opt_value syntax;
+};
+
+// immediates & displacements of all sizes, so numbers dominate the text
+#define X86_CODE64 "\x48\x8b\x05\xb8\x13\x00\x00\x48\x81\xc4\x88\x00\x00\x00\xc7\x44\x24\x08\x01\x00\x00\x00\x48\x8d\x4c\x32\x08\x83\xe8\xf0\x48\xb8\xef\xcd\xab\x89\x67\x45\x23\x01\xe8\xdf\xbe\xad\xde\x8b\x84\x91\x23\x01\x00\x00\x74\xff\x6a\x7f\x66\x83\xc0\x09"
+#define ARM_CODE "\x04\xe0\x2d\xe5\xe0\x83\x22\xe5\xf1\x02\x03\x0e\x00\x00\xa0\xe3\x02\x30\xc1\xe7\x00\x00\x53\xe3\x86\x10\x81\xe2\x10\x00\x90\xe5\xff\x00\x00\xe2"
+#define ARM64_CODE "\x09\x00\x38\xd5\x20\x50\x02\x0e\x20\xe4\x3d\x0f\x00\x18\xa0\x5f\xa2\x00\xae\x9e\x21\x7c\x00\x53\xe1\x0b\x40\xb9\xfd\x7b\xbf\xa9\x00\x40\x00\x91\xff\x43\x00\xd1"
+#define PPC_CODE "\x80\x20\x00\x00\x80\x3f\x00\x00\x10\x43\x23\x0e\xd0\x44\x00\x80\x4c\x43\x22\x02\x2d\x03\x00\x80\x7c\x43\x20\x14\x38\x21\xff\xf0\x94\x21\xff\xc0"
+
+static struct platform platforms[] = {
+	{
+		CS_ARCH_X86,
+		CS_MODE_64,
+		(unsigned char *)X86_CODE64,
+		sizeof(X86_CODE64) - 1,
+		"X86 64 (Intel syntax)",
+		CS_OPT_SYNTAX_INTEL
+	},
+	{
+		CS_ARCH_X86,
+		CS_MODE_64,
+		(unsigned char *)X86_CODE64,
+		sizeof(X86_CODE64) - 1,
+		"X86 64 (AT&T syntax)",
+		CS_OPT_SYNTAX_ATT
+	},
+	{
+		CS_ARCH_ARM,
+		CS_MODE_ARM,
+		(unsigned char *)ARM_CODE,
+		sizeof(ARM_CODE) - 1,
+		"ARM",
+		CS_OPT_SYNTAX_DEFAULT
+	},
+	{
+		CS_ARCH_ARM64,
+		CS_MODE_ARM,
+		(unsigned char *)ARM64_CODE,
+		sizeof(ARM64_CODE) - 1,
+		"ARM-64",
+		CS_OPT_SYNTAX_DEFAULT
+	},
+	{
+		CS_ARCH_PPC,
+		CS_MODE_BIG_ENDIAN,
+		(unsigned char *)PPC_CODE,
+		sizeof(PPC_CODE) - 1,
+		"PPC-64",
+		CS_OPT_SYNTAX_DEFAULT
+	},
+};
+
+#define DEFAULT_COUNT 2000000
+
+// enough for the code of any platform above
+#define MAX_INSNS 32
+
+// instructions of a platform, decoded once for the printer
+static struct {
+	MCInst mci[MAX_INSNS];
+	cs_insn insn[MAX_INSNS];
+	char text[MAX_INSNS][sizeof(((SStream *)0)->buffer)];	// printed once
+	size_t count;
+} decoded;
+
+// decode the code of @platform into @decoded, like cs_disasm() without detail,
+// but keeping the MCInst of each instruction. return the number of instructions
+static size_t decode(csh ud, struct platform *platform)
+{
+	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
+	const uint8_t *code = platform->code;
+	size_t size = platform->size;
+	uint64_t address = 0x1000;
+	uint16_t insn_size;
+	SStream ss;
+
+	decoded.count = 0;
+	while (size > 0 && decoded.count < MAX_INSNS) {
+		MCInst *mci = &decoded.mci[decoded.count];
+		cs_insn *insn = &decoded.insn[decoded.count];
+
+		MCInst_Init(mci);
+		mci->csh = handle;
+		mci->address = address;
+		mci->flat_insn = insn;
+		insn->address = address;
+		insn->detail = NULL;
+
+		if (!handle->disasm(ud, code, size, mci, &insn_size, address, handle->getinsn_info))
+			break;
+
+		insn->size = insn_size;
+		handle->insn_id(handle, insn, mci->Opcode);
+
+		SStream_Init(&ss);
+		handle->printer(mci, &ss, handle->printer_info);
+		strcpy(decoded.text[decoded.count], ss.buffer);
+
+		code += insn_size;
+		size -= insn_size;
+		address += insn_size;
+		decoded.count++;
+	}
+
+	return decoded.count;
+}
+
+// print the decoded instructions until @max_count are printed.
+// return nanoseconds per instruction, or a negative value if printing an
+// instruction again does not give the same text
+static double print(csh ud, size_t max_count)
+{
+	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
+	size_t count = 0, i;
+	clock_t start, end;
+	SStream ss;
+
+	start = clock();
+	while (count < max_count) {
+		for (i = 0; i < decoded.count; i++) {
+			SStream_Init(&ss);
+			handle->printer(&decoded.mci[i], &ss, handle->printer_info);
+		}
+		count += decoded.count;
+	}
+	end = clock();
+
+	// the printers must not depend on what an earlier printing left in MCInst
+	for (i = 0; i < decoded.count; i++) {
+		SStream_Init(&ss);
+		handle->printer(&decoded.mci[i], &ss, handle->printer_info);
+		if (strcmp(ss.buffer, decoded.text[i]))
+			return -1;
+	}
+
+	return (double)(end - start) / CLOCKS_PER_SEC * 1e9 / count;
+}
+
+// return nanoseconds per instruction of cs_disasm_iter(), for comparison
+static double run(csh handle, struct platform *platform, size_t max_count)
+{
+	cs_insn *insn;
+	const uint8_t *code;
+	size_t size, count = 0;
+	uint64_t address;
+	clock_t start, end;
+
+	insn = cs_malloc(handle);
+
+	start = clock();
+	while (count < max_count) {
+		code = platform->code;
+		size = platform->size;
+		address = 0x1000;
+		while (cs_disasm_iter(handle, &code, &size, &address, insn))
+			count++;
+	}
+	end = clock();
+
+	cs_free(insn, 1);
+
+	return (double)(end - start) / CLOCKS_PER_SEC * 1e9 / count;
+}
+
+int main(int argc, char **argv)
+{
+	csh handle;
+	size_t max_count = DEFAULT_COUNT;
+	double printing, total;
+	int i;
+
+	if (argc > 1)
+		max_count = (size_t)strtoul(argv[1], NULL, 0);
+
+	for (i = 0; i < sizeof(platforms)/sizeof(platforms[0]); i++) {
+		if (cs_open(platforms[i].arch, platforms[i].mode, &handle)) {
+			printf("%s: not supported\n", platforms[i].comment);
+			continue;
+		}
+
+		if (platforms[i].syntax != CS_OPT_SYNTAX_DEFAULT)
+			cs_option(handle, CS_OPT_SYNTAX, platforms[i].syntax);
+
+		if (!decode(handle, &platforms[i])) {
+			printf("%s: nothing decodes\n", platforms[i].comment);
+			cs_close(&handle);
+			continue;
+		}
+
+		printing = print(handle, max_count);
+		if (printing < 0) {
+			printf("ERROR: %s: printing again gives another text\n", platforms[i].comment);
+			return 1;
+		}
+
+		total = run(handle, &platforms[i], max_count);
+
+		printf("%-24s printing %7.1f ns/insn, cs_disasm_iter() %7.1f ns/insn\n",
+				platforms[i].comment, printing, total);
+
+		cs_close(&handle);
+	}
+
+	return 0;
+}
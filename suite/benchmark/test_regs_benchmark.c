@@ -0,0 +1,124 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// Measure the register lookups done by the AArch64 & ARM printers:
+// MCRegisterInfo_getSubReg() & MCRegisterInfo_getMatchingSuperReg() with the
+// precomputed tables, compared to walking the sub-register & super-register
+// lists, plus register class membership.
+// this uses the internal MCRegisterInfo API, so link with the static library.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <capstone/platform.h>
+
+#include "../../MCRegisterInfo.h"
+
+#define GET_REGINFO_ENUM
+#include "../../arch/AArch64/AArch64GenRegisterInfo.inc"
+#define GET_REGINFO_ENUM
+#include "../../arch/ARM/ARMGenRegisterInfo.inc"
+
+void AArch64_init(MCRegisterInfo *MRI);
+void ARM_init(MCRegisterInfo *MRI);
+
+#define DEFAULT_LOOPS 2000
+
+static const unsigned aarch64_indices[] = {
+	AArch64_dsub0, AArch64_qsub0, AArch64_zsub0,
+	AArch64_sube32, AArch64_subo32, AArch64_sube64, AArch64_subo64,
+};
+
+static const unsigned arm_indices[] = {
+	ARM_gsub_0, ARM_gsub_1, ARM_dsub_0, ARM_dsub_1,
+};
+
+// look up sub-registers of all registers for @indices, then the matching
+// super-register of @super_idx in class @super_class. return a checksum
+static unsigned lookup(const MCRegisterInfo *MRI, const unsigned *indices, size_t count,
+		unsigned super_idx, unsigned super_class, int loops, double *seconds)
+{
+	const MCRegisterClass *RC = MCRegisterInfo_getRegClass(MRI, super_class);
+	unsigned reg, sum = 0;
+	clock_t start = clock();
+	size_t i;
+	int loop;
+
+	for (loop = 0; loop < loops; loop++) {
+		for (reg = 1; reg < MRI->NumRegs; reg++) {
+			for (i = 0; i < count; i++)
+				sum += MCRegisterInfo_getSubReg(MRI, reg, indices[i]);
+
+			sum += MCRegisterInfo_getMatchingSuperReg(MRI, reg, super_idx, RC);
+		}
+	}
+
+	*seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	return sum;
+}
+
+static unsigned contains(const MCRegisterInfo *MRI, int loops, double *seconds)
+{
+	unsigned reg, class, sum = 0;
+	clock_t start = clock();
+	int loop;
+
+	for (loop = 0; loop < loops; loop++) {
+		for (class = 0; class < MRI->NumClasses; class++) {
+			for (reg = 1; reg < MRI->NumRegs; reg++)
+				sum += MCRegisterClass_contains(MCRegisterInfo_getRegClass(MRI, class), reg);
+		}
+	}
+
+	*seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	return sum;
+}
+
+static void bench(const char *name, void (*init)(MCRegisterInfo *),
+		const unsigned *indices, size_t count, unsigned super_idx, unsigned super_class, int loops)
+{
+	MCRegisterInfo table, walk;
+	unsigned sum_table, sum_walk, sum;
+	double lookups, time_table, time_walk, time_contains;
+
+	init(&table);
+	walk = table;
+	MCRegisterInfo_setSubRegTables(&walk, NULL, NULL);
+
+	sum_table = lookup(&table, indices, count, super_idx, super_class, loops, &time_table);
+	sum_walk = lookup(&walk, indices, count, super_idx, super_class, loops, &time_walk);
+	if (sum_table != sum_walk) {
+		printf("ERROR: %s: tables give different registers\n", name);
+		exit(1);
+	}
+
+	lookups = (double)loops * (table.NumRegs - 1) * (count + 1);
+	printf("%-8s sub/super-register: tables %.2f ns/lookup, lists %.2f ns/lookup\n",
+			name, time_table * 1e9 / lookups, time_walk * 1e9 / lookups);
+
+	sum = contains(&table, loops / 10, &time_contains);
+	lookups = (double)(loops / 10) * table.NumClasses * (table.NumRegs - 1);
+	printf("%-8s class membership: %.2f ns/lookup (%u members)\n",
+			name, time_contains * 1e9 / lookups, sum / (loops / 10));
+}
+
+int main(int argc, char **argv)
+{
+	int loops = DEFAULT_LOOPS;
+
+	if (argc > 1)
+		loops = atoi(argv[1]);
+
+	if (loops < 10)
+		loops = 10;
+
+	bench("AArch64", AArch64_init, aarch64_indices, sizeof(aarch64_indices) / sizeof(aarch64_indices[0]),
+			AArch64_dsub, AArch64_FPR128RegClassID, loops);
+	bench("ARM", ARM_init, arm_indices, sizeof(arm_indices) / sizeof(arm_indices[0]),
+			ARM_gsub_0, ARM_GPRPairRegClassID, loops);
+
+	return 0;
+}
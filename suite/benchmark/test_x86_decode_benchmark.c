@@ -0,0 +1,69 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// Measure how many X86-64 instructions per second the decoder handles.
+// Text rendering & detail are disabled, so this is dominated by the decoder
+// tables. Build Capstone with & without CAPSTONE_X86_FLAT_TABLES to compare.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+// typical compiler output: prologue, moves, arithmetic, SSE, calls & branches
+#define X86_CODE64 \
+	"\x55\x48\x89\xe5\x41\x57\x41\x56\x53\x48\x83\xec\x28\x48\x89\x7d\xc8\x89\x75\xc4" \
+	"\x48\x8b\x05\xb8\x13\x00\x00\x48\x8b\x00\x48\x89\x45\xe0\x31\xc0\x8b\x45\xc4\x48" \
+	"\x63\xd0\x48\x8d\x0c\x95\x00\x00\x00\x00\x48\x8b\x45\xc8\x48\x01\xc8\x8b\x00\x85" \
+	"\xc0\x74\x12\x0f\xb6\x45\xbf\x0f\xbe\xc0\x89\xc7\xe8\xdf\xbe\xad\xde\x66\x90\xf2" \
+	"\x0f\x10\x45\xd8\xf2\x0f\x59\xc1\xf2\x0f\x11\x45\xd0\x66\x0f\xef\xc0\x0f\x28\xc8" \
+	"\x48\x39\xd8\x0f\x8c\x70\xff\xff\xff\x4c\x8d\x3c\x24\x49\x8b\x3f\xff\x15\x23\x01" \
+	"\x00\x00\x48\x85\xc0\x0f\x95\xc0\x0f\xb6\xc0\x48\x83\xc4\x28\x5b\x41\x5e\x41\x5f" \
+	"\x5d\xc3\x0f\x1f\x44\x00\x00\xf3\xa4\x48\xc1\xe8\x03\x48\x0f\xaf\xc2\x0f\x44\xc1"
+
+#define DEFAULT_COUNT 10000000
+
+int main(int argc, char **argv)
+{
+	csh handle;
+	cs_insn *insn;
+	const uint8_t *code;
+	size_t size, count = 0, max_count = DEFAULT_COUNT;
+	uint64_t address;
+	clock_t start, end;
+	double seconds;
+	cs_err err;
+
+	if (argc > 1)
+		max_count = (size_t)strtoul(argv[1], NULL, 0);
+
+	err = cs_open(CS_ARCH_X86, CS_MODE_64, &handle);
+	if (err) {
+		printf("Failed on cs_open() with error returned: %u\n", err);
+		return 1;
+	}
+
+	cs_option(handle, CS_OPT_NO_TEXT, CS_OPT_ON);
+	insn = cs_malloc(handle);
+
+	start = clock();
+	while (count < max_count) {
+		code = (const uint8_t *)X86_CODE64;
+		size = sizeof(X86_CODE64) - 1;
+		address = 0x1000;
+		while (cs_disasm_iter(handle, &code, &size, &address, insn))
+			count++;
+	}
+	end = clock();
+
+	cs_free(insn, 1);
+	cs_close(&handle);
+
+	seconds = (double)(end - start) / CLOCKS_PER_SEC;
+	printf("%u instructions in %f s: %.0f instructions/s\n",
+			(unsigned int)count, seconds, seconds > 0 ? count / seconds : 0);
+
+	return 0;
+}
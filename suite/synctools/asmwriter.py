@@ -150,12 +150,11 @@ for line in lines:
         print_line(line)
     elif '::printAliasInstr' in line:
         if arch.upper() in ('AARCH64', 'PPC'):
-            print_line("static char *printAliasInstr(MCInst *MI, SStream *OS, MCRegisterInfo *MRI)\n{")
+            print_line("static const char *printAliasInstr(MCInst *MI, SStream *OS, MCRegisterInfo *MRI)\n{")
             print_line('  #define GETREGCLASS_CONTAIN(_class, _reg) MCRegisterClass_contains(MCRegisterInfo_getRegClass(MRI, _class), MCOperand_getReg(MCInst_getOperand(MI, _reg)))')
         else:
             print_line("static bool printAliasInstr(MCInst *MI, SStream *OS)\n{")
         print_line("  unsigned int I = 0, OpIdx, PrintMethodIdx;")
-        print_line("  char *tmpString;")
         in_printAliasInstr = True
     elif 'STI.getFeatureBits()[' in line:
         if arch.upper() == 'ARM':
@@ -631,14 +630,11 @@ for line in lines:
         print_line(line)
     elif 'unsigned I = 0;' in line and in_printAliasInstr:
         print_line("""
-  tmpString = cs_strdup(AsmString);
-
   while (AsmString[I] != ' ' && AsmString[I] != '\\t' &&
          AsmString[I] != '$' && AsmString[I] != '\\0')
     ++I;
 
-  tmpString[I] = 0;
-  SStream_concat0(OS, tmpString);
+  SStream_concatLen(OS, AsmString, I);
 
   if (AsmString[I] != '\\0') {
     if (AsmString[I] == ' ' || AsmString[I] == '\\t') {
@@ -662,7 +658,8 @@ for line in lines:
     } while (AsmString[I] != '\\0');
   }
 
-  return tmpString;
+  // the mnemonic is the first I characters of AsmString
+  return AsmString;
 }
         """)
         in_printAliasInstr = False
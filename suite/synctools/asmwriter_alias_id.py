@@ -0,0 +1,123 @@
+#!/usr/bin/python
+# put the public instruction ID of each alias next to its AsmString in
+# printAliasInstr() of GenAsmWriter.inc, so the printer does not need to
+# look up the alias mnemonic in the instruction name table at runtime.
+# NOTE: this updates GenAsmWriter.inc in place.
+# by Nguyen Anh Quynh, 2019
+
+import os
+import re
+import sys
+
+# public instruction enum: symbol of each value
+def read_enum(filename):
+    text = open(filename).read()
+    m = re.search(r'typedef enum \w+_insn \{(.*?)\}', text, re.S)
+    symbols = {}
+    value = -1
+    for line in m.group(1).split('\n'):
+        line = line.split('//')[0].strip()
+        e = re.match(r'(\w+)\s*(=\s*(\w+))?\s*,?$', line)
+        if e is None:
+            continue
+        if e.group(3) is not None:
+            value = int(e.group(3), 0)
+        else:
+            value += 1
+        symbols.setdefault(value, e.group(1))
+    return symbols
+
+# insn_name_maps[] of ARCHMapping.c, with #include expanded.
+# return list of (name, symbol-or-None), in order
+def read_names(filename):
+    lines = []
+    for line in open(filename):
+        inc = re.match(r'\s*#include "(\w+\.inc)"', line)
+        if inc:
+            lines.extend(open(os.path.join(os.path.dirname(filename), inc.group(1))).readlines())
+        else:
+            lines.append(line)
+
+    names = []
+    in_table = False
+    for line in lines:
+        if not in_table:
+            in_table = re.match(r'static const (name_map|char \* const) insn_name_maps\[\w*\] = \{', line) is not None
+            continue
+        if line.startswith('}'):
+            break
+        code = line.split('//')[0]
+        entry = re.match(r'\s*\{\s*(\w+),\s*("(.*)"|NULL)\s*\}', code)
+        if entry:
+            names.append((entry.group(3), entry.group(1)))
+            continue
+        entry = re.match(r'\s*("(.*)"|NULL),', code)
+        if entry:
+            names.append((entry.group(2), None))
+    return names
+
+# public ID symbol of each name, like the runtime lookup: first entry wins
+def read_ids(mapping, header):
+    symbols = read_enum(header)
+    names = read_names(mapping)
+    ids = {}
+    for i in range(len(names)):
+        name, symbol = names[i]
+        if name is not None and name not in ids:
+            ids[name] = symbol if symbol is not None else symbols[i]
+    return ids
+
+def mnemonic(asm, strip):
+    m = re.match(r'[^ \t$\\]*', asm).group(0)
+    if strip == 'suffix' and len(m) > 0 and m[-1] in '-+.':
+        m = m[:-1]
+    elif strip == 'comma':
+        m = m.split(',')[0]
+    return m
+
+def main():
+    if len(sys.argv) < 4:
+        print("Syntax: %s <GenAsmWriter.inc> <ARCHMapping.c> <capstone/arch.h> [strip]" %sys.argv[0])
+        print("        strip: 'suffix' to drop a last '-', '+' or '.' from mnemonics (PPC),")
+        print("               'comma' to drop anything from ',' in mnemonics (Sparc)")
+        sys.exit(1)
+
+    asmwriter, mapping, header = sys.argv[1:4]
+    strip = sys.argv[4] if len(sys.argv) > 4 else None
+
+    ids = read_ids(mapping, header)
+
+    f = open(asmwriter)
+    lines = f.readlines()
+    f.close()
+
+    out = []
+    in_alias = False
+    n = 0
+    for line in lines:
+        if re.match(r'static \w+ \*?printAliasInstr\(', line):
+            in_alias = True
+        elif line.startswith('}'):
+            in_alias = False
+
+        # drop ID of a previous run
+        if in_alias and re.match(r'\s*MCInst_setOpcodePub\(MI, \w+\); // alias ID$', line):
+            continue
+
+        out.append(line)
+
+        # aliases missing from the name table keep their internal ID
+        m = re.match(r'(\s*)AsmString = "(.*)";$', line)
+        if in_alias and m and mnemonic(m.group(2), strip) in ids:
+            out.append('%sMCInst_setOpcodePub(MI, %s); // alias ID\n' %(m.group(1),
+                ids[mnemonic(m.group(2), strip)]))
+            n += 1
+
+    f = open(asmwriter, 'w')
+    f.writelines(out)
+    f.close()
+
+    print("%s: %u aliases" %(asmwriter, n))
+
+if __name__ == '__main__':
+    main()
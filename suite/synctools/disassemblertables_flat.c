@@ -0,0 +1,114 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// this tool is to generate arch/X86/X86GenDisassemblerTablesFlat.inc,
+// used when Capstone is built with CAPSTONE_X86_FLAT_TABLES.
+// NOTE: this reads X86GenDisassemblerTables.inc & X86GenDisassemblerTables2.inc
+// from arch/X86/, so run it after these files are updated.
+//
+// The flat tables are direct-indexed by [insnContext][opcode] for the one-byte
+// & 0F maps, so decode() does not go through index_x86Disassembler*Opcodes.
+// Only the legacy contexts (IC .. IC_64BIT_REXW_OPSIZE) are covered, as
+// VEX/EVEX contexts are rare in real code, and would make the tables huge.
+// For MODRM_ONEENTRY decisions, the table keeps the instruction UID instead
+// of the index into modRMTable, which saves another lookup.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+
+#include "../../arch/X86/X86DisassemblerDecoder.h"
+
+#define ARR_SIZE(a) (sizeof(a) / sizeof(a[0]))
+
+// number of legacy contexts covered by the flat tables
+#define FLAT_CONTEXTS (IC_64BIT_REXW_OPSIZE + 1)
+
+struct ModRMDecision {
+	uint8_t modrm_type;
+	uint16_t instructionIDs;
+};
+
+struct OpcodeDecision {
+	struct ModRMDecision modRMDecisions[256];
+};
+
+#include "../../arch/X86/X86GenDisassemblerTables.inc"
+#include "../../arch/X86/X86GenDisassemblerTables2.inc"
+
+#define ENUM_ENTRY(n, r, d) #n,
+static const char *contextNames[] = {
+	INSTRUCTION_CONTEXTS
+};
+#undef ENUM_ENTRY
+
+static void flat_OpcodeDecision(const struct OpcodeDecision *decisions,
+		const unsigned char *index_table, const char *flatTable)
+{
+	static const struct OpcodeDecision emptyDecision;
+	unsigned int i, j;
+
+	printf("static const struct ModRMDecision %s[X86_FLAT_CONTEXTS][256] = {\n", flatTable);
+
+	for (i = 0; i < FLAT_CONTEXTS; i++) {
+		const struct OpcodeDecision *decision;
+
+		if (index_table[i])
+			decision = &decisions[index_table[i] - 1];
+		else
+			decision = &emptyDecision;
+
+		printf("  /* %s */\n", contextNames[i]);
+		printf("  {\n");
+
+		for (j = 0; j < ARR_SIZE(decision->modRMDecisions); j++) {
+			const struct ModRMDecision *dec = &decision->modRMDecisions[j];
+
+			switch(dec->modrm_type) {
+				default:
+					// resolve the UID now
+					printf("    { MODRM_ONEENTRY, %u },\n", modRMTable[dec->instructionIDs]);
+					break;
+				case MODRM_SPLITRM:
+					printf("    { MODRM_SPLITRM, %u },\n", dec->instructionIDs);
+					break;
+				case MODRM_SPLITMISC:
+					printf("    { MODRM_SPLITMISC, %u },\n", dec->instructionIDs);
+					break;
+				case MODRM_SPLITREG:
+					printf("    { MODRM_SPLITREG, %u },\n", dec->instructionIDs);
+					break;
+				case MODRM_FULL:
+					printf("    { MODRM_FULL, %u },\n", dec->instructionIDs);
+					break;
+			}
+		}
+
+		printf("  },\n");
+	}
+
+	printf("};\n\n");
+}
+
+int main(int argc, char **argv)
+{
+	printf("/* Capstone Disassembly Engine, http://www.capstone-engine.org */\n");
+	printf("/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */\n");
+	printf("\n");
+	printf("// generated by suite/synctools/disassemblertables_flat.c\n");
+	printf("\n");
+	printf("#define X86_FLAT_CONTEXTS %u\n", FLAT_CONTEXTS);
+	printf("\n");
+
+	flat_OpcodeDecision(x86DisassemblerOneByteOpcodes,
+			index_x86DisassemblerOneByteOpcodes,
+			"x86DisassemblerFlatOneByteOpcodes");
+
+	flat_OpcodeDecision(x86DisassemblerTwoByteOpcodes,
+			index_x86DisassemblerTwoByteOpcodes,
+			"x86DisassemblerFlatTwoByteOpcodes");
+
+	return 0;
+}
@@ -18,6 +18,7 @@ echo "Generating ${ARCH}MappingInsnName.inc"
 
 echo "Generating ${ARCH}MappingInsn.inc"
 ./mapping_insn-arch.py $1/${ARCH}GenAsmMatcher.inc $1/${ARCH}GenInstrInfo.inc $2/${ARCH}MappingInsn.inc > ${ARCH}MappingInsn.inc
+./mapping_insn_count.py ${ARCH}MappingInsn.inc > /dev/null
 
 echo "Generating ${ARCH}GenInstrInfo.inc"
 ./instrinfo-arch.py $1/${ARCH}GenInstrInfo.inc ${ARCH} > ${ARCH}GenInstrInfo.inc
@@ -45,6 +46,9 @@ case $3 in
   ./mapping_insn_op-arch.py $1/${ARCH}GenAsmMatcher.inc $1/${ARCH}GenInstrInfo.inc  $2/${ARCH}MappingInsnOp.inc > ${ARCH}MappingInsnOp.inc 
   echo "Generating ${ARCH}GenSystemRegister.inc"
   ./systemregister.py $1/${ARCH}GenSystemRegister.inc > ${ARCH}GenSystemRegister.inc
+  make arm
+  echo "Generating ${ARCH}GenSubRegTable.inc"
+  ./arm_gen_subreg > ${ARCH}GenSubRegTable.inc
   ;;
   AArch64)
   echo "Generating ${ARCH}GenSystemOperands.inc"
@@ -56,6 +60,8 @@ case $3 in
   echo "Generating ${ARCH}MappingInsnOp.inc"
   ./mapping_insn_op-arch.py $1/${ARCH}GenAsmMatcher.inc $1/${ARCH}GenInstrInfo.inc  $2/${ARCH}MappingInsnOp.inc > ${ARCH}MappingInsnOp.inc 
   make arm64
+  echo "Generating ${ARCH}GenSubRegTable.inc"
+  ./arm64_gen_subreg > ${ARCH}GenSubRegTable.inc
   ;;
   PowerPC)
   # PowerPC
@@ -68,3 +74,26 @@ case $3 in
   ;;
 esac
 
+
+# public ID of alias instructions, set in printAliasInstr()
+INCLUDE=$2/../../include/capstone
+case $3 in
+  AArch64)
+  ./asmwriter_alias_id.py ${ARCH}GenAsmWriter.inc $2/${ARCH}Mapping.c ${INCLUDE}/arm64.h
+  ;;
+  PowerPC)
+  ./asmwriter_alias_id.py ${ARCH}GenAsmWriter.inc $2/PPCMapping.c ${INCLUDE}/ppc.h suffix
+  # printAliasBcc() builds mnemonics at runtime, so PPC_map_insn() needs this
+  echo "Generating PPCMappingInsnNameIndex.inc"
+  ./mapping_insn_name_index.py $2/PPCMapping.c ${INCLUDE}/ppc.h > PPCMappingInsnNameIndex.inc
+  ;;
+  Mips)
+  ./asmwriter_alias_id.py ${ARCH}GenAsmWriter.inc $2/${ARCH}Mapping.c ${INCLUDE}/mips.h
+  # for hand-written aliases of printAlias()
+  echo "Generating ${ARCH}MappingInsnNameIndex.inc"
+  ./mapping_insn_name_index.py $2/${ARCH}Mapping.c ${INCLUDE}/mips.h > ${ARCH}MappingInsnNameIndex.inc
+  ;;
+  Sparc)
+  ./asmwriter_alias_id.py ${ARCH}GenAsmWriter.inc $2/${ARCH}Mapping.c ${INCLUDE}/sparc.h comma
+  ;;
+esac
@@ -20,6 +20,7 @@ echo "Generating MappingInsnName.inc"
 
 echo "Generating MappingInsn.inc"
 ./mapping_insn.py $1/X86GenAsmMatcher.inc $1/X86GenInstrInfo.inc $2/X86MappingInsn.inc > X86MappingInsn.inc
+./mapping_insn_count.py X86MappingInsn.inc > /dev/null
 
 echo "Generating MappingInsnOp.inc"
 ./mapping_insn_op.py $1/X86GenAsmMatcher.inc $1/X86GenInstrInfo.inc  $2/X86MappingInsnOp.inc > X86MappingInsnOp.inc 
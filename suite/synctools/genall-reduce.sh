@@ -16,6 +16,7 @@ echo "Generating MappingInsnName_reduce.inc"
 
 echo "Generating MappingInsn_reduce.inc"
 ./mapping_insn.py $1/X86GenAsmMatcher_reduce.inc $1/X86GenInstrInfo_reduce.inc $2/X86MappingInsn_reduce.inc > X86MappingInsn_reduce.inc
+./mapping_insn_count.py X86MappingInsn_reduce.inc > /dev/null
 
 echo "Generating MappingInsnOp_reduce.inc"
 ./mapping_insn_op.py $1/X86GenAsmMatcher.inc $1/X86GenInstrInfo_reduce.inc  $2/X86MappingInsnOp_reduce.inc > X86MappingInsnOp_reduce.inc 
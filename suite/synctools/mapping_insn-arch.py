@@ -161,7 +161,7 @@ def print_entry(arch, insn_id, mnem, mapping, mnem_can_be_wrong):
 {
 \t%s, %s_INS_%s,
 #ifndef CAPSTONE_DIET
-\t{ 0 }, { 0 }, { 0 }, 0, 0
+\t{ 0 }, { 0 }, { 0 }, 0, 0, 0, 0, 0
 #endif
 },'''% (insn, arch1, mnem))
 
@@ -140,7 +140,7 @@ def print_entry(arch, insn_id, mnem, mapping, mnem_can_be_wrong):
 {
 \t%s_%s, %s_INS_%s, %s,
 #ifndef CAPSTONE_DIET
-\t{ 0 }, { 0 }, { 0 }, 0, 0
+\t{ 0 }, { 0 }, { 0 }, 0, 0, 0, 0, 0
 #endif
 },'''% (arch, insn_id, arch, mnem, is64bit))
 
@@ -0,0 +1,49 @@
+#!/usr/bin/python
+# append (or refresh) the number of implicit registers read & written, and the
+# number of groups, to every entry of MappingInsn.inc files, so the mapping code
+# does not need to count them for each instruction.
+# NOTE: this updates the files in place.
+# by Nguyen Anh Quynh, 2019
+
+import re
+import sys
+
+if len(sys.argv) == 1:
+    print("Syntax: %s <MappingInsn.inc> ..." %sys.argv[0])
+    sys.exit(1)
+
+#        { 0 }, { X86_REG_EFLAGS, 0 }, { X86_GRP_NOT64BITMODE, 0 }, 0, 0
+# -->
+#        { 0 }, { X86_REG_EFLAGS, 0 }, { X86_GRP_NOT64BITMODE, 0 }, 0, 0, 0, 1, 1
+entry = re.compile(r'^(\s*)\{([^}]*)\}, \{([^}]*)\}, \{([^}]*)\}, (\w+), (\w+)(, \d+, \d+, \d+)?\s*$')
+
+# count members of a list, up to its terminating 0
+def count(members):
+    c = 0
+    for m in members.split(','):
+        m = m.strip()
+        if m == '' or m == '0':
+            break
+        c += 1
+    return c
+
+for filename in sys.argv[1:]:
+    f = open(filename)
+    lines = f.readlines()
+    f.close()
+
+    n = 0
+    for i in range(len(lines)):
+        m = entry.match(lines[i])
+        if m is None:
+            continue
+        lines[i] = '%s{%s}, {%s}, {%s}, %s, %s, %u, %u, %u\n' %(m.group(1),
+                m.group(2), m.group(3), m.group(4), m.group(5), m.group(6),
+                count(m.group(2)), count(m.group(3)), count(m.group(4)))
+        n += 1
+
+    f = open(filename, 'w')
+    f.writelines(lines)
+    f.close()
+
+    print("%s: %u entries" %(filename, n))
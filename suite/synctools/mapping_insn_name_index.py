@@ -0,0 +1,25 @@
+#!/usr/bin/python
+# print insn_name_maps[] of ARCHMapping.c as name_map entries sorted by name,
+# so an instruction name can be mapped to its public ID with binary search.
+# by Nguyen Anh Quynh, 2019
+
+import sys
+
+from asmwriter_alias_id import read_ids
+
+if len(sys.argv) != 3:
+    print("Syntax: %s <ARCHMapping.c> <capstone/arch.h>" %sys.argv[0])
+    sys.exit(1)
+
+ids = read_ids(sys.argv[1], sys.argv[2])
+
+print("/* Capstone Disassembly Engine, http://www.capstone-engine.org */")
+print("/* This is auto-gen data for Capstone disassembly engine (www.capstone-engine.org) */")
+print("/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */")
+print("")
+print("// instruction names, sorted by name (strcmp order)")
+print("")
+
+# sort by bytes, like strcmp()
+for name in sorted(ids, key=lambda n: n.encode('utf-8')):
+    print('\t{ %s, "%s" },' %(ids[name], name))
@@ -0,0 +1,141 @@
+// generate tables of sub-registers & super-registers, indexed by register,
+// for the sub-register indices the printer of an arch looks up.
+// $ make arm64
+// $ ./arm64_gen_subreg > AArch64GenSubRegTable.inc
+// $ make arm
+// $ ./arm_gen_subreg > ARMGenSubRegTable.inc
+
+#include <stdio.h>
+
+#include "../../MCRegisterInfo.c"
+
+#define GET_REGINFO_ENUM
+#define GET_REGINFO_MC_DESC
+
+typedef struct sub_index {
+	unsigned Idx;
+	const char *name;
+	bool super;	// also generate super-registers for this index?
+} sub_index;
+
+#ifdef GEN_AARCH64
+#include "AArch64GenRegisterInfo.inc"
+
+#define ARCH "AArch64"
+#define REG_DESC AArch64RegDesc
+#define REG_DIFFLISTS AArch64RegDiffLists
+#define SUBREG_IDXLISTS AArch64SubRegIdxLists
+#define NUM_SUBREG_INDICES (AArch64_NUM_TARGET_SUBREGS)
+#define IDX(i, super) { AArch64_##i, #i, super }
+
+static const sub_index indices[] = {
+	IDX(dsub, true),
+	IDX(dsub0, false),
+	IDX(qsub0, false),
+	IDX(zsub0, false),
+	IDX(sube32, false),
+	IDX(subo32, false),
+	IDX(sube64, false),
+	IDX(subo64, false),
+};
+#endif
+
+#ifdef GEN_ARM
+#include "ARMGenRegisterInfo.inc"
+
+#define ARCH "ARM"
+#define REG_DESC ARMRegDesc
+#define REG_DIFFLISTS ARMRegDiffLists
+#define SUBREG_IDXLISTS ARMSubRegIdxLists
+#define NUM_SUBREG_INDICES (ARM_NUM_TARGET_SUBREGS)
+#define IDX(i, super) { ARM_##i, #i, super }
+
+static const sub_index indices[] = {
+	IDX(gsub_0, true),
+	IDX(gsub_1, false),
+	IDX(dsub_0, false),
+	IDX(dsub_1, false),
+};
+#endif
+
+#define NUM_REGS (sizeof(REG_DESC) / sizeof(REG_DESC[0]))
+
+// first super-register of @Reg whose @Idx sub-register is @Reg, in any class
+static unsigned getSuperReg(const MCRegisterInfo *RI, unsigned Reg, unsigned Idx)
+{
+	DiffListIterator iter;
+
+	DiffListIterator_init(&iter, (MCPhysReg)Reg, RI->DiffLists + RI->Desc[Reg].SuperRegs);
+	DiffListIterator_next(&iter);
+
+	while(DiffListIterator_isValid(&iter)) {
+		uint16_t val = DiffListIterator_getVal(&iter);
+		if (Reg == MCRegisterInfo_getSubReg(RI, val, Idx))
+			return val;
+
+		DiffListIterator_next(&iter);
+	}
+
+	return 0;
+}
+
+static void print_table(const char *kind, const char *name, const MCRegisterInfo *RI,
+		unsigned Idx, unsigned (*lookup)(const MCRegisterInfo *, unsigned, unsigned))
+{
+	unsigned Reg;
+
+	printf("static const MCPhysReg %s%sRegs_%s[] = {\n", ARCH, kind, name);
+	for (Reg = 0; Reg < NUM_REGS; Reg++) {
+		if (Reg % 16 == 0)
+			printf("\t");
+		// NoRegister has no sub-registers nor super-registers
+		printf("%u,", Reg ? lookup(RI, Reg, Idx) : 0);
+		printf(Reg % 16 == 15 || Reg == NUM_REGS - 1 ? "\n" : " ");
+	}
+	printf("};\n\n");
+}
+
+static void print_index(const char *kind, bool super)
+{
+	unsigned Idx, i;
+
+	printf("static const MCPhysReg *const %s%sRegTable[] = {\n", ARCH, kind);
+	for (Idx = 0; Idx < NUM_SUBREG_INDICES; Idx++) {
+		for (i = 0; i < sizeof(indices) / sizeof(indices[0]); i++) {
+			if (indices[i].Idx == Idx && (!super || indices[i].super))
+				break;
+		}
+
+		if (i < sizeof(indices) / sizeof(indices[0]))
+			printf("\t%s%sRegs_%s,\n", ARCH, kind, indices[i].name);
+		else
+			printf("\tNULL,\n");
+	}
+	printf("};\n\n");
+}
+
+int main()
+{
+	MCRegisterInfo RI;
+	unsigned i;
+
+	MCRegisterInfo_InitMCRegisterInfo(&RI, REG_DESC, NUM_REGS, 0, 0,
+			NULL, 0, 0, 0, REG_DIFFLISTS, 0,
+			SUBREG_IDXLISTS, NUM_SUBREG_INDICES, 0);
+
+	printf("/* Capstone Disassembly Engine, http://www.capstone-engine.org */\n");
+	printf("/* This is auto-gen data for Capstone disassembly engine (www.capstone-engine.org) */\n");
+	printf("/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */\n\n");
+
+	for (i = 0; i < sizeof(indices) / sizeof(indices[0]); i++) {
+		print_table("Sub", indices[i].name, &RI, indices[i].Idx, MCRegisterInfo_getSubReg);
+		if (indices[i].super)
+			print_table("Super", indices[i].name, &RI, indices[i].Idx, getSuperReg);
+	}
+
+	// indexed by sub-register index
+	print_index("Sub", false);
+	print_index("Super", true);
+
+	return 0;
+}
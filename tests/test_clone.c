@@ -0,0 +1,145 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// This sample code demonstrates the API cs_clone(), which copies a handle
+// together with all of its options.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	unsigned char *code;
+	size_t size;
+	const char *comment;
+	cs_opt_type opt_type;
+	cs_opt_value opt_value;
+};
+
+// code ends with some data, which needs SKIPDATA
+#define X86_CODE32 "\x8d\x4c\x32\x08\x01\xd8\x81\xc6\x34\x12\x00\x00\x75\x01\x00\x91\x92\xc6\xd6"
+#define ARM_CODE "\xED\xFF\xFF\xEB\x04\xe0\x2d\xe5\x00\x00\x00\x00\xe0\x83\x22\xe5\xf1\x02\x03\x0e\x00\x00\xa0\xe3\x02\x30\xc1\xe7\x00\x00\x53\xe3\xff\xff"
+#define PPC_CODE "\x80\x20\x00\x00\x80\x3f\x00\x00\x10\x43\x23\x0e\xd0\x44\x00\x80\x4c\x43\x22\x02\x2d\x03\x00\x80\x7c\x43\x20\x14\x7c\x43\x20\x93\x4f\x20\x00\x21\x4c\xc8\x00\x21"
+
+static struct platform platforms[] = {
+#ifdef CAPSTONE_HAS_X86
+	{
+		CS_ARCH_X86,
+		CS_MODE_32,
+		(unsigned char *)X86_CODE32,
+		sizeof(X86_CODE32) - 1,
+		"X86 32 (AT&T syntax)",
+		CS_OPT_SYNTAX,
+		CS_OPT_SYNTAX_ATT,
+	},
+#endif
+#ifdef CAPSTONE_HAS_ARM
+	{
+		CS_ARCH_ARM,
+		CS_MODE_ARM,
+		(unsigned char *)ARM_CODE,
+		sizeof(ARM_CODE) - 1,
+		"ARM (no register name)",
+		CS_OPT_SYNTAX,
+		CS_OPT_SYNTAX_NOREGNAME,
+	},
+#endif
+#ifdef CAPSTONE_HAS_POWERPC
+	{
+		CS_ARCH_PPC,
+		CS_MODE_BIG_ENDIAN,
+		(unsigned char *)PPC_CODE,
+		sizeof(PPC_CODE) - 1,
+		"PPC-64 (unsigned immediate)",
+		CS_OPT_UNSIGNED,
+		CS_OPT_ON,
+	},
+#endif
+};
+
+static void print_insn(cs_insn *insn, size_t count)
+{
+	size_t i;
+
+	for (i = 0; i < count; i++)
+		printf("0x%" PRIx64 ":\t%s\t%s\n", insn[i].address, insn[i].mnemonic, insn[i].op_str);
+}
+
+static void test()
+{
+	csh handle, clone;
+	cs_insn *insn, *expected;
+	size_t count, expected_count, i;
+	cs_opt_mnem mnem;
+	int j;
+	cs_err err;
+
+	for (j = 0; j < sizeof(platforms)/sizeof(platforms[0]); j++) {
+		printf("****************\n");
+		printf("Platform: %s\n", platforms[j].comment);
+
+		err = cs_open(platforms[j].arch, platforms[j].mode, &handle);
+		if (err) {
+			printf("Failed on cs_open() with error returned: %u\n", err);
+			abort();
+		}
+
+		cs_option(handle, platforms[j].opt_type, platforms[j].opt_value);
+		cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+		cs_option(handle, CS_OPT_SKIPDATA, CS_OPT_ON);
+
+		// customize the mnemonic of the first instruction
+		expected_count = cs_disasm(handle, platforms[j].code, platforms[j].size, 0x1000, 1, &expected);
+		mnem.id = expected[0].id;
+		mnem.mnemonic = "first";
+		cs_option(handle, CS_OPT_MNEMONIC, (size_t)&mnem);
+		cs_free(expected, expected_count);
+
+		expected_count = cs_disasm(handle, platforms[j].code, platforms[j].size, 0x1000, 0, &expected);
+
+		err = cs_clone(handle, &clone);
+		if (err) {
+			printf("Failed on cs_clone() with error returned: %u\n", err);
+			abort();
+		}
+
+		// the clone is independent of the original handle
+		cs_close(&handle);
+
+		count = cs_disasm(clone, platforms[j].code, platforms[j].size, 0x1000, 0, &insn);
+		print_insn(insn, count);
+
+		if (count != expected_count) {
+			printf("ERROR: cs_clone() handle returned %u instructions, expected %u\n",
+					(unsigned int)count, (unsigned int)expected_count);
+			abort();
+		}
+
+		for (i = 0; i < count; i++) {
+			if (insn[i].id != expected[i].id ||
+					strcmp(insn[i].mnemonic, expected[i].mnemonic) ||
+					strcmp(insn[i].op_str, expected[i].op_str) ||
+					(insn[i].detail == NULL) != (expected[i].detail == NULL)) {
+				printf("ERROR: cs_clone() handle differs from the original handle\n");
+				abort();
+			}
+		}
+		printf("\n");
+
+		cs_free(insn, count);
+		cs_free(expected, expected_count);
+		cs_close(&clone);
+	}
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
@@ -0,0 +1,183 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// This sample code demonstrates the API cs_disasm_columns(), which puts
+// instructions into columns (one array per field) with a single allocation:
+// addresses, sizes, IDs, group bitsets, text & packed operands.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	unsigned char *code;
+	size_t size;
+	const char *comment;
+};
+
+#define X86_CODE64 "\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff\x48\x8b\x44\x8b\x10"
+#define ARM_CODE "\xED\xFF\xFF\xEB\x04\xe0\x2d\xe5\x00\x00\x00\x00\xe0\x83\x22\xe5\xf1\x02\x03\x0e\x00\x00\xa0\xe3\x02\x30\xc1\xe7\x00\x00\x53\xe3"
+#define ARM64_CODE "\x21\x7c\x02\x9b\x21\x7c\x00\x53\x00\x40\x21\x4b\xe1\x0b\x40\xb9\x20\x04\x81\xda\x20\x08\x02\x8b"
+#define RISCV_CODE "\x37\x34\x00\x00\x97\x82\x00\x00\xef\x00\x80\x00\x03\x88\x18\x00\x23\x86\xad\x03\x13\x04\xa8\x7a"
+
+static struct platform platforms[] = {
+#ifdef CAPSTONE_HAS_X86
+	{
+		CS_ARCH_X86,
+		CS_MODE_64,
+		(unsigned char *)X86_CODE64,
+		sizeof(X86_CODE64) - 1,
+		"X86 64"
+	},
+#endif
+#ifdef CAPSTONE_HAS_ARM
+	{
+		CS_ARCH_ARM,
+		CS_MODE_ARM,
+		(unsigned char *)ARM_CODE,
+		sizeof(ARM_CODE) - 1,
+		"ARM"
+	},
+#endif
+#ifdef CAPSTONE_HAS_ARM64
+	{
+		CS_ARCH_ARM64,
+		CS_MODE_ARM,
+		(unsigned char *)ARM64_CODE,
+		sizeof(ARM64_CODE) - 1,
+		"ARM-64"
+	},
+#endif
+#ifdef CAPSTONE_HAS_RISCV
+	{
+		CS_ARCH_RISCV,
+		CS_MODE_RISCV64,
+		(unsigned char *)RISCV_CODE,
+		sizeof(RISCV_CODE) - 1,
+		"riscv64"
+	},
+#endif
+};
+
+// does instruction @i of @cols belong to group @group?
+static bool column_group(const cs_columns *cols, size_t i, unsigned int group)
+{
+	return (cols->groups[i * CS_COLUMN_GROUP_WORDS + group / 64] >> (group % 64)) & 1;
+}
+
+static void print_columns(csh handle, const cs_columns *cols, const cs_insn *insn)
+{
+	size_t i;
+	unsigned int group;
+	uint32_t j;
+
+	for (i = 0; i < cols->count; i++) {
+		printf("0x%" PRIx64 ":\t%u bytes\t%s\t%s\n", cols->address[i], cols->size[i],
+				cols->text + cols->mnemonic[i], cols->text + cols->op_str[i]);
+
+		if (cols->address[i] != insn[i].address || cols->size[i] != insn[i].size ||
+				cols->id[i] != insn[i].id ||
+				strcmp(cols->text + cols->mnemonic[i], insn[i].mnemonic) ||
+				strcmp(cols->text + cols->op_str[i], insn[i].op_str) ||
+				cols->op_count[i] != cols->op_first[i + 1] - cols->op_first[i] ||
+				cols->op_count[i] != cs_detail_op_count(handle, &insn[i])) {
+			printf("ERROR: columns do not match cs_disasm()\n");
+			abort();
+		}
+
+		for (j = cols->op_first[i]; j < cols->op_first[i + 1]; j++) {
+			printf("\t\top[%u]: type %u", j - cols->op_first[i], cols->op_type[j]);
+			if (cols->op_reg[j])
+				printf(", reg %s", cs_reg_name(handle, cols->op_reg[j]));
+			if (cols->op_mem_index[j])
+				printf(", index %s", cs_reg_name(handle, cols->op_mem_index[j]));
+			if (cols->op_imm[j])
+				printf(", imm 0x%" PRIx64, cols->op_imm[j]);
+			if (cols->op_access[j] & CS_AC_READ)
+				printf(", read");
+			if (cols->op_access[j] & CS_AC_WRITE)
+				printf(", write");
+			printf("\n");
+		}
+
+		printf("\t\tgroups:");
+		for (group = 1; group < 256; group++) {
+			if (column_group(cols, i, group) != cs_insn_group(handle, &insn[i], group)) {
+				printf("ERROR: wrong group bitset\n");
+				abort();
+			}
+			if (column_group(cols, i, group))
+				printf(" %s", cs_group_name(handle, group));
+		}
+		printf("\n");
+	}
+	printf("\n");
+}
+
+static void test()
+{
+	csh handle;
+	cs_insn *insn;
+	cs_columns *cols;
+	size_t count, n;
+	int i;
+	cs_err err;
+
+	for (i = 0; i < sizeof(platforms)/sizeof(platforms[0]); i++) {
+		printf("****************\n");
+		printf("Platform: %s\n", platforms[i].comment);
+
+		err = cs_open(platforms[i].arch, platforms[i].mode, &handle);
+		if (err) {
+			printf("Failed on cs_open() with error returned: %u\n", err);
+			abort();
+		}
+
+		cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+		// reference output from cs_disasm()
+		count = cs_disasm(handle, platforms[i].code, platforms[i].size, 0x1000, 0, &insn);
+
+		n = cs_disasm_columns(handle, platforms[i].code, platforms[i].size, 0x1000, 0, &cols);
+		if (!n || n != count || cols->count != count) {
+			printf("ERROR: cs_disasm_columns() found %u instructions, expected %u\n",
+					(unsigned int)n, (unsigned int)count);
+			abort();
+		}
+
+		print_columns(handle, cols, insn);
+
+		cs_free_columns(cols);
+
+		// without text, the text columns are left out
+		cs_option(handle, CS_OPT_NO_TEXT, CS_OPT_ON);
+
+		n = cs_disasm_columns(handle, platforms[i].code, platforms[i].size, 0x1000, 0, &cols);
+		if (n != count || cols->text || cols->mnemonic || cols->op_total == 0) {
+			printf("ERROR: wrong columns with CS_OPT_NO_TEXT\n");
+			abort();
+		}
+
+		cs_free_columns(cols);
+		cs_free(insn, count);
+		cs_close(&handle);
+	}
+}
+
+int main()
+{
+	if (cs_support(CS_SUPPORT_DIET)) {
+		// there are no text columns to compare in diet mode
+		printf("Skipped in diet mode\n");
+		return 0;
+	}
+
+	test();
+
+	return 0;
+}
@@ -0,0 +1,160 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// This sample code demonstrates the option CS_OPT_COMPACT_DETAIL, which sizes
+// the detail of each instruction to what its architecture & operands use.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	unsigned char *code;
+	size_t size;
+	const char *comment;
+};
+
+#define X86_CODE64 "\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff"
+#define ARM_CODE "\xED\xFF\xFF\xEB\x04\xe0\x2d\xe5\x00\x00\x00\x00\xe0\x83\x22\xe5\xf1\x02\x03\x0e\x00\x00\xa0\xe3\x02\x30\xc1\xe7\x00\x00\x53\xe3"
+#define MIPS_CODE "\x0C\x10\x00\x97\x00\x00\x00\x00\x24\x02\x00\x0c\x8f\xa2\x00\x00\x34\x21\x34\x56"
+#define EVM_CODE "\x60\x61\x50"
+#define EBPF_CODE "\x97\x09\x00\x00\x37\x13\x03\x00\xdc\x02\x00\x00\x20\x00\x00\x00\x30\x00\x00\x00\x00\x00\x00\x00"
+
+static struct platform platforms[] = {
+#ifdef CAPSTONE_HAS_X86
+	{
+		CS_ARCH_X86,
+		CS_MODE_64,
+		(unsigned char *)X86_CODE64,
+		sizeof(X86_CODE64) - 1,
+		"X86 64 (Intel syntax)"
+	},
+#endif
+#ifdef CAPSTONE_HAS_ARM
+	{
+		CS_ARCH_ARM,
+		CS_MODE_ARM,
+		(unsigned char *)ARM_CODE,
+		sizeof(ARM_CODE) - 1,
+		"ARM"
+	},
+#endif
+#ifdef CAPSTONE_HAS_MIPS
+	{
+		CS_ARCH_MIPS,
+		(cs_mode)(CS_MODE_MIPS32 + CS_MODE_BIG_ENDIAN),
+		(unsigned char *)MIPS_CODE,
+		sizeof(MIPS_CODE) - 1,
+		"MIPS-32 (Big-endian)"
+	},
+#endif
+#ifdef CAPSTONE_HAS_EVM
+	{
+		CS_ARCH_EVM,
+		0,
+		(unsigned char *)EVM_CODE,
+		sizeof(EVM_CODE) - 1,
+		"EVM"
+	},
+#endif
+#ifdef CAPSTONE_HAS_BPF
+	{
+		CS_ARCH_BPF,
+		(cs_mode)(CS_MODE_LITTLE_ENDIAN | CS_MODE_BPF_EXTENDED),
+		(unsigned char *)EBPF_CODE,
+		sizeof(EBPF_CODE) - 1,
+		"eBPF"
+	},
+#endif
+};
+
+// verify that compact detail of @insn has the same content as full detail of @ref
+static void check_detail(csh handle, cs_insn *insn, cs_insn *ref)
+{
+	cs_detail *d = insn->detail, *r = ref->detail;
+	unsigned int op_type;
+
+	if (d->regs_read_count != r->regs_read_count ||
+			d->regs_write_count != r->regs_write_count ||
+			d->groups_count != r->groups_count ||
+			memcmp(d->regs_read, r->regs_read, d->regs_read_count * sizeof(d->regs_read[0])) ||
+			memcmp(d->regs_write, r->regs_write, d->regs_write_count * sizeof(d->regs_write[0])) ||
+			memcmp(d->groups, r->groups, d->groups_count) ||
+			cs_detail_op_count(handle, insn) != cs_detail_op_count(handle, ref)) {
+		printf("ERROR: compact detail differs from full detail\n");
+		abort();
+	}
+
+	for (op_type = CS_OP_REG; op_type <= CS_OP_FP; op_type++) {
+		if (cs_op_count(handle, insn, op_type) != cs_op_count(handle, ref, op_type)) {
+			printf("ERROR: compact detail has different operands\n");
+			abort();
+		}
+	}
+}
+
+static void test()
+{
+	csh handle;
+	cs_insn *insn, *full;
+	size_t count, full_count, i, size;
+	int j;
+	cs_err err;
+
+	for (j = 0; j < sizeof(platforms)/sizeof(platforms[0]); j++) {
+		printf("****************\n");
+		printf("Platform: %s\n", platforms[j].comment);
+
+		err = cs_open(platforms[j].arch, platforms[j].mode, &handle);
+		if (err) {
+			printf("Failed on cs_open() with error returned: %u\n", err);
+			abort();
+		}
+
+		cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+		// reference output, with full detail
+		full_count = cs_disasm(handle, platforms[j].code, platforms[j].size, 0x1000, 0, &full);
+
+		cs_option(handle, CS_OPT_COMPACT_DETAIL, CS_OPT_ON);
+		count = cs_disasm(handle, platforms[j].code, platforms[j].size, 0x1000, 0, &insn);
+
+		if (count != full_count) {
+			printf("ERROR: CS_OPT_COMPACT_DETAIL changed the number of instructions\n");
+			abort();
+		}
+
+		for (i = 0; i < count; i++) {
+			size = cs_detail_size(handle, &insn[i]);
+
+			printf("0x%" PRIx64 ":\t%s\t%s\t// %d operands, detail: %u bytes\n",
+					insn[i].address, insn[i].mnemonic, insn[i].op_str,
+					cs_detail_op_count(handle, &insn[i]), (unsigned int)size);
+
+			if (size == 0 || size > sizeof(cs_detail) ||
+					size != cs_detail_size(handle, &full[i])) {
+				printf("ERROR: wrong size of compact detail\n");
+				abort();
+			}
+
+			check_detail(handle, &insn[i], &full[i]);
+		}
+		printf("\n");
+
+		cs_free(insn, count);
+		cs_free(full, full_count);
+		cs_close(&handle);
+	}
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
@@ -77,6 +77,13 @@ static void test()
 	// 3. Now print out the instruction in default setup.
 	print_insn(handle);
 
+	// IDs that are not X86 instructions cannot be customized
+	my_mnem.id = X86_INS_ENDING;
+	if (cs_option(handle, CS_OPT_MNEMONIC, (size_t)&my_mnem) != CS_ERR_OPTION) {
+		printf("ERROR: customized mnemonic of invalid instruction\n");
+		abort();
+	}
+
 	// Done
 	cs_close(&handle);
 }
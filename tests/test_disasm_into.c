@@ -0,0 +1,125 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// This sample code demonstrates the API cs_disasm_into(), which disassembles
+// into caller-owned arrays of cs_insn & cs_detail without allocating memory.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	unsigned char *code;
+	size_t size;
+	const char *comment;
+};
+
+// number of instructions decoded per call: keep this small to show resuming
+#define BATCH 4
+
+#define X86_CODE32 "\x8d\x4c\x32\x08\x01\xd8\x81\xc6\x34\x12\x00\x00\x05\x23\x01\x00\x00\x36\x8b\x84\x91\x23\x01\x00\x00\x41\x8d\x84\x39\x89\x67\x00\x00\x8d\x87\x89\x67\x00\x00\xb4\xc6"
+#define ARM64_CODE "\x09\x00\x38\xd5\xbf\x40\x00\xd5\x0c\x05\x13\xd5\x20\x50\x02\x0e\x20\xe4\x3d\x0f\x00\x18\xa0\x5f\xa2\x00\xae\x9e\x9f\x37\x03\xd5\xbf\x33\x03\xd5\xdf\x3f\x03\xd5\x21\x7c\x02\x9b"
+#define MIPS_CODE "\x0C\x10\x00\x97\x00\x00\x00\x00\x24\x02\x00\x0c\x8f\xa2\x00\x00\x34\x21\x34\x56"
+
+static struct platform platforms[] = {
+#ifdef CAPSTONE_HAS_X86
+	{
+		CS_ARCH_X86,
+		CS_MODE_32,
+		(unsigned char *)X86_CODE32,
+		sizeof(X86_CODE32) - 1,
+		"X86 32 (Intel syntax)"
+	},
+#endif
+#ifdef CAPSTONE_HAS_ARM64
+	{
+		CS_ARCH_ARM64,
+		CS_MODE_ARM,
+		(unsigned char *)ARM64_CODE,
+		sizeof(ARM64_CODE) - 1,
+		"ARM-64"
+	},
+#endif
+#ifdef CAPSTONE_HAS_MIPS
+	{
+		CS_ARCH_MIPS,
+		(cs_mode)(CS_MODE_MIPS32 + CS_MODE_BIG_ENDIAN),
+		(unsigned char *)MIPS_CODE,
+		sizeof(MIPS_CODE) - 1,
+		"MIPS-32 (Big-endian)"
+	},
+#endif
+};
+
+static void test()
+{
+	csh handle;
+	cs_insn insn[BATCH], *expected;
+	cs_detail detail[BATCH];
+	const uint8_t *code;
+	size_t size, count, n, i, total;
+	uint64_t address;
+	int j;
+	cs_err err;
+
+	for (j = 0; j < sizeof(platforms)/sizeof(platforms[0]); j++) {
+		printf("****************\n");
+		printf("Platform: %s\n", platforms[j].comment);
+
+		err = cs_open(platforms[j].arch, platforms[j].mode, &handle);
+		if (err) {
+			printf("Failed on cs_open() with error returned: %u\n", err);
+			abort();
+		}
+
+		cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+		// reference output from cs_disasm()
+		count = cs_disasm(handle, platforms[j].code, platforms[j].size, 0x1000, 0, &expected);
+
+		code = platforms[j].code;
+		size = platforms[j].size;
+		address = 0x1000;
+		total = 0;
+
+		// keep decoding BATCH instructions at a time, reusing the same arrays
+		while ((n = cs_disasm_into(handle, &code, &size, &address, insn, detail, BATCH)) > 0) {
+			for (i = 0; i < n; i++, total++) {
+				printf("0x%" PRIx64 ":\t%s\t%s\t// operand regs read: %u, write: %u\n",
+						insn[i].address, insn[i].mnemonic, insn[i].op_str,
+						insn[i].detail->regs_read_count, insn[i].detail->regs_write_count);
+
+				if (total >= count || insn[i].address != expected[total].address ||
+						insn[i].id != expected[total].id ||
+						strcmp(insn[i].mnemonic, expected[total].mnemonic) ||
+						strcmp(insn[i].op_str, expected[total].op_str)) {
+					printf("ERROR: cs_disasm_into() differs from cs_disasm()\n");
+					abort();
+				}
+			}
+		}
+
+		if (total != count) {
+			printf("ERROR: cs_disasm_into() returned %u instructions, expected %u\n",
+					(unsigned int)total, (unsigned int)count);
+			abort();
+		}
+
+		printf("0x%" PRIx64 ":\n\n", address);
+
+		cs_free(expected, count);
+		cs_close(&handle);
+	}
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
@@ -0,0 +1,149 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// This sample code demonstrates the APIs cs_insn_length() & cs_insn_lengths(),
+// which find instruction boundaries without building cs_insn, with detail
+// off & on.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	unsigned char *code;
+	size_t size;
+	const char *comment;
+};
+
+#define MAX_INSNS 64
+
+#define X86_CODE64 "\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff\x66\x0f\x3a\x0f\xc1\x08\xc4\xe2\x79\x18\x05\x00\x00\x00\x00\xf0\x48\x0f\xb1\x0a\x0f\x0b"
+#define THUMB_CODE "\x70\x47\xeb\x46\x83\xb0\xc9\x68\x1f\xb1\x30\xbf\xaf\xf3\x20\x84\x52\xf8\x23\xf0"
+#define EVM_CODE "\x60\x80\x60\x40\x52\x34\x80\x15\x61\x00\x10\x57\x73\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10\x11\x12\x13\x14\x5b\x00\xf3\x61\xaa"
+#define WASM_CODE "\x20\x00\x20\x01\x41\x20\x10\xc9\x01\x45\x0b\x02\x40\x28\x02\x10\x0e\x02\x00\x81\x01\x02\x44\x00\x00\x00\x00\x00\x00\xf0\x3f\x42\x80\x80\x04"
+#define RISCV_CODE32 "\x37\x34\x00\x00\xef\x00\x80\x00\x03\x88\x18\x00\x03\x99\x49\x00\x23\x86\xad\x03\x23\x9a\xce\x03\x13\xa1\x01\x01\xb3\x0a\x7b\x41"
+#define M680X_CODE "\x06\x10\x19\x1a\x55\x1e\x01\x23\xe9\x31\x06\x34\x55\xa6\x81\xa7\x89\x7f\xff\xa6\x9d\x10\x00\xa7\x91\xa6\x9f\x10\x00\x11\xac\x99\x10\x00\x39"
+
+static struct platform platforms[] = {
+#ifdef CAPSTONE_HAS_X86
+	{
+		CS_ARCH_X86,
+		CS_MODE_64,
+		(unsigned char *)X86_CODE64,
+		sizeof(X86_CODE64) - 1,
+		"X86 64"
+	},
+#endif
+#ifdef CAPSTONE_HAS_ARM
+	{
+		CS_ARCH_ARM,
+		CS_MODE_THUMB,
+		(unsigned char *)THUMB_CODE,
+		sizeof(THUMB_CODE) - 1,
+		"Thumb"
+	},
+#endif
+#ifdef CAPSTONE_HAS_EVM
+	{
+		CS_ARCH_EVM,
+		0,
+		(unsigned char *)EVM_CODE,
+		sizeof(EVM_CODE) - 1,
+		"EVM"
+	},
+#endif
+#ifdef CAPSTONE_HAS_WASM
+	{
+		CS_ARCH_WASM,
+		0,
+		(unsigned char *)WASM_CODE,
+		sizeof(WASM_CODE) - 1,
+		"WASM"
+	},
+#endif
+#ifdef CAPSTONE_HAS_RISCV
+	{
+		CS_ARCH_RISCV,
+		CS_MODE_RISCV32,
+		(unsigned char *)RISCV_CODE32,
+		sizeof(RISCV_CODE32) - 1,
+		"RISCV32"
+	},
+#endif
+#ifdef CAPSTONE_HAS_M680X
+	{
+		CS_ARCH_M680X,
+		CS_MODE_M680X_6809,
+		(unsigned char *)M680X_CODE,
+		sizeof(M680X_CODE) - 1,
+		"M680X_M6809"
+	},
+#endif
+};
+
+static void test()
+{
+	csh handle;
+	cs_insn *insn;
+	uint16_t lengths[MAX_INSNS];
+	size_t count, n, i, offset;
+	int j;
+	cs_err err;
+
+	for (j = 0; j < sizeof(platforms)/sizeof(platforms[0]) * 2; j++) {
+		// every platform twice: detail off, then on
+		struct platform *platform = &platforms[j / 2];
+		int detail = j % 2;
+
+		printf("****************\n");
+		printf("Platform: %s%s\n", platform->comment, detail ? " (detail)" : "");
+
+		err = cs_open(platform->arch, platform->mode, &handle);
+		if (err) {
+			printf("Failed on cs_open() with error returned: %u\n", err);
+			abort();
+		}
+
+		if (detail)
+			cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+		// reference output from cs_disasm()
+		count = cs_disasm(handle, platform->code, platform->size, 0x1000, 0, &insn);
+
+		n = cs_insn_lengths(handle, platform->code, platform->size, 0x1000,
+				lengths, MAX_INSNS);
+		if (n != count) {
+			printf("ERROR: cs_insn_lengths() found %u instructions, expected %u\n",
+					(unsigned int)n, (unsigned int)count);
+			abort();
+		}
+
+		for (i = 0, offset = 0; i < n; offset += lengths[i], i++) {
+			printf("0x%" PRIx64 ":\t%u bytes\t// %s\t%s\n",
+					insn[i].address, lengths[i], insn[i].mnemonic, insn[i].op_str);
+
+			if (lengths[i] != insn[i].size || insn[i].address != 0x1000 + offset ||
+					cs_insn_length(handle, platform->code + offset,
+						platform->size - offset, insn[i].address) != lengths[i]) {
+				printf("ERROR: wrong length of instruction\n");
+				abort();
+			}
+		}
+		printf("\n");
+
+		cs_free(insn, count);
+		cs_close(&handle);
+	}
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
@@ -0,0 +1,137 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// This sample code demonstrates the option CS_OPT_MEM_CTX, which gives a handle
+// its own memory functions with a user context, and CS_OPT_ARENA, which puts
+// the details of one cs_disasm() call into a few blocks.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+#ifdef CAPSTONE_HAS_X86
+#define X86_CODE64 "\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff"
+
+// a user context: count the live allocations of one handle
+struct pool {
+	const char *name;
+	int allocs;	// number of malloc/realloc calls
+	int live;	// number of blocks not freed yet
+};
+
+static void * CAPSTONE_API pool_malloc(void *ctx, size_t size)
+{
+	struct pool *pool = (struct pool *)ctx;
+
+	pool->allocs++;
+	pool->live++;
+
+	return malloc(size);
+}
+
+static void * CAPSTONE_API pool_realloc(void *ctx, void *ptr, size_t size)
+{
+	struct pool *pool = (struct pool *)ctx;
+
+	pool->allocs++;
+	if (!ptr)
+		pool->live++;
+
+	return realloc(ptr, size);
+}
+
+static void CAPSTONE_API pool_free(void *ctx, void *ptr)
+{
+	struct pool *pool = (struct pool *)ctx;
+
+	pool->live--;
+	free(ptr);
+}
+
+static size_t disasm(struct pool *pool, cs_opt_value arena, cs_insn **insn)
+{
+	csh handle;
+	cs_opt_mem_ctx mem;
+	size_t count, i;
+	cs_err err;
+
+	err = cs_open(CS_ARCH_X86, CS_MODE_64, &handle);
+	if (err) {
+		printf("Failed on cs_open() with error returned: %u\n", err);
+		abort();
+	}
+
+	mem.malloc = pool_malloc;
+	mem.realloc = pool_realloc;
+	mem.free = pool_free;
+	mem.ctx = pool;
+
+	cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+	cs_option(handle, CS_OPT_MEM_CTX, (size_t)&mem);
+	cs_option(handle, CS_OPT_ARENA, arena);
+
+	count = cs_disasm(handle, (unsigned char *)X86_CODE64, sizeof(X86_CODE64) - 1,
+			0x1000, 0, insn);
+
+	printf("****************\n");
+	printf("Pool: %s\n", pool->name);
+	for (i = 0; i < count; i++) {
+		printf("0x%" PRIx64 ":\t%s\t%s\t// %u registers read\n",
+				(*insn)[i].address, (*insn)[i].mnemonic, (*insn)[i].op_str,
+				(*insn)[i].detail->regs_read_count);
+	}
+	printf("%u instructions, %d allocations\n\n", (unsigned int)count, pool->allocs);
+
+	// instructions outlive their handle
+	cs_close(&handle);
+
+	return count;
+}
+
+static void test()
+{
+	struct pool heap = { "one detail per allocation", 0, 0 };
+	struct pool arena = { "arena", 0, 0 };
+	cs_insn *insn, *ref;
+	size_t count, ref_count, i;
+
+	ref_count = disasm(&heap, CS_OPT_OFF, &ref);
+	count = disasm(&arena, CS_OPT_ON, &insn);
+
+	if (!count || count != ref_count || heap.live == 0 || arena.allocs >= heap.allocs) {
+		printf("ERROR: instructions were not allocated from their pool\n");
+		abort();
+	}
+
+	for (i = 0; i < count; i++) {
+		if (strcmp(insn[i].op_str, ref[i].op_str) ||
+				insn[i].detail->regs_read_count != ref[i].detail->regs_read_count ||
+				insn[i].detail->regs_write_count != ref[i].detail->regs_write_count ||
+				insn[i].detail->x86.op_count != ref[i].detail->x86.op_count) {
+			printf("ERROR: CS_OPT_ARENA changed instruction at 0x%" PRIx64 "\n",
+					insn[i].address);
+			abort();
+		}
+	}
+
+	cs_free(insn, count);
+	cs_free(ref, ref_count);
+
+	if (heap.live || arena.live) {
+		printf("ERROR: cs_free() did not release all the memory of its pool\n");
+		abort();
+	}
+}
+#endif
+
+int main()
+{
+#ifdef CAPSTONE_HAS_X86
+	test();
+#endif
+
+	return 0;
+}
@@ -0,0 +1,253 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// This sample code demonstrates the option CS_OPT_NO_TEXT, which skips
+// rendering assembly text, and the APIs cs_insn_text() & cs_format_insn()
+// to render it on demand.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	unsigned char *code;
+	size_t size;
+	const char *comment;
+};
+
+#define X86_CODE64 "\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff"
+#define ARM_CODE "\xED\xFF\xFF\xEB\x04\xe0\x2d\xe5\x00\x00\x00\x00\xe0\x83\x22\xe5\xf1\x02\x03\x0e\x00\x00\xa0\xe3\x02\x30\xc1\xe7\x00\x00\x53\xe3"
+// instructions of IT blocks take their condition from the IT instruction
+#define THUMB_CODE "\x0c\xbf\x08\x46\x01\x30\x01\x30\x18\xbf\x01\x30\x70\x47"
+#define ARM64_CODE "\x09\x00\x38\xd5\xbf\x40\x00\xd5\x0c\x05\x13\xd5\x20\x50\x02\x0e\x20\xe4\x3d\x0f\x00\x18\xa0\x5f\xa2\x00\xae\x9e\x9f\x37\x03\xd5\xbf\x33\x03\xd5\xdf\x3f\x03\xd5\x21\x7c\x02\x9b\x21\x7c\x00\x53\x00\x40\x21\x4b\xe1\x0b\x40\xb9"
+#define PPC_CODE "\x43\x20\x0c\x07\x41\x56\xff\x17\x80\x20\x00\x00\x80\x3f\x00\x00\x10\x43\x23\x0e\xd0\x44\x00\x80\x4c\x43\x22\x02\x2d\x03\x00\x80\x7c\x43\x20\x14\x7c\x43\x20\x93"
+#define M68K_CODE "\x4c\x00\x54\x04\x48\xe7\xe0\x30\x4c\xdf\x0c\x07\xd4\x40\x87\x5a\x4e\x71\x02\xb4\xc0\xde\xc0\xde\x5c\x00\x1d\x80\x71\x12\x01\x23\xf2\x3c\x44\x22\x40\x49\x0e\x56\x54\xc5\xf2\x3c\x44\x00\x44\x7a\x00\x00\xf2\x00\x0a\x28"
+#define EVM_CODE "\x60\x61\x50\x67\x01\x02\x03\x04\x05\x06\x07\x08\x01"
+// the functional unit & parallel bars are only printed in detail mode
+#define TMS320C64X_CODE "\x01\xac\x88\x40\x81\xac\x88\x43\x00\x00\x00\x00\x02\x90\x32\x96\x02\x80\x46\x9e\x05\x3c\x83\xe6\x0b\x0c\x8b\x24"
+#define WASM_CODE "\x20\x00\x20\x01\x41\x20\x10\xc9\x01\x45\x0b\x0e\x02\x00\x01\x02\x28\x02\x08"
+
+static struct platform platforms[] = {
+#ifdef CAPSTONE_HAS_X86
+	{
+		CS_ARCH_X86,
+		CS_MODE_64,
+		(unsigned char *)X86_CODE64,
+		sizeof(X86_CODE64) - 1,
+		"X86 64 (Intel syntax)"
+	},
+#endif
+#ifdef CAPSTONE_HAS_ARM
+	{
+		CS_ARCH_ARM,
+		CS_MODE_ARM,
+		(unsigned char *)ARM_CODE,
+		sizeof(ARM_CODE) - 1,
+		"ARM"
+	},
+#endif
+#ifdef CAPSTONE_HAS_ARM
+	{
+		CS_ARCH_ARM,
+		CS_MODE_THUMB,
+		(unsigned char *)THUMB_CODE,
+		sizeof(THUMB_CODE) - 1,
+		"THUMB"
+	},
+#endif
+#ifdef CAPSTONE_HAS_ARM64
+	{
+		CS_ARCH_ARM64,
+		CS_MODE_ARM,
+		(unsigned char *)ARM64_CODE,
+		sizeof(ARM64_CODE) - 1,
+		"ARM-64"
+	},
+#endif
+#ifdef CAPSTONE_HAS_POWERPC
+	{
+		CS_ARCH_PPC,
+		CS_MODE_BIG_ENDIAN,
+		(unsigned char *)PPC_CODE,
+		sizeof(PPC_CODE) - 1,
+		"PPC-64"
+	},
+#endif
+#ifdef CAPSTONE_HAS_M68K
+	{
+		CS_ARCH_M68K,
+		(cs_mode)(CS_MODE_BIG_ENDIAN | CS_MODE_M68K_040),
+		(unsigned char *)M68K_CODE,
+		sizeof(M68K_CODE) - 1,
+		"M68K (68040)"
+	},
+#endif
+#ifdef CAPSTONE_HAS_TMS320C64X
+	{
+		CS_ARCH_TMS320C64X,
+		CS_MODE_BIG_ENDIAN,
+		(unsigned char *)TMS320C64X_CODE,
+		sizeof(TMS320C64X_CODE) - 1,
+		"TMS320C64x"
+	},
+#endif
+#ifdef CAPSTONE_HAS_EVM
+	{
+		CS_ARCH_EVM,
+		0,
+		(unsigned char *)EVM_CODE,
+		sizeof(EVM_CODE) - 1,
+		"EVM"
+	},
+#endif
+#ifdef CAPSTONE_HAS_WASM
+	{
+		CS_ARCH_WASM,
+		0,
+		(unsigned char *)WASM_CODE,
+		sizeof(WASM_CODE) - 1,
+		"WASM"
+	},
+#endif
+};
+
+// verify that @insn has the same detail as the reference instruction @ref
+static void check_detail(csh handle, cs_insn *insn, cs_insn *ref)
+{
+	cs_regs regs_read, regs_write, ref_read, ref_write;
+	uint8_t read_count, write_count, ref_read_count, ref_write_count;
+
+	if (insn->id != ref->id || insn->size != ref->size ||
+			insn->detail->regs_read_count != ref->detail->regs_read_count ||
+			insn->detail->regs_write_count != ref->detail->regs_write_count ||
+			insn->detail->groups_count != ref->detail->groups_count) {
+		printf("ERROR: detail differs with CS_OPT_NO_TEXT\n");
+		abort();
+	}
+
+	if (cs_regs_access(handle, ref, ref_read, &ref_read_count, ref_write, &ref_write_count))
+		return;
+
+	cs_regs_access(handle, insn, regs_read, &read_count, regs_write, &write_count);
+	if (read_count != ref_read_count || write_count != ref_write_count ||
+			memcmp(regs_read, ref_read, read_count * sizeof(regs_read[0])) ||
+			memcmp(regs_write, ref_write, write_count * sizeof(regs_write[0]))) {
+		printf("ERROR: registers accessed differ with CS_OPT_NO_TEXT\n");
+		abort();
+	}
+}
+
+static void test()
+{
+	csh handle;
+	cs_insn *insn, *ref;
+	size_t count, ref_count, i, in_it;
+	char text[CS_MNEMONIC_SIZE + 160 + 1], ref_text[sizeof(text)];
+	int j;
+	cs_err err;
+
+	for (j = 0; j < sizeof(platforms)/sizeof(platforms[0]); j++) {
+		printf("****************\n");
+		printf("Platform: %s\n", platforms[j].comment);
+
+		err = cs_open(platforms[j].arch, platforms[j].mode, &handle);
+		if (err) {
+			printf("Failed on cs_open() with error returned: %u\n", err);
+			abort();
+		}
+
+		cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+		// reference output, with text
+		ref_count = cs_disasm(handle, platforms[j].code, platforms[j].size, 0x1000, 0, &ref);
+
+		// now disassemble again, this time without rendering any text
+		cs_option(handle, CS_OPT_NO_TEXT, CS_OPT_ON);
+		count = cs_disasm(handle, platforms[j].code, platforms[j].size, 0x1000, 0, &insn);
+		if (count != ref_count) {
+			printf("ERROR: CS_OPT_NO_TEXT changed the number of instructions\n");
+			abort();
+		}
+
+		in_it = 0;
+		for (i = 0; i < count; i++) {
+			// only instructions of an ARM IT block have their text already
+			if ((insn[i].mnemonic[0] || insn[i].op_str[0]) != (in_it > 0)) {
+				printf("ERROR: text is rendered with CS_OPT_NO_TEXT\n");
+				abort();
+			}
+
+			check_detail(handle, &insn[i], &ref[i]);
+
+			// render into our own buffer, leaving @insn untouched
+			if (cs_format_insn(handle, &insn[i], text, sizeof(text)) != CS_ERR_OK) {
+				printf("ERROR: Failed on cs_format_insn()\n");
+				abort();
+			}
+
+			// expected text, straight from cs_disasm()
+			strcpy(ref_text, ref[i].mnemonic);
+			if (ref[i].op_str[0]) {
+				strcat(ref_text, " ");
+				strcat(ref_text, ref[i].op_str);
+			}
+
+			if ((insn[i].mnemonic[0] && !in_it) || strcmp(text, ref_text)) {
+				printf("ERROR: cs_format_insn() gives \"%s\", cs_disasm() \"%s\"\n", text, ref_text);
+				abort();
+			}
+
+			// text too long for the buffer gets truncated
+			cs_format_insn(handle, &insn[i], text, 4);
+			if (strncmp(text, ref_text, 3) || strlen(text) > 3) {
+				printf("ERROR: cs_format_insn() does not truncate text\n");
+				abort();
+			}
+
+			// only render the text of the instructions we want to print
+			if (cs_insn_text(handle, &insn[i]) != CS_ERR_OK) {
+				printf("ERROR: Failed on cs_insn_text()\n");
+				abort();
+			}
+
+			printf("0x%" PRIx64 ":\t%s\t%s\n", insn[i].address, insn[i].mnemonic, insn[i].op_str);
+
+			if (strcmp(insn[i].mnemonic, ref[i].mnemonic) || strcmp(insn[i].op_str, ref[i].op_str)) {
+				printf("ERROR: cs_insn_text() gives \"%s\t%s\", cs_disasm() \"%s\t%s\"\n",
+						insn[i].mnemonic, insn[i].op_str, ref[i].mnemonic, ref[i].op_str);
+				abort();
+			}
+
+			// "it", "ite", "itte"...: one instruction per letter after "i"
+			if (in_it > 0)
+				in_it--;
+#ifdef CAPSTONE_HAS_ARM
+			if (platforms[j].arch == CS_ARCH_ARM && insn[i].id == ARM_INS_IT)
+				in_it = strlen(ref[i].mnemonic) - 1;
+#endif
+		}
+		printf("\n");
+
+		cs_free(insn, count);
+		cs_free(ref, ref_count);
+		cs_close(&handle);
+	}
+}
+
+int main()
+{
+	if (cs_support(CS_SUPPORT_DIET)) {
+		// there is no text to render in diet mode
+		printf("Skipped in diet mode\n");
+		return 0;
+	}
+
+	test();
+
+	return 0;
+}
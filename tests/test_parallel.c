@@ -0,0 +1,171 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// This sample code demonstrates the API cs_disasm_parallel(), which splits
+// a large buffer across multiple threads, then checks its output against
+// cs_disasm().
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	unsigned char *code;
+	size_t size;
+	const char *comment;
+	bool noise;	// mix random bytes into the code
+};
+
+// size of the buffer to disassemble, big enough to be split
+#define BUF_SIZE (256 * 1024)
+#define NTHREADS 4
+
+#define X86_CODE64 "\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff\x0f\x10\x44\x24\x08\x66\x0f\x6f\xc1\xf3\xa4"
+// includes IT blocks, whose condition codes depend on previous instructions
+#define THUMB_CODE "\x70\x47\x00\xf0\x10\xe8\xeb\x46\x83\xb0\xc9\x68\x1f\xb1\x30\xbf\xaf\xf3\x20\x84\x52\xf8\x23\xf0\xd1\xe8\x11\xf0\x18\xbf\xad\xbf\xf3\xff\x0b\x0c\x86\xf3\x00\x89\x80\xf3\x00\x8c\x4f\xfa\x99\xf6\xd0\xff\xa2\x01"
+#define ARM64_CODE "\x09\x00\x38\xd5\xbf\x40\x00\xd5\x0c\x05\x13\xd5\x20\x50\x02\x0e\x20\xe4\x3d\x0f\x00\x18\xa0\x5f\xa2\x00\xae\x9e\x9f\x37\x03\xd5\xbf\x33\x03\xd5\xdf\x3f\x03\xd5\x21\x7c\x02\x9b\x21\x7c\x00\x53\x00\x40\x21\x4b\xe1\x0b\x40\xb9"
+#define MIPS_CODE "\x0C\x10\x00\x97\x00\x00\x00\x00\x24\x02\x00\x0c\x8f\xa2\x00\x00\x34\x21\x34\x56"
+
+static struct platform platforms[] = {
+#ifdef CAPSTONE_HAS_X86
+	{
+		CS_ARCH_X86,
+		CS_MODE_64,
+		(unsigned char *)X86_CODE64,
+		sizeof(X86_CODE64) - 1,
+		"X86 64 (Intel syntax)",
+		true
+	},
+#endif
+#ifdef CAPSTONE_HAS_ARM
+	{
+		CS_ARCH_ARM,
+		CS_MODE_THUMB,
+		(unsigned char *)THUMB_CODE,
+		sizeof(THUMB_CODE) - 1,
+		"Thumb-2",
+		true
+	},
+#endif
+#ifdef CAPSTONE_HAS_ARM64
+	{
+		CS_ARCH_ARM64,
+		CS_MODE_ARM,
+		(unsigned char *)ARM64_CODE,
+		sizeof(ARM64_CODE) - 1,
+		"ARM-64",
+		false
+	},
+#endif
+#ifdef CAPSTONE_HAS_MIPS
+	{
+		CS_ARCH_MIPS,
+		(cs_mode)(CS_MODE_MIPS32 + CS_MODE_BIG_ENDIAN),
+		(unsigned char *)MIPS_CODE,
+		sizeof(MIPS_CODE) - 1,
+		"MIPS-32 (Big-endian)",
+		false
+	},
+#endif
+};
+
+// fill @buf with copies of @code, with some random bytes in between when
+// @noise is set, so chunks are not split at instruction boundaries
+static void fill_buffer(unsigned char *buf, const unsigned char *code, size_t code_size, bool noise)
+{
+	unsigned int seed = 12345;
+	size_t i = 0;
+
+	while (i < BUF_SIZE) {
+		size_t n = BUF_SIZE - i < code_size ? BUF_SIZE - i : code_size;
+
+		memcpy(buf + i, code, n);
+		i += n;
+
+		if (noise && i < BUF_SIZE) {
+			seed = seed * 1103515245 + 12345;
+			buf[i++] = (unsigned char)(seed >> 16);
+		}
+	}
+}
+
+static void test()
+{
+	csh handle;
+	cs_insn *insn, *expected;
+	unsigned char *buf;
+	size_t count, expected_count, i;
+	int j;
+	cs_err err;
+
+	buf = malloc(BUF_SIZE);
+	if (!buf) {
+		printf("Failed to allocate memory\n");
+		abort();
+	}
+
+	for (j = 0; j < sizeof(platforms)/sizeof(platforms[0]); j++) {
+		printf("****************\n");
+		printf("Platform: %s\n", platforms[j].comment);
+
+		err = cs_open(platforms[j].arch, platforms[j].mode, &handle);
+		if (err) {
+			printf("Failed on cs_open() with error returned: %u\n", err);
+			abort();
+		}
+
+		cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+		// random bytes might not be valid code
+		cs_option(handle, CS_OPT_SKIPDATA, CS_OPT_ON);
+
+		fill_buffer(buf, platforms[j].code, platforms[j].size, platforms[j].noise);
+
+		expected_count = cs_disasm(handle, buf, BUF_SIZE, 0x1000, 0, &expected);
+		count = cs_disasm_parallel(handle, buf, BUF_SIZE, 0x1000, NTHREADS, &insn);
+
+		if (count != expected_count) {
+			printf("ERROR: cs_disasm_parallel() returned %u instructions, expected %u\n",
+					(unsigned int)count, (unsigned int)expected_count);
+			abort();
+		}
+
+		for (i = 0; i < count; i++) {
+			if (insn[i].address != expected[i].address ||
+					insn[i].id != expected[i].id ||
+					insn[i].size != expected[i].size ||
+					strcmp(insn[i].mnemonic, expected[i].mnemonic) ||
+					strcmp(insn[i].op_str, expected[i].op_str) ||
+					(insn[i].detail == NULL) != (expected[i].detail == NULL) ||
+					(insn[i].detail && insn[i].detail->regs_read_count != expected[i].detail->regs_read_count)) {
+				printf("ERROR: cs_disasm_parallel() differs from cs_disasm() at 0x%" PRIx64 ":\n", expected[i].address);
+				printf("\t%s\t%s\n", insn[i].mnemonic, insn[i].op_str);
+				printf("\t%s\t%s\n", expected[i].mnemonic, expected[i].op_str);
+				abort();
+			}
+		}
+
+		printf("Disassembled %u instructions\n", (unsigned int)count);
+		printf("First: 0x%" PRIx64 ":\t%s\t%s\n", insn[0].address, insn[0].mnemonic, insn[0].op_str);
+		printf("Last: 0x%" PRIx64 ":\t%s\t%s\n", insn[count - 1].address,
+				insn[count - 1].mnemonic, insn[count - 1].op_str);
+		printf("\n");
+
+		cs_free(insn, count);
+		cs_free(expected, expected_count);
+		cs_close(&handle);
+	}
+
+	free(buf);
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
@@ -0,0 +1,286 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// This sample code demonstrates the API cs_regs_access_bitset(), which gives
+// registers accessed by an instruction as bitsets, so checking any register
+// takes constant time, and the option CS_OPT_REGS_BITSET, which computes these
+// bitsets while decoding.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	unsigned char *code;
+	size_t size;
+	const char *comment;
+};
+
+#define X86_CODE64 "\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff\x48\x8b\x44\x8b\x10\x64\x48\x8b\x04\x25\x28\x00\x00\x00\xf3\xa4"
+#define ARM_CODE "\xED\xFF\xFF\xEB\x04\xe0\x2d\xe5\x00\x00\x00\x00\xe0\x83\x22\xe5\xf1\x02\x03\x0e\x00\x00\xa0\xe3\x02\x30\xc1\xe7\x00\x00\x53\xe3"
+#define ARM64_CODE "\x21\x7c\x02\x9b\x21\x7c\x00\x53\x00\x40\x21\x4b\xe1\x0b\x40\xb9\x20\x04\x81\xda\x20\x08\x02\x8b\xfd\x7b\xbf\xa9"
+#define PPC_CODE "\x80\x20\x00\x00\x10\x43\x23\x0e\x4c\xc8\x00\x21"
+#define EBPF_CODE "\x97\x09\x00\x00\x37\x13\x03\x00\xdc\x02\x00\x00\x20\x00\x00\x00\x30\x00\x00\x00\x00\x00\x00\x00\xdb\x3a\x00\x01\x00\x00\x00\x00"
+
+static struct platform platforms[] = {
+#ifdef CAPSTONE_HAS_X86
+	{
+		CS_ARCH_X86,
+		CS_MODE_64,
+		(unsigned char *)X86_CODE64,
+		sizeof(X86_CODE64) - 1,
+		"X86 64"
+	},
+#endif
+#ifdef CAPSTONE_HAS_ARM
+	{
+		CS_ARCH_ARM,
+		CS_MODE_ARM,
+		(unsigned char *)ARM_CODE,
+		sizeof(ARM_CODE) - 1,
+		"ARM"
+	},
+#endif
+#ifdef CAPSTONE_HAS_ARM64
+	{
+		CS_ARCH_ARM64,
+		CS_MODE_ARM,
+		(unsigned char *)ARM64_CODE,
+		sizeof(ARM64_CODE) - 1,
+		"ARM-64"
+	},
+#endif
+#ifdef CAPSTONE_HAS_POWERPC
+	{
+		// PPC has no cs_regs_access() yet
+		CS_ARCH_PPC,
+		CS_MODE_BIG_ENDIAN,
+		(unsigned char *)PPC_CODE,
+		sizeof(PPC_CODE) - 1,
+		"PPC"
+	},
+#endif
+#ifdef CAPSTONE_HAS_BPF
+	{
+		CS_ARCH_BPF,
+		CS_MODE_LITTLE_ENDIAN | CS_MODE_BPF_EXTENDED,
+		(unsigned char *)EBPF_CODE,
+		sizeof(EBPF_CODE) - 1,
+		"eBPF"
+	},
+#endif
+};
+
+// is register @reg in list @regs?
+static bool regs_has(const cs_regs regs, uint8_t count, unsigned int reg)
+{
+	uint8_t i;
+
+	for (i = 0; i < count; i++) {
+		if (regs[i] == reg)
+			return true;
+	}
+
+	return false;
+}
+
+static void print_regs(csh handle, const char *comment, const cs_regs_bitset bits)
+{
+	unsigned int reg;
+
+	printf("\t%s:", comment);
+	for (reg = 1; reg < 64 * CS_REGS_BITSET_WORDS; reg++) {
+		if (CS_REGS_BITSET_HAS(bits, reg))
+			printf(" %s", cs_reg_name(handle, reg));
+	}
+	printf("\n");
+}
+
+static void print_insn(csh handle, const cs_insn *insn)
+{
+	cs_regs regs_read, regs_write;
+	uint8_t read_count, write_count;
+	cs_regs_bitset read_bits, write_bits;
+	cs_err err, err_bits;
+	unsigned int reg;
+
+	printf("0x%" PRIx64 ":\t%s\t%s\n", insn->address, insn->mnemonic, insn->op_str);
+
+	err = cs_regs_access(handle, insn, regs_read, &read_count, regs_write, &write_count);
+	err_bits = cs_regs_access_bitset(handle, insn, read_bits, write_bits);
+	if (err != err_bits) {
+		printf("ERROR: cs_regs_access_bitset() returned %u, expected %u\n", err_bits, err);
+		abort();
+	}
+
+	if (err) {
+		printf("\tcs_regs_access_bitset() failed: %s\n", cs_strerror(err));
+		return;
+	}
+
+	// the bitsets have exactly the registers given by cs_regs_access()
+	for (reg = 0; reg < 64 * CS_REGS_BITSET_WORDS; reg++) {
+		if (CS_REGS_BITSET_HAS(read_bits, reg) != regs_has(regs_read, read_count, reg) ||
+				CS_REGS_BITSET_HAS(write_bits, reg) != regs_has(regs_write, write_count, reg)) {
+			printf("ERROR: wrong bitset for register %s\n", cs_reg_name(handle, reg));
+			abort();
+		}
+	}
+
+	print_regs(handle, "Registers read", read_bits);
+	print_regs(handle, "Registers modified", write_bits);
+}
+
+// decode again with CS_OPT_REGS_BITSET, and check that the bitsets of the details
+// & the register APIs give the same as without it, in @insn
+static void check_decoded_bitsets(csh handle, const struct platform *platform,
+		const cs_insn *insn, size_t count)
+{
+	cs_insn *insn_bits;
+	cs_regs_bitset read_bits, write_bits, read_decoded, write_decoded;
+	cs_regs regs_read, regs_write;
+	uint8_t read_count, write_count;
+	size_t i;
+	unsigned int reg;
+	bool filled;
+
+	cs_option(handle, CS_OPT_REGS_BITSET, CS_OPT_ON);
+
+	if (cs_disasm(handle, platform->code, platform->size, 0x1000, 0, &insn_bits) != count) {
+		printf("ERROR: CS_OPT_REGS_BITSET changed the instructions!\n");
+		abort();
+	}
+
+	for (i = 0; i < count; i++) {
+		// filled exactly for the archs with cs_regs_access()
+		filled = !cs_regs_access(handle, &insn[i], regs_read, &read_count, regs_write, &write_count);
+		if (insn_bits[i].detail->regs_bitset != filled) {
+			printf("ERROR: regs_bitset is %u at 0x%" PRIx64 "\n",
+					insn_bits[i].detail->regs_bitset, insn[i].address);
+			abort();
+		}
+
+		if (filled) {
+			cs_regs_access_bitset(handle, &insn[i], read_bits, write_bits);
+			cs_regs_access_bitset(handle, &insn_bits[i], read_decoded, write_decoded);
+			if (memcmp(read_bits, read_decoded, sizeof(read_bits)) ||
+					memcmp(write_bits, write_decoded, sizeof(write_bits))) {
+				printf("ERROR: wrong decoded bitsets at 0x%" PRIx64 "\n", insn[i].address);
+				abort();
+			}
+
+			// copying the detail must keep the bitsets, stored after it
+			if (cs_detail_size(handle, &insn_bits[i]) != sizeof(cs_detail) + 2 * sizeof(cs_regs_bitset)) {
+				printf("ERROR: cs_detail_size() leaves out the bitsets at 0x%" PRIx64 "\n", insn[i].address);
+				abort();
+			}
+		}
+
+		for (reg = 0; reg < 64 * CS_REGS_BITSET_WORDS; reg++) {
+			if (cs_reg_read(handle, &insn_bits[i], reg) != cs_reg_read(handle, &insn[i], reg) ||
+					cs_reg_write(handle, &insn_bits[i], reg) != cs_reg_write(handle, &insn[i], reg)) {
+				printf("ERROR: cs_reg_read() or cs_reg_write() differs for register %s\n",
+						cs_reg_name(handle, reg));
+				abort();
+			}
+		}
+	}
+
+	cs_free(insn_bits, count);
+	cs_option(handle, CS_OPT_REGS_BITSET, CS_OPT_OFF);
+}
+
+// check that cs_disasm_iter() fills the bitsets only if cs_malloc() was
+// called with CS_OPT_REGS_BITSET on, as only then the detail has room for them
+static void check_iter_bitsets(csh handle, const struct platform *platform,
+		const cs_insn *insn, size_t count)
+{
+	cs_insn *insn_iter;
+	cs_regs_bitset read_bits, write_bits, read_iter, write_iter;
+	const uint8_t *code;
+	size_t size, i;
+	uint64_t address;
+	int on;
+
+	for (on = 0; on < 2; on++) {
+		cs_option(handle, CS_OPT_REGS_BITSET, on ? CS_OPT_ON : CS_OPT_OFF);
+		insn_iter = cs_malloc(handle);
+		cs_option(handle, CS_OPT_REGS_BITSET, CS_OPT_ON);
+
+		code = platform->code;
+		size = platform->size;
+		address = 0x1000;
+		for (i = 0; i < count && cs_disasm_iter(handle, &code, &size, &address, insn_iter); i++) {
+			if (insn_iter->detail->regs_bitset && !on) {
+				printf("ERROR: bitsets filled without room at 0x%" PRIx64 "\n", insn[i].address);
+				abort();
+			}
+
+			if (cs_regs_access_bitset(handle, &insn[i], read_bits, write_bits))
+				continue;
+
+			cs_regs_access_bitset(handle, insn_iter, read_iter, write_iter);
+			if (insn_iter->detail->regs_bitset != on ||
+					memcmp(read_bits, read_iter, sizeof(read_bits)) ||
+					memcmp(write_bits, write_iter, sizeof(write_bits))) {
+				printf("ERROR: wrong bitsets of cs_disasm_iter() at 0x%" PRIx64 "\n", insn[i].address);
+				abort();
+			}
+		}
+
+		cs_free(insn_iter, 1);
+	}
+
+	cs_option(handle, CS_OPT_REGS_BITSET, CS_OPT_OFF);
+}
+
+static void test()
+{
+	csh handle;
+	cs_insn *insn;
+	size_t count, i;
+	int j;
+	cs_err err;
+
+	for (j = 0; j < sizeof(platforms)/sizeof(platforms[0]); j++) {
+		printf("****************\n");
+		printf("Platform: %s\n", platforms[j].comment);
+
+		err = cs_open(platforms[j].arch, platforms[j].mode, &handle);
+		if (err) {
+			printf("Failed on cs_open() with error returned: %u\n", err);
+			abort();
+		}
+
+		cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+		count = cs_disasm(handle, platforms[j].code, platforms[j].size, 0x1000, 0, &insn);
+		if (!count) {
+			printf("ERROR: Failed to disasm given code!\n");
+			abort();
+		}
+
+		for (i = 0; i < count; i++)
+			print_insn(handle, &insn[i]);
+
+		check_decoded_bitsets(handle, &platforms[j], insn, count);
+		check_iter_bitsets(handle, &platforms[j], insn, count);
+
+		printf("\n");
+
+		cs_free(insn, count);
+		cs_close(&handle);
+	}
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
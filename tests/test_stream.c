@@ -0,0 +1,218 @@
+/* Capstone Disassembly Engine */
+/* By Nguyen Anh Quynh <aquynh@gmail.com>, 2013-2019 */
+
+// This sample code demonstrates the APIs cs_disasm_cb() & cs_disasm_stream(),
+// which pass instructions to a callback, and checks their output against
+// cs_disasm(). cs_disasm_stream() also reads code with another callback.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	unsigned char *code;
+	size_t size;
+	const char *comment;
+};
+
+// size of the code to disassemble, bigger than the window of cs_disasm_stream()
+#define BUF_SIZE (200 * 1000)
+// at most this many bytes are provided by each read
+#define READ_SIZE 1000
+
+#define X86_CODE64 "\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff\x0f\x10\x44\x24\x08\x66\x0f\x6f\xc1\xf3\xa4"
+#define THUMB_CODE "\x70\x47\x00\xf0\x10\xe8\xeb\x46\x83\xb0\xc9\x68\x1f\xb1\x30\xbf\xaf\xf3\x20\x84\x52\xf8\x23\xf0\xd1\xe8\x11\xf0\x18\xbf\xad\xbf\xf3\xff\x0b\x0c\x86\xf3\x00\x89\x80\xf3\x00\x8c\x4f\xfa\x99\xf6\xd0\xff\xa2\x01"
+#define EVM_CODE "\x60\x61\x50\x7f\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1a\x1b\x1c\x1d\x1e\x1f\x01"
+
+static struct platform platforms[] = {
+#ifdef CAPSTONE_HAS_X86
+	{
+		CS_ARCH_X86,
+		CS_MODE_64,
+		(unsigned char *)X86_CODE64,
+		sizeof(X86_CODE64) - 1,
+		"X86 64 (Intel syntax)"
+	},
+#endif
+#ifdef CAPSTONE_HAS_ARM
+	{
+		CS_ARCH_ARM,
+		CS_MODE_THUMB,
+		(unsigned char *)THUMB_CODE,
+		sizeof(THUMB_CODE) - 1,
+		"Thumb-2"
+	},
+#endif
+#ifdef CAPSTONE_HAS_EVM
+	{
+		CS_ARCH_EVM,
+		0,
+		(unsigned char *)EVM_CODE,
+		sizeof(EVM_CODE) - 1,
+		"EVM"
+	},
+#endif
+};
+
+// input of read_code()
+struct reader {
+	const unsigned char *code;
+	size_t size;
+	size_t offset;
+};
+
+// state of check_insn()
+struct checker {
+	cs_insn *expected;
+	size_t count;
+	size_t index;
+	size_t stop;	// stop after this many instructions, or 0
+};
+
+static size_t CAPSTONE_API read_code(uint8_t *buf, size_t size, void *user_data)
+{
+	struct reader *r = (struct reader *)user_data;
+
+	if (size > READ_SIZE)
+		size = READ_SIZE;
+	if (size > r->size - r->offset)
+		size = r->size - r->offset;
+
+	memcpy(buf, r->code + r->offset, size);
+	r->offset += size;
+
+	return size;
+}
+
+static bool CAPSTONE_API check_insn(csh handle, const cs_insn *insn, void *user_data)
+{
+	struct checker *c = (struct checker *)user_data;
+	cs_insn *e;
+
+	if (c->index >= c->count) {
+		printf("ERROR: callback received too many instructions\n");
+		abort();
+	}
+
+	e = &c->expected[c->index++];
+	if (insn->address != e->address || insn->id != e->id || insn->size != e->size ||
+			memcmp(insn->bytes, e->bytes, insn->size) ||
+			strcmp(insn->mnemonic, e->mnemonic) || strcmp(insn->op_str, e->op_str) ||
+			(insn->detail == NULL) != (e->detail == NULL)) {
+		printf("ERROR: callback receives different insn from cs_disasm() at 0x%" PRIx64 ":\n", e->address);
+		printf("\t%s\t%s\n", insn->mnemonic, insn->op_str);
+		printf("\t%s\t%s\n", e->mnemonic, e->op_str);
+		abort();
+	}
+
+	return c->index != c->stop;
+}
+
+// fill @buf with copies of @code, with a random byte in between, so
+// instructions cross the windows of cs_disasm_stream()
+static void fill_buffer(unsigned char *buf, const unsigned char *code, size_t code_size)
+{
+	unsigned int seed = 12345;
+	size_t i = 0;
+
+	while (i < BUF_SIZE) {
+		size_t n = BUF_SIZE - i < code_size ? BUF_SIZE - i : code_size;
+
+		memcpy(buf + i, code, n);
+		i += n;
+
+		if (i < BUF_SIZE) {
+			seed = seed * 1103515245 + 12345;
+			buf[i++] = (unsigned char)(seed >> 16);
+		}
+	}
+}
+
+static void test()
+{
+	csh handle;
+	unsigned char *buf;
+	struct reader r;
+	struct checker c;
+	size_t count;
+	int j;
+	cs_err err;
+
+	buf = malloc(BUF_SIZE);
+	if (!buf) {
+		printf("Failed to allocate memory\n");
+		abort();
+	}
+
+	for (j = 0; j < sizeof(platforms)/sizeof(platforms[0]); j++) {
+		printf("****************\n");
+		printf("Platform: %s\n", platforms[j].comment);
+
+		err = cs_open(platforms[j].arch, platforms[j].mode, &handle);
+		if (err) {
+			printf("Failed on cs_open() with error returned: %u\n", err);
+			abort();
+		}
+
+		cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+		cs_option(handle, CS_OPT_SKIPDATA, CS_OPT_ON);
+
+		fill_buffer(buf, platforms[j].code, platforms[j].size);
+		c.count = cs_disasm(handle, buf, BUF_SIZE, 0x1000, 0, &c.expected);
+
+		// disassemble the code in memory
+		c.index = 0;
+		c.stop = 0;
+		count = cs_disasm_cb(handle, buf, BUF_SIZE, 0x1000, check_insn, &c);
+		if (count != c.count || c.index != c.count) {
+			printf("ERROR: cs_disasm_cb() returned %u instructions, expected %u\n",
+					(unsigned int)count, (unsigned int)c.count);
+			abort();
+		}
+		printf("cs_disasm_cb(): %u instructions\n", (unsigned int)count);
+
+		// disassemble the whole code
+		r.code = buf;
+		r.size = BUF_SIZE;
+		r.offset = 0;
+		c.index = 0;
+		c.stop = 0;
+		count = cs_disasm_stream(handle, read_code, &r, 0x1000, check_insn, &c);
+		if (count != c.count || c.index != c.count) {
+			printf("ERROR: cs_disasm_stream() returned %u instructions, expected %u\n",
+					(unsigned int)count, (unsigned int)c.count);
+			abort();
+		}
+		printf("cs_disasm_stream(): %u instructions\n", (unsigned int)count);
+
+		// stop early from the callback
+		r.offset = 0;
+		c.index = 0;
+		c.stop = 100;
+		count = cs_disasm_stream(handle, read_code, &r, 0x1000, check_insn, &c);
+		if (count != c.stop) {
+			printf("ERROR: cs_disasm_stream() did not stop after %u instructions\n",
+					(unsigned int)c.stop);
+			abort();
+		}
+		printf("Stopped after %u instructions\n", (unsigned int)count);
+		printf("\n");
+
+		cs_free(c.expected, c.count);
+		cs_close(&handle);
+	}
+
+	free(buf);
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
@@ -11,32 +11,40 @@
 
 #include "utils.h"
 
-// create a cache for fast id lookup
-static unsigned short *make_id2insn(const insn_map *insns, unsigned int size)
+// look for @id in @insns, given its size in @max.
+// @insns is sorted by id, and ids are unique, so @id can only be found in a
+// small window of @insns, which we binary search. this needs no cache, thus
+// no memory allocation & no state to share between handles.
+// return 0 if not found
+unsigned short insn_find(const insn_map *insns, unsigned int max, unsigned int id)
 {
-	// NOTE: assume that the max id is always put at the end of insns array
-	unsigned short max_id = insns[size - 1].id;
-	unsigned short i;
+	unsigned int left, right, m;
+	unsigned int max_id = insns[max - 1].id;
 
-	unsigned short *cache = (unsigned short *)cs_mem_calloc(max_id + 1, sizeof(*cache));
+	if (id > max_id || id <= insns[0].id)
+		return 0;
 
-	for (i = 1; i < size; i++)
-		cache[insns[i].id] = i;
+	// id of insns[i] is at least insns[0].id + i, and at most max_id - (max - 1 - i)
+	right = id - insns[0].id;
+	if (right > max - 1)
+		right = max - 1;
 
-	return cache;
-}
+	left = 1;
+	if (max_id - id < max - 1 - left)
+		left = max - 1 - (max_id - id);
 
-// look for @id in @insns, given its size in @max. first time call will update @cache.
-// return 0 if not found
-unsigned short insn_find(const insn_map *insns, unsigned int max, unsigned int id, unsigned short **cache)
-{
-	if (id > insns[max - 1].id)
-		return 0;
+	while (left <= right) {
+		m = (left + right) / 2;
+		if (insns[m].id == id)
+			return (unsigned short)m;
 
-	if (*cache == NULL)
-		*cache = make_id2insn(insns, max);
+		if (insns[m].id < id)
+			left = m + 1;
+		else
+			right = m - 1;
+	}
 
-	return (*cache)[id];
+	return 0;
 }
 
 int name2id(const name_map* map, int max, const char *name)
@@ -53,10 +61,34 @@ int name2id(const name_map* map, int max, const char *name)
 	return -1;
 }
 
+int name2id_sorted(const name_map* map, int max, const char *name)
+{
+	int left = 0, right = max - 1, m, c;
+
+	while (left <= right) {
+		m = (left + right) / 2;
+		c = strcmp(map[m].name, name);
+		if (c == 0)
+			return map[m].id;
+
+		if (c < 0)
+			left = m + 1;
+		else
+			right = m - 1;
+	}
+
+	// nothing match
+	return -1;
+}
+
 const char *id2name(const name_map* map, int max, const unsigned int id)
 {
 	int i;
 
+	// most maps are indexed by ID
+	if (id < (unsigned int)max && map[id].id == id)
+		return map[id].name;
+
 	for (i = 0; i < max; i++) {
 		if (map[i].id == id) {
 			return map[i].name;
@@ -67,28 +99,6 @@ const char *id2name(const name_map* map, int max, const unsigned int id)
 	return NULL;
 }
 
-// count number of positive members in a list.
-// NOTE: list must be guaranteed to end in 0
-unsigned int count_positive(const uint16_t *list)
-{
-	unsigned int c;
-
-	for (c = 0; list[c] > 0; c++);
-
-	return c;
-}
-
-// count number of positive members in a list.
-// NOTE: list must be guaranteed to end in 0
-unsigned int count_positive8(const unsigned char *list)
-{
-	unsigned int c;
-
-	for (c = 0; list[c] > 0; c++);
-
-	return c;
-}
-
 char *cs_strdup(const char *str)
 {
 	size_t len = strlen(str)+ 1;
@@ -137,6 +147,16 @@ bool arr_exist(uint16_t *arr, unsigned char max, unsigned int id)
 	return false;
 }
 
+void regs_bitset_fill(cs_regs_bitset bits, const uint16_t *regs, unsigned char count)
+{
+	unsigned char i;
+
+	memset(bits, 0, sizeof(cs_regs_bitset));
+
+	for (i = 0; i < count; i++)
+		regs_bitset_add(bits, regs[i]);
+}
+
 // binary search for encoding in IndexType array
 // return -1 if not found, or index if found
 unsigned int binsearch_IndexTypeEncoding(const struct IndexType *index, size_t size, uint16_t encoding)
@@ -25,12 +25,15 @@ typedef struct insn_map {
 	unsigned char groups[8]; // list of group this instruction belong to
 	bool branch;	// branch instruction?
 	bool indirect_branch;	// indirect branch instruction?
+	unsigned char regs_use_count;	// number of registers in regs_use[]
+	unsigned char regs_mod_count;	// number of registers in regs_mod[]
+	unsigned char groups_count;	// number of groups in groups[]
 #endif
 } insn_map;
 
-// look for @id in @m, given its size in @max. first time call will update @cache.
+// look for @id in @m, given its size in @max. @m must be sorted by id.
 // return 0 if not found
-unsigned short insn_find(const insn_map *m, unsigned int max, unsigned int id, unsigned short **cache);
+unsigned short insn_find(const insn_map *m, unsigned int max, unsigned int id);
 
 // map id to string
 typedef struct name_map {
@@ -42,15 +45,14 @@ typedef struct name_map {
 // return 0 if not found
 int name2id(const name_map* map, int max, const char *name);
 
+// map a name to its ID, given @map sorted by name (strcmp order)
+// return -1 if not found
+int name2id_sorted(const name_map* map, int max, const char *name);
+
 // map ID to a name
 // return NULL if not found
 const char *id2name(const name_map* map, int max, const unsigned int id);
 
-// count number of positive members in a list.
-// NOTE: list must be guaranteed to end in 0
-unsigned int count_positive(const uint16_t *list);
-unsigned int count_positive8(const unsigned char *list);
-
 #define ARR_SIZE(a) (sizeof(a)/sizeof(a[0]))
 #define MATRIX_SIZE(a) (sizeof(a[0])/sizeof(a[0][0]))
 
@@ -68,6 +70,27 @@ bool arr_exist8(unsigned char *arr, unsigned char max, unsigned int id);
 
 bool arr_exist(uint16_t *arr, unsigned char max, unsigned int id);
 
+// add register @reg to bitset @bits, to check for duplicates in register
+// lists in constant time.
+// return false if @reg was already in the bitset
+static inline bool regs_bitset_add(cs_regs_bitset bits, unsigned int reg)
+{
+	uint64_t bit = (uint64_t)1 << (reg % 64);
+
+	if (reg >= 64 * CS_REGS_BITSET_WORDS)
+		return true;
+
+	if (bits[reg / 64] & bit)
+		return false;
+
+	bits[reg / 64] |= bit;
+
+	return true;
+}
+
+// add all registers of list @regs to bitset @bits
+void regs_bitset_fill(cs_regs_bitset bits, const uint16_t *regs, unsigned char count);
+
 struct IndexType {
 	uint16_t encoding;
 	unsigned index;